@@ -0,0 +1,109 @@
+// Tick-to-bar aggregation: 10M ticks rolled into 1s/1m/5m/1h bars in one
+// pass, and one year of minute bars resampled to 5m/1h/1d, each checked
+// against a straightforward per-timeframe grouping.
+#include "../src/aggregation/BarAggregator.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Groups candles by timeframe bucket one timeframe at a time.
+std::vector<Candle> naiveResample(const std::vector<Candle>& input, std::time_t seconds) {
+    std::vector<Candle> out;
+    for (const Candle& c : input) {
+        std::time_t start = c.timestamp - c.timestamp % seconds;
+        if (out.empty() || out.back().timestamp != start) {
+            out.push_back({start, c.open, c.high, c.low, c.close, c.volume});
+            continue;
+        }
+        Candle& bar = out.back();
+        bar.high = std::max(bar.high, c.high);
+        bar.low = std::min(bar.low, c.low);
+        bar.close = c.close;
+        bar.volume += c.volume;
+    }
+    return out;
+}
+
+bool same(const std::vector<Candle>& a, const std::vector<Candle>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].timestamp != b[i].timestamp || a[i].open != b[i].open || a[i].high != b[i].high ||
+            a[i].low != b[i].low || a[i].close != b[i].close || a[i].volume != b[i].volume) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::time_t> tickFrames{1, 60, 300, 3600};
+    const size_t tickCount = 10000000;
+
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<Tick> ticks(tickCount);
+    double price = 100.0;
+    std::time_t t = 1700000000;
+    for (auto& tick : ticks) {
+        price *= std::exp(step(rng) * 0.0002);
+        t += rng() % 4 == 0 ? 1 : 0;  // ~4 ticks per second
+        tick = {t, price, 1.0 + rng() % 10};
+    }
+
+    std::vector<std::vector<Candle>> bars(tickFrames.size());
+    for (size_t f = 0; f < tickFrames.size(); ++f) {
+        bars[f].reserve(static_cast<size_t>((t - ticks[0].timestamp) / tickFrames[f]) + 2);
+    }
+    BarAggregator aggregator(tickFrames);
+    auto collect = [&bars](size_t index, const Candle& bar) { bars[index].push_back(bar); };
+    double ms = timeMs([&] {
+        for (const Tick& tick : ticks) aggregator.add(tick, collect);
+        aggregator.flush(collect);
+    });
+
+    std::vector<Candle> asCandles(ticks.size());
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        const Tick& tick = ticks[i];
+        asCandles[i] = {tick.timestamp, tick.price, tick.price, tick.price, tick.price, tick.volume};
+    }
+    bool ticksMatch = true;
+    for (size_t f = 0; f < tickFrames.size(); ++f) {
+        ticksMatch = ticksMatch && same(bars[f], naiveResample(asCandles, tickFrames[f]));
+    }
+    std::printf("ticks     count=%zu timeframes=%zu ms=%.1f ns_per_tick=%.2f bars_1s=%zu bars_1h=%zu match=%s\n",
+                tickCount, tickFrames.size(), ms, ms * 1e6 / tickCount,
+                bars[0].size(), bars[3].size(), ticksMatch ? "yes" : "no");
+
+    // One year of minute bars rolled up for a backtest.
+    const std::vector<std::time_t> barFrames{300, 3600, 86400};
+    std::vector<Candle> minutes = naiveResample(asCandles, 60);
+    while (minutes.size() < 525600) {
+        Candle next = minutes.back();
+        next.timestamp += 60;
+        minutes.push_back(next);
+    }
+    std::vector<std::vector<Candle>> rolled;
+    CandleColumns columns = CandleColumns::fromCandles(minutes.data(), minutes.size());
+    ms = timeMs([&] { rolled = BarAggregator::resample(columns, barFrames); });
+
+    bool barsMatch = true;
+    for (size_t f = 0; f < barFrames.size(); ++f) {
+        barsMatch = barsMatch && same(rolled[f], naiveResample(minutes, barFrames[f]));
+    }
+    std::printf("resample  minutes=%zu timeframes=%zu ms=%.2f ns_per_bar=%.2f bars_1d=%zu match=%s\n",
+                minutes.size(), barFrames.size(), ms, ms * 1e6 / minutes.size(),
+                rolled[2].size(), barsMatch ? "yes" : "no");
+}
\ No newline at end of file
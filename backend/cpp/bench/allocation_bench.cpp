@@ -0,0 +1,123 @@
+// Heap allocations per backtest once warm: every strategy is swept over a
+// candidate list twice, with and without an indicator cache, through one
+// Backtester and one reused result per worker as ParameterSweep does. The
+// second pass must not touch the heap, and neither may a repeat call of the
+// batch indicators beyond the series they return.
+#include "../src/backtesting/Backtester.hpp"
+#include "../src/strategies/RSIStrategy.hpp"
+#include "../src/strategies/MACDStrategy.hpp"
+#include "../src/strategies/BollingerBandsStrategy.hpp"
+#include "../src/strategies/EnhancedRSIStrategy.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+std::vector<Candle> randomCandles(size_t size) {
+    std::mt19937_64 rng(5);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<Candle> candles(size);
+    double price = 100.0;
+    for (size_t i = 0; i < size; ++i) {
+        price *= std::exp(step(rng) * 0.003);
+        candles[i] = {static_cast<std::time_t>(1600000000 + 60 * i), price, price, price, price, 1000.0};
+    }
+    return candles;
+}
+
+// Allocations made by the second of two identical passes over `candidates`.
+size_t warmPassAllocations(std::shared_ptr<Strategy> strategy, const CandleColumns& bars,
+                           const std::vector<std::vector<double>>& candidates,
+                           std::shared_ptr<IndicatorCache> cache) {
+    if (cache) strategy->attachCache(cache, 1);
+    Backtester backtester(100000.0, 0.001);
+    backtester.setStrategy(strategy);
+    Backtester::BacktestResult result;
+
+    size_t before = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1) before = allocations.load();
+        for (const auto& params : candidates) {
+            strategy->updateParameters(params);
+            backtester.run(bars, 0, bars.size, result);
+        }
+    }
+    return allocations.load() - before;
+}
+
+} // namespace
+
+// GCC flags the replaced pair as mismatched once both are inlined into the
+// same translation unit; they are a matching malloc/free pair.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+int main() {
+    std::vector<Candle> candles = randomCandles(200000);
+    CandleColumns bars = CandleColumns::fromCandles(candles.data(), candles.size());
+
+    struct Case {
+        const char* name;
+        std::shared_ptr<Strategy> (*make)();
+        std::vector<std::vector<double>> candidates;
+    };
+    std::vector<Case> cases{
+        {"rsi", [] { return std::shared_ptr<Strategy>(std::make_shared<RSIStrategy>()); },
+         {{7, 30, 70}, {14, 25, 75}, {21, 30, 70}}},
+        {"macd", [] { return std::shared_ptr<Strategy>(std::make_shared<MACDStrategy>()); },
+         {{12, 26, 9, 0.0}, {8, 21, 5, 0.0}, {5, 35, 5, 0.01}}},
+        {"bollinger", [] { return std::shared_ptr<Strategy>(std::make_shared<BollingerBandsStrategy>()); },
+         {{20, 2.0, 0.2}, {50, 2.5, 0.1}, {10, 1.5, 0.3}}},
+        {"enhanced", [] { return std::shared_ptr<Strategy>(std::make_shared<EnhancedRSIStrategy>()); },
+         {{14, 50, 30, 70, 0.02, 0.04}, {7, 20, 25, 75, 0.01, 0.03}}},
+    };
+
+    bool clean = true;
+    for (const Case& c : cases) {
+        size_t streaming = warmPassAllocations(c.make(), bars, c.candidates, nullptr);
+        size_t cached = warmPassAllocations(c.make(), bars, c.candidates, std::make_shared<IndicatorCache>());
+        std::printf("%-9s candidates=%zu warm_allocations streaming=%zu cached=%zu\n",
+                    c.name, c.candidates.size(), streaming, cached);
+        clean = clean && streaming == 0 && cached == 0;
+    }
+
+    // Batch indicators keep their temporaries in the thread's arena: a
+    // repeat call allocates only the series it returns.
+    std::vector<double> closes(candles.size());
+    for (size_t i = 0; i < candles.size(); ++i) closes[i] = candles[i].close;
+    RSI::calculate(closes, 14);
+    MACD::calculate(closes, 12, 26, 9);
+    Arena::Stats warm = Arena::local().stats();
+
+    size_t before = allocations.load();
+    RSI::calculate(closes, 14);
+    size_t rsiAllocations = allocations.load() - before;
+    before = allocations.load();
+    MACD::calculate(closes, 12, 26, 9);
+    size_t macdAllocations = allocations.load() - before;
+    const Arena::Stats& arena = Arena::local().stats();
+
+    std::printf("batch     rsi_allocations=%zu macd_allocations=%zu arena_blocks=%zu arena_new_blocks=%zu "
+                "arena_peak_bytes=%zu arena_in_use=%zu\n",
+                rsiAllocations, macdAllocations, arena.blockAllocations,
+                arena.blockAllocations - warm.blockAllocations, arena.peakBytes, arena.bytesInUse);
+    clean = clean && rsiAllocations == 1 && macdAllocations == 3 &&
+            arena.blockAllocations == warm.blockAllocations && arena.bytesInUse == 0;
+
+    std::printf("allocation_free=%s\n", clean ? "yes" : "no");
+    return clean ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+// Gaussian-process surrogate and Bayesian optimization. Times incremental
+// observations against refactoring the kernel matrix from scratch, checks
+// the incremental model predicts what a from-scratch solve does, times
+// batched predictions, and runs a Bayesian optimization of RSIStrategy
+// against random search with the same backtest budget, checking its result
+// does not depend on the thread count.
+#include "../src/backtesting/BayesianOptimizer.hpp"
+#include "../src/strategies/RSIStrategy.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+std::vector<Candle> randomCandles(size_t size) {
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<Candle> candles(size);
+    double price = 45000.0;
+    for (size_t i = 0; i < size; ++i) {
+        price += step(rng) * 20.0;
+        candles[i] = {static_cast<std::time_t>(i * 60), price, price, price, price, 1000.0};
+    }
+    return candles;
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+double rbf(const double* a, const double* b, size_t dims, double lengthScale) {
+    double distance = 0.0;
+    for (size_t d = 0; d < dims; ++d) distance += (a[d] - b[d]) * (a[d] - b[d]);
+    return std::exp(-distance / (2.0 * lengthScale * lengthScale));
+}
+
+// Textbook GP fit: dense Cholesky of K + noise I, then the same GLS mean.
+struct ReferenceModel {
+    size_t n, dims;
+    double lengthScale;
+    const std::vector<double>& x;
+    std::vector<double> chol, alpha;
+    double prior = 0.0;
+
+    ReferenceModel(const std::vector<double>& x, const std::vector<double>& y, size_t dims, double lengthScale)
+        : n(y.size()), dims(dims), lengthScale(lengthScale), x(x), chol(n * n, 0.0), alpha(n) {
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j <= i; ++j) {
+                double sum = rbf(&x[i * dims], &x[j * dims], dims, lengthScale) + (i == j ? 1e-6 : 0.0);
+                for (size_t k = 0; k < j; ++k) sum -= chol[i * n + k] * chol[j * n + k];
+                chol[i * n + j] = i == j ? std::sqrt(std::max(sum, 1e-10)) : sum / chol[j * n + j];
+            }
+        }
+        std::vector<double> ky = solve(y), ones(n, 1.0), k1 = solve(ones);
+        double a = 0.0, b = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            a += ky[i];
+            b += k1[i];
+        }
+        prior = a / b;
+        for (size_t i = 0; i < n; ++i) alpha[i] = ky[i] - prior * k1[i];
+    }
+
+    std::vector<double> forward(std::vector<double> v) const {
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < i; ++j) v[i] -= chol[i * n + j] * v[j];
+            v[i] /= chol[i * n + i];
+        }
+        return v;
+    }
+
+    std::vector<double> solve(const std::vector<double>& b) const {
+        std::vector<double> v = forward(b);
+        for (size_t i = n; i-- > 0;) {
+            for (size_t j = i + 1; j < n; ++j) v[i] -= chol[j * n + i] * v[j];
+            v[i] /= chol[i * n + i];
+        }
+        return v;
+    }
+
+    GaussianProcess::Prediction predict(const double* point) const {
+        std::vector<double> k(n);
+        double mean = prior;
+        for (size_t i = 0; i < n; ++i) {
+            k[i] = rbf(&x[i * dims], point, dims, lengthScale);
+            mean += k[i] * alpha[i];
+        }
+        std::vector<double> v = forward(k);
+        double variance = 1.0;
+        for (double e : v) variance -= e * e;
+        return {mean, std::sqrt(std::max(variance, 0.0))};
+    }
+};
+
+} // namespace
+
+int main() {
+    const size_t dims = 3;
+    const double lengthScale = 0.3;
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto objective = [](const double* p) { return std::sin(6.0 * p[0]) + p[1] * p[1] - std::cos(4.0 * p[2]); };
+
+    // Incremental adds up to n = 1000, against one dense refactorization
+    // at the sizes where a refit-per-observation model would pay it.
+    const size_t observations = 1000;
+    std::vector<double> xs(observations * dims), ys(observations);
+    for (size_t i = 0; i < observations; ++i) {
+        for (size_t d = 0; d < dims; ++d) xs[i * dims + d] = unit(rng);
+        ys[i] = objective(&xs[i * dims]);
+    }
+    GaussianProcess model(dims, lengthScale);
+    double addMs[3] = {};
+    size_t marks[3] = {250, 500, 1000};
+    for (size_t i = 0, m = 0; i < observations; ++i) {
+        bool timed = m < 3 && i + 1 == marks[m];
+        double ms = timeMs([&] { model.add(&xs[i * dims], ys[i]); });
+        if (timed) addMs[m++] = ms;
+    }
+    for (size_t m = 0; m < 3; ++m) {
+        std::vector<double> x(xs.begin(), xs.begin() + marks[m] * dims), y(ys.begin(), ys.begin() + marks[m]);
+        double refitMs = timeMs([&] { ReferenceModel reference(x, y, dims, lengthScale); });
+        std::printf("gp        n=%zu add_ms=%.3f refit_ms=%.3f\n", marks[m], addMs[m], refitMs);
+    }
+
+    // Predictions of the incremental model against a from-scratch fit.
+    const size_t checked = 300;
+    GaussianProcess small(dims, lengthScale);
+    for (size_t i = 0; i < checked; ++i) small.add(&xs[i * dims], ys[i]);
+    std::vector<double> x(xs.begin(), xs.begin() + checked * dims), y(ys.begin(), ys.begin() + checked);
+    ReferenceModel reference(x, y, dims, lengthScale);
+    double worst = 0.0;
+    for (int i = 0; i < 200; ++i) {
+        double point[dims] = {unit(rng), unit(rng), unit(rng)};
+        auto a = small.predict(point);
+        auto b = reference.predict(point);
+        worst = std::max({worst, std::abs(a.mean - b.mean), std::abs(a.sd - b.sd)});
+    }
+    bool match = worst < 1e-6;
+    std::printf("gp        n=%zu max_prediction_error=%.2e match=%s\n", checked, worst, match ? "yes" : "no");
+
+    // Batched predictions over 4096 candidates at n = 1000.
+    const size_t batch = 4096;
+    std::vector<double> candidates(batch * dims);
+    for (double& c : candidates) c = unit(rng);
+    std::vector<GaussianProcess::Prediction> out(batch);
+    double oneMs = timeMs([&] { model.predict(candidates.data(), batch, out.data(), 1); });
+    double allMs = timeMs([&] { model.predict(candidates.data(), batch, out.data(), 0); });
+    std::printf("predict   n=%zu candidates=%zu one_thread_ms=%.1f all_threads_ms=%.1f\n",
+                observations, batch, oneMs, allMs);
+
+    // Bayesian optimization of RSIStrategy against random search.
+    const auto candles = randomCandles(100000);
+    RSIStrategy prototype;
+    std::vector<ParameterRange> ranges = {{5, 50, true}, {10, 40, false}, {60, 90, false}};
+
+    BayesianOptions options;
+    options.initialPoints = 8;
+    options.iterations = 32;
+    options.seed = 11;
+    options.threads = 1;
+    BayesianOptimizer::Result single, parallel;
+    double boMs = timeMs([&] { single = BayesianOptimizer::run(prototype, candles, ranges, options); });
+    options.threads = 4;
+    parallel = BayesianOptimizer::run(prototype, candles, ranges, options);
+
+    bool same = single.evaluations.size() == parallel.evaluations.size() && single.best == parallel.best;
+    for (size_t i = 0; same && i < single.evaluations.size(); ++i) {
+        same = single.evaluations[i].params == parallel.evaluations[i].params &&
+               single.evaluations[i].score == parallel.evaluations[i].score;
+    }
+
+    const size_t budget = options.initialPoints + options.iterations;
+    std::vector<std::vector<double>> randomSets(budget);
+    std::mt19937_64 draws(11);
+    for (auto& params : randomSets) {
+        params = {std::round(5 + unit(draws) * 45), 10 + unit(draws) * 30, 60 + unit(draws) * 30};
+    }
+    SweepOptions sweep;
+    double randomBest = ParameterSweep::run(prototype, candles, randomSets, sweep).front().score;
+
+    std::printf("bayesian  evaluations=%zu ms=%.1f best_sharpe=%.4f random_search_best=%.4f "
+                "thread_count_independent=%s\n",
+                single.evaluations.size(), boMs, single.evaluations[single.best].score, randomBest,
+                same ? "yes" : "no");
+    return match && same ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+// Micro-benchmark: rolling BollingerBands::calculate vs. the original
+// O(n * period) two-pass implementation, at periods 20, 200 and 2000.
+// Also reports the largest deviation between the two outputs, relative to
+// the reference standard deviation: the bands sit ~45000 away from zero, so
+// relative to the band value even a wrong deviation would look tiny. Fails
+// if that exceeds the bound RollingStats documents.
+#include "../src/indicators/BollingerBands.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+// The implementation BollingerBands::calculate used before the rolling
+// rewrite, kept verbatim as the accuracy and speed baseline.
+BollingerBands::BBands referenceBands(const std::vector<double>& prices,
+                                      int period, double multiplier) {
+    std::vector<double> upper(prices.size());
+    std::vector<double> middle(prices.size());
+    std::vector<double> lower(prices.size());
+
+    for (size_t i = period - 1; i < prices.size(); ++i) {
+        double sum = 0.0;
+        for (size_t j = 0; j < static_cast<size_t>(period); ++j) {
+            sum += prices[i - j];
+        }
+        middle[i] = sum / period;
+
+        double variance = 0.0;
+        for (size_t j = 0; j < static_cast<size_t>(period); ++j) {
+            variance += std::pow(prices[i - j] - middle[i], 2);
+        }
+        variance /= period;
+        double stdDev = std::sqrt(variance);
+
+        upper[i] = middle[i] + (multiplier * stdDev);
+        lower[i] = middle[i] - (multiplier * stdDev);
+    }
+
+    return {upper, middle, lower};
+}
+
+std::vector<double> randomWalk(size_t size) {
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<double> prices(size);
+    double price = 45000.0;
+    for (auto& p : prices) {
+        price += step(rng);
+        p = price;
+    }
+    return prices;
+}
+
+template <typename F>
+double bestOfMs(int repeats, F&& f) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best) best = elapsed.count();
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    const size_t bars = 200000;
+    const auto prices = randomWalk(bars);
+
+    std::printf("bars=%zu\n", bars);
+    std::printf("%8s %12s %12s %9s %14s %17s %6s\n",
+                "period", "old_ms", "new_ms", "speedup", "max_abs_err", "max_err_vs_stddev", "match");
+
+    const double bound = 1e-9;
+    bool allMatch = true;
+
+    for (int period : {20, 200, 2000}) {
+        BollingerBands::BBands oldBands, newBands;
+        double oldMs = bestOfMs(period >= 2000 ? 1 : 3,
+                                [&] { oldBands = referenceBands(prices, period, 2.0); });
+        double newMs = bestOfMs(5,
+                                [&] { newBands = BollingerBands::calculate(prices, period, 2.0); });
+
+        double maxAbs = 0.0;
+        double maxRel = 0.0;
+        for (size_t i = period - 1; i < bars; ++i) {
+            double stdDev = (oldBands.upper[i] - oldBands.middle[i]) / 2.0;
+            for (auto [a, b] : {std::pair{oldBands.upper[i], newBands.upper[i]},
+                                std::pair{oldBands.middle[i], newBands.middle[i]},
+                                std::pair{oldBands.lower[i], newBands.lower[i]}}) {
+                double err = std::abs(a - b);
+                maxAbs = std::max(maxAbs, err);
+                if (stdDev > 0.0) maxRel = std::max(maxRel, err / stdDev);
+            }
+        }
+
+        bool match = maxRel <= bound;
+        allMatch = allMatch && match;
+        std::printf("%8d %12.3f %12.3f %8.1fx %14.3e %17.3e %6s\n",
+                    period, oldMs, newMs, oldMs / newMs, maxAbs, maxRel, match ? "yes" : "no");
+    }
+    return allMatch ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+// Startup cost of a backtest: parsing a CSV history versus mapping the same
+// history from a CandleStore, followed by a time-range slice and a backtest
+// over it read in place from the mapped columns, and a check that a header
+// whose bar count overflows the column size is rejected.
+#include "../src/storage/CandleStore.hpp"
+#include "../src/backtesting/Backtester.hpp"
+#include "../src/strategies/MACDStrategy.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main() {
+    const size_t bars = 525600;  // one year of 1-minute bars
+    const std::string csvPath = "/tmp/candle_store_bench.csv";
+    const std::string storePath = "/tmp/candle_store_bench.candles";
+    const std::time_t start = 1600000000;
+
+    {
+        FILE* csv = std::fopen(csvPath.c_str(), "w");
+        if (!csv) return 1;
+        std::mt19937_64 rng(42);
+        std::normal_distribution<double> step(0.0, 1.0);
+        double price = 45000.0;
+        std::fprintf(csv, "timestamp,open,high,low,close,volume\n");
+        for (size_t i = 0; i < bars; ++i) {
+            double open = price;
+            price += step(rng) * 10.0;
+            std::fprintf(csv, "%lld,%.2f,%.2f,%.2f,%.2f,%.3f\n",
+                         static_cast<long long>(start + i * 60), open,
+                         std::max(open, price) + 5.0, std::min(open, price) - 5.0, price, 1000.0);
+        }
+        std::fclose(csv);
+    }
+
+    size_t converted = 0;
+    double convertMs = timeMs([&] { converted = CandleStore::convertCsv(csvPath, storePath); });
+
+    size_t mapped = 0;
+    CandleColumns month;
+    double openMs = timeMs([&] {
+        CandleStore store(storePath);
+        mapped = store.size();
+        month = store.range(start + 180 * 86400, start + 210 * 86400);
+    });
+
+    CandleStore store(storePath);
+    Backtester backtester;
+    backtester.setStrategy(std::make_shared<MACDStrategy>());
+    Backtester::BacktestResult result;
+    double fullMs = timeMs([&] { result = backtester.run(store.columns()); });
+
+    std::printf("bars=%zu csv_parse_ms=%.1f store_open_and_slice_ms=%.3f slice_bars=%zu\n",
+                converted, convertMs, openMs, month.size);
+    std::printf("backtest_over_mapped_columns_ms=%.1f trades=%zu mapped=%zu\n",
+                fullMs, result.trades.size(), mapped);
+
+    // count * sizeof(double) wraps around to 8 bytes for this count.
+    bool rejected = false;
+    {
+        FILE* file = std::fopen(storePath.c_str(), "r+b");
+        if (!file) return 1;
+        std::uint64_t count = (std::uint64_t(1) << 61) + 1;
+        std::fseek(file, offsetof(CandleStore::Header, count), SEEK_SET);
+        std::fwrite(&count, sizeof(count), 1, file);
+        std::fclose(file);
+        try {
+            CandleStore corrupt(storePath);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+    }
+    std::printf("overflowing_count_rejected=%s\n", rejected ? "yes" : "no");
+
+    std::remove(csvPath.c_str());
+    std::remove(storePath.c_str());
+    return converted == bars && mapped == bars && rejected ? 0 : 1;
+}
\ No newline at end of file
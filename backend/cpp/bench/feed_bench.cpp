@@ -0,0 +1,98 @@
+// Market-data ring: one producer publishing ticks to two consumers that each
+// run an RSI strategy over them. Reports sustained throughput when the
+// producer publishes flat out, and publish-to-signal latency when it is
+// paced at 100k ticks/s, and checks that both consumers saw every tick.
+#include "../src/utils/SpmcRing.hpp"
+#include "../src/strategies/RSIStrategy.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+struct Consumer {
+    std::vector<std::int64_t> latencies;
+    std::uint64_t received = 0;
+    std::uint64_t signals = 0;
+    bool ordered = true;
+};
+
+// Publishes `ticks` ticks, one every `intervalNs` (0 = as fast as the ring
+// accepts them), while two consumers drain the ring into RSI strategies.
+// The tick's volume field carries its publish time.
+double run(size_t ticks, std::int64_t intervalNs, Consumer (&consumers)[2]) {
+    SpmcRing<Candle> ring(4096, 2);
+    int ids[2] = {ring.subscribe(), ring.subscribe()};
+
+    std::vector<std::thread> workers;
+    for (int c = 0; c < 2; ++c) {
+        workers.emplace_back([&, c] {
+            Consumer& consumer = consumers[c];
+            consumer.latencies.reserve(ticks);
+            RSIStrategy strategy;
+            std::time_t expected = 0;
+            while (consumer.received < ticks) {
+                size_t got = ring.drain(ids[c], 256, [&](const Candle& tick) {
+                    if (strategy.onCandle(tick)) ++consumer.signals;
+                    consumer.ordered = consumer.ordered && tick.timestamp == expected++;
+                    consumer.latencies.push_back(nowNs() - static_cast<std::int64_t>(tick.volume));
+                });
+                consumer.received += got;
+                if (got == 0) std::this_thread::yield();
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    std::int64_t next = nowNs();
+    for (size_t i = 0; i < ticks; ++i) {
+        if (intervalNs > 0) {
+            while (nowNs() < next) std::this_thread::yield();
+            next += intervalNs;
+        }
+        double price = 100.0 + 5.0 * std::sin(i * 0.01) + (i % 13) * 0.1;
+        Candle tick{static_cast<std::time_t>(i), price, price, price, price, 0.0};
+        tick.volume = static_cast<double>(nowNs());
+        while (!ring.publish(tick)) std::this_thread::yield();
+    }
+    for (auto& worker : workers) worker.join();
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, size_t ticks, double seconds, Consumer (&consumers)[2]) {
+    std::vector<std::int64_t> all;
+    bool complete = true;
+    for (auto& consumer : consumers) {
+        all.insert(all.end(), consumer.latencies.begin(), consumer.latencies.end());
+        complete = complete && consumer.received == ticks && consumer.ordered;
+    }
+    std::sort(all.begin(), all.end());
+    auto percentile = [&](double p) { return all[static_cast<size_t>(p * (all.size() - 1))] / 1000.0; };
+    std::printf("%-7s ticks=%zu ticks_per_s=%.0f latency_us p50=%.2f p99=%.2f p999=%.2f max=%.2f "
+                "signals=%llu complete=%s\n",
+                name, ticks, ticks / seconds, percentile(0.5), percentile(0.99), percentile(0.999),
+                all.back() / 1000.0, static_cast<unsigned long long>(consumers[0].signals),
+                complete ? "yes" : "no");
+}
+
+} // namespace
+
+int main() {
+    const size_t ticks = 2000000;
+    Consumer flat[2];
+    report("flat", ticks, run(ticks, 0, flat), flat);
+
+    const size_t pacedTicks = 200000;
+    Consumer paced[2];
+    report("100k/s", pacedTicks, run(pacedTicks, 10000, paced), paced);
+}
\ No newline at end of file
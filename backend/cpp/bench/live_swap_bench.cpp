@@ -0,0 +1,146 @@
+// Parameter hot-swap: an RSIStrategy fed two million bars directly and
+// through a LiveStrategy while another thread publishes a new period every
+// 100k bars. Reports the per-bar cost of the wrapper and the slowest bars
+// (on a machine with fewer cores than threads these include preemption),
+// the slowest bar that switched instances, and checks that after the last switch the live
+// signals equal a full-history run with the final parameters, and that
+// analyze() calls racing a publication each run on either the old or the
+// new parameters, never a mix.
+#include "../src/strategies/LiveStrategy.hpp"
+#include "../src/strategies/RSIStrategy.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedNs(Clock::time_point from) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - from).count();
+}
+
+bool sameSignals(const std::vector<Trade>& a, const std::vector<Trade>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].type != b[i].type || a[i].timestamp != b[i].timestamp || a[i].price != b[i].price) return false;
+    }
+    return true;
+}
+
+std::unique_ptr<Strategy> rsi(double period) {
+    auto strategy = std::make_unique<RSIStrategy>();
+    strategy->updateParameters({period, 30.0, 70.0});
+    return strategy;
+}
+
+} // namespace
+
+int main() {
+    const size_t bars = 2000000;
+    const size_t every = 100000;
+    std::vector<Candle> candles(bars);
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+    double price = 45000.0;
+    for (size_t i = 0; i < bars; ++i) {
+        price *= std::exp(step(rng) * 0.002);
+        candles[i] = Candle{static_cast<std::time_t>(i * 60), price, price, price, price, 1000.0};
+    }
+
+    // Both loops read the clock around every bar, so the per-bar figures
+    // include that overhead alike.
+    std::unique_ptr<Strategy> plain = rsi(14);
+    for (const Candle& candle : candles) plain->onCandle(candle);
+    plain->reset();
+    auto begin = Clock::now();
+    size_t plainSignals = 0;
+    double slowestPlainNs = 0.0;
+    for (const Candle& candle : candles) {
+        auto start = Clock::now();
+        plainSignals += plain->onCandle(candle) ? 1 : 0;
+        slowestPlainNs = std::max(slowestPlainNs, elapsedNs(start));
+    }
+    double plainNs = elapsedNs(begin) / bars;
+
+    // Publications happen on the live thread's schedule but from another
+    // thread, which waits for the live thread to pass each publishing bar.
+    LiveStrategy live(rsi(14));
+    std::atomic<size_t> progress{0};
+    const double finalPeriod = 21;
+    std::atomic<std::uint64_t> finalVersion{0};
+    std::thread publisher([&] {
+        for (size_t k = 1; k < bars / every / 2; ++k) {
+            while (progress.load(std::memory_order_acquire) < k * every) std::this_thread::yield();
+            double period = k + 1 < bars / every / 2 ? 8.0 + (k % 5) * 4.0 : finalPeriod;
+            std::uint64_t version = live.publish({period, 30.0, 70.0});
+            if (period == finalPeriod) finalVersion.store(version, std::memory_order_release);
+        }
+    });
+
+    std::vector<Trade> afterSwap;
+    size_t switchedAt = bars;
+    size_t switches = 0;
+    double slowestSwitchNs = 0.0;
+    double slowestLiveNs = 0.0;
+    std::uint64_t seen = 0;
+    begin = Clock::now();
+    for (size_t i = 0; i < bars; ++i) {
+        auto start = Clock::now();
+        auto trade = live.onCandle(candles[i]);
+        double ns = elapsedNs(start);
+        slowestLiveNs = std::max(slowestLiveNs, ns);
+        std::uint64_t applied = live.appliedVersion();
+        if (applied != seen) {
+            slowestSwitchNs = std::max(slowestSwitchNs, ns);
+            seen = applied;
+            ++switches;
+        }
+        if (switchedAt == bars && applied != 0 && applied == finalVersion.load(std::memory_order_acquire)) {
+            switchedAt = i;
+        }
+        if (switchedAt < i && trade) afterSwap.push_back(*trade);
+        if ((i & 1023) == 0) progress.store(i, std::memory_order_release);
+    }
+    double liveNs = elapsedNs(begin) / bars;
+    publisher.join();
+
+    std::unique_ptr<Strategy> reference = rsi(finalPeriod);
+    std::vector<Trade> expected;
+    for (size_t i = 0; i < bars; ++i) {
+        auto trade = reference->onCandle(candles[i]);
+        if (i > switchedAt && trade) expected.push_back(*trade);
+    }
+    bool swapMatch = switchedAt < bars && sameSignals(expected, afterSwap);
+    std::printf("stream bars=%zu plain_ns_per_bar=%.1f live_ns_per_bar=%.1f slowest_plain_bar_ns=%.0f "
+                "slowest_live_bar_ns=%.0f signals=%zu\n",
+                bars, plainNs, liveNs, slowestPlainNs, slowestLiveNs, plainSignals);
+    std::printf("swaps published=%zu applied=%zu slowest_switch_ns=%.0f final_applied_at_bar=%zu "
+                "after_swap_signals=%zu match=%s\n",
+                bars / every / 2 - 1, switches, slowestSwitchNs, switchedAt, afterSwap.size(),
+                swapMatch ? "yes" : "no");
+
+    // analyze() resets the strategy on every call, as the bridge's
+    // analyze_market_data does, so each call must equal a plain strategy
+    // with the old or the new parameters.
+    std::vector<Candle> window(candles.begin(), candles.begin() + 5000);
+    std::vector<Trade> before = rsi(14)->analyze(window);
+    std::vector<Trade> after = rsi(9)->analyze(window);
+    LiveStrategy analyzed(rsi(14));
+    std::uint64_t version = analyzed.publish({9.0, 30.0, 70.0});
+    bool analyzeMatch = true;
+    size_t calls = 0;
+    for (;;) {
+        bool done = analyzed.appliedVersion() == version;
+        std::vector<Trade> trades = analyzed.analyze(window);
+        ++calls;
+        analyzeMatch = analyzeMatch && (sameSignals(trades, before) || sameSignals(trades, after));
+        if (done) {
+            analyzeMatch = analyzeMatch && sameSignals(trades, after);
+            break;
+        }
+    }
+    std::printf("analyze calls=%zu match=%s\n", calls, analyzeMatch ? "yes" : "no");
+    return swapMatch && analyzeMatch ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+// Hot-path instrumentation, built with TRADING_METRICS=1: the cost of one
+// timed event and one counter update, the RSI strategy's onCandle with its
+// timer against the stream indicator alone, and a check that histograms
+// merged from several threads account for every event and place the
+// quantiles of a known distribution within the bucket error.
+#define TRADING_METRICS 1
+#include "../src/utils/Metrics.hpp"
+#include "../src/strategies/RSIStrategy.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+volatile std::uint64_t sink;
+
+template <typename Body>
+double nsPerCall(size_t calls, Body body) {
+    double best = INFINITY;
+    for (int rep = 0; rep < 3; ++rep) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < calls; ++i) body(i);
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        best = std::min(best, elapsed.count() / calls);
+    }
+    return best;
+}
+
+const Metrics::Sample* find(const std::vector<Metrics::Sample>& samples, const char* name, const char* label) {
+    for (const auto& sample : samples) {
+        if (std::strcmp(sample.name, name) == 0 && std::strcmp(sample.label, label) == 0) return &sample;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+int main() {
+    const size_t calls = 5000000;
+
+    double bare = nsPerCall(calls, [](size_t i) { sink = sink + i; });
+    double timed = nsPerCall(calls, [](size_t i) {
+        TRADING_TIMED("bench_event_ns", "");
+        sink = sink + i;
+    });
+    double counted = nsPerCall(calls, [](size_t i) {
+        TRADING_COUNT("bench_events", "", 1);
+        sink = sink + i;
+    });
+    std::printf("event     timer_ns=%.1f counter_ns=%.1f under_50ns=%s\n",
+                timed - bare, counted - bare, timed - bare < 50.0 ? "yes" : "no");
+
+    const size_t bars = 1000000;
+    std::vector<Candle> candles(bars);
+    for (size_t i = 0; i < bars; ++i) {
+        double price = 100.0 + 5.0 * std::sin(i * 0.01) + (i % 13) * 0.1;
+        candles[i] = Candle{static_cast<std::time_t>(i * 60), price, price, price, price, 1.0};
+    }
+    RSIStream stream(14);
+    RSIStrategy strategy;
+    double indicator = nsPerCall(bars, [&](size_t i) { sink = sink + static_cast<std::uint64_t>(stream.update(candles[i].close)); });
+    double onCandle = nsPerCall(bars, [&](size_t i) { sink = sink + (strategy.onCandle(candles[i]) ? 1 : 0); });
+    std::printf("strategy  rsi_stream_ns=%.1f on_candle_timed_ns=%.1f\n", indicator, onCandle);
+
+    // Four threads each record 0..99999 ticks once, into a timer of their own
+    // call site shared by name.
+    const unsigned threads = 4;
+    const std::uint64_t values = 100000;
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([] {
+            static const int id = Metrics::timer("bench_known_ticks", "");
+            for (std::uint64_t v = 0; v < values; ++v) Metrics::record(id, v);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    auto samples = Metrics::snapshot();
+    const Metrics::Sample* known = find(samples, "bench_known_ticks", "");
+    const Metrics::Sample* events = find(samples, "bench_events", "");
+    const Metrics::Sample* onCandles = find(samples, "strategy_on_candle_ns", "RSI Strategy");
+    double scale = Metrics::nanosPerTick();
+    auto near = [&](double ns, double ticks) { return std::abs(ns / scale - ticks) <= 0.07 * ticks + 1.0; };
+
+    bool complete = known && known->count == threads * values && events && events->count == 3 * calls &&
+                    onCandles && onCandles->count == 3 * bars;
+    bool quantiles = known && near(known->p50, 0.5 * values) && near(known->p99, 0.99 * values) &&
+                     near(known->max, values - 1.0) && near(known->min, 0.0);
+    std::printf("merge     metrics=%zu events=%llu complete=%s quantiles=%s\n", samples.size(),
+                known ? static_cast<unsigned long long>(known->count) : 0ull,
+                complete ? "yes" : "no", quantiles ? "yes" : "no");
+    return complete && quantiles ? 0 : 1;
+}
\ No newline at end of file
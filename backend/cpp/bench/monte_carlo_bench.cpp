@@ -0,0 +1,62 @@
+// Monte Carlo throughput: 1M shuffle and 1M bootstrap paths over 250 trade
+// PnLs, and a check that one worker and every hardware thread give the
+// same answer for the same seed.
+#include "../src/backtesting/MonteCarlo.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+bool same(const MonteCarloResult& a, const MonteCarloResult& b) {
+    return a.finalBalance.lower == b.finalBalance.lower && a.maxDrawdown.upper == b.maxDrawdown.upper &&
+           a.sharpeRatio.median == b.sharpeRatio.median && a.cvar99 == b.cvar99 &&
+           a.maxLossStreaks == b.maxLossStreaks && a.averageRecoveryTime == b.averageRecoveryTime;
+}
+
+void report(const char* name, const MonteCarloResult& r, double ms) {
+    std::printf("%-9s paths=%zu length=%zu ms=%.1f ns_per_step=%.2f\n",
+                name, r.paths, r.pathLength, ms, ms * 1e6 / (r.paths * r.pathLength));
+    std::printf("          final=[%.0f %.0f %.0f] max_dd=[%.3f %.3f %.3f] var95=%.4f cvar95=%.4f var99=%.4f cvar99=%.4f\n",
+                r.finalBalance.lower, r.finalBalance.median, r.finalBalance.upper,
+                r.maxDrawdown.lower, r.maxDrawdown.median, r.maxDrawdown.upper,
+                r.var95, r.cvar95, r.var99, r.cvar99);
+    std::printf("          loss_p=%.4f ruin_p=%.4f win_streak=%.2f loss_streak=%.2f recovery=%.1f/%zu (p=%.3f)\n",
+                r.lossProbability, r.ruinProbability, r.averageWinStreak, r.averageLossStreak,
+                r.averageRecoveryTime, r.maxRecoveryTime, r.recoveryProbability);
+}
+
+} // namespace
+
+int main() {
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> edge(15.0, 120.0);
+    std::vector<double> pnl(250);
+    for (double& trade : pnl) trade = edge(rng);
+
+    MonteCarloOptions options;
+    options.paths = 1000000;
+    options.seed = 42;
+
+    bool match = true;
+    for (Resampling mode : {Resampling::Shuffle, Resampling::Bootstrap}) {
+        options.mode = mode;
+        options.threads = 0;
+        MonteCarloResult all;
+        double ms = timeMs([&] { all = MonteCarlo::run(pnl, options); });
+        report(mode == Resampling::Shuffle ? "shuffle" : "bootstrap", all, ms);
+
+        options.threads = 1;
+        match = match && same(all, MonteCarlo::run(pnl, options));
+    }
+    std::printf("thread_count_independent=%s\n", match ? "yes" : "no");
+    return match ? 0 : 1;
+}
\ No newline at end of file
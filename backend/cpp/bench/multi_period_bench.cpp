@@ -0,0 +1,146 @@
+// Multi-period indicator kernels: RSI, EMA and Bollinger Bands for 46
+// periods (5..50) in one pass over the prices, against one calculate() call
+// per period, at every instruction-set level this CPU supports. Both sides
+// keep all 46 series, so both write the whole output; the batched side
+// reuses its matrix between repeats as the separate side reuses the heap.
+// Every batched row must be bit-identical to its separate call. A period x
+// multiplier grid checks that pairs sharing a period share its window.
+#include "../src/indicators/RSI.hpp"
+#include "../src/indicators/MovingAverage.hpp"
+#include "../src/indicators/BollingerBands.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace {
+
+template <typename F>
+double bestOfMs(int repeats, F&& f) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best) best = elapsed.count();
+    }
+    return best;
+}
+
+bool sameRow(const std::vector<double>& expected, const double* row) {
+    return std::memcmp(expected.data(), row, expected.size() * sizeof(double)) == 0;
+}
+
+void report(const char* name, const char* level, size_t periods, double separate, double batched, bool match) {
+    std::printf("%-9s level=%-6s periods=%zu separate_ms=%.1f batched_ms=%.1f speedup=%.2fx match=%s\n",
+                name, level, periods, separate, batched, separate / batched, match ? "yes" : "no");
+}
+
+} // namespace
+
+int main() {
+    const size_t n = 250000;
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<double> prices(n);
+    double price = 45000.0;
+    for (size_t i = 0; i < n; ++i) {
+        price += step(rng) * 20.0;
+        prices[i] = price;
+    }
+
+    std::vector<int> periods;
+    for (int p = 5; p <= 50; ++p) periods.push_back(p);
+    const size_t count = periods.size();
+
+    using Level = VectorKernels::Level;
+    const Level best = VectorKernels::detect();
+    bool allMatch = true;
+    std::vector<std::vector<double>> separate(count);
+    std::vector<BollingerBands::BBands> separateBands(count);
+    std::vector<double> batched(count * n);
+    BollingerBands::BBands batchedBands{batched, batched, batched};
+    std::vector<double> multipliers(count, 2.0);
+    std::vector<double*> bandRows(3 * count);
+    for (size_t k = 0; k < count; ++k) {
+        bandRows[k] = batchedBands.upper.data() + k * n;
+        bandRows[count + k] = batchedBands.middle.data() + k * n;
+        bandRows[2 * count + k] = batchedBands.lower.data() + k * n;
+    }
+
+    for (Level level : {Level::Scalar, Level::AVX2, Level::AVX512}) {
+        if (level > best) continue;
+        VectorKernels::setLevel(level);
+        const char* name = VectorKernels::name(level);
+
+        double oneByOne = bestOfMs(3, [&] {
+            for (size_t k = 0; k < count; ++k) separate[k] = RSI::calculate(prices, periods[k]);
+        });
+        double together = bestOfMs(3, [&] {
+            RSI::calculateMany(prices.data(), n, periods.data(), count, batched.data());
+        });
+        bool match = true;
+        for (size_t k = 0; k < count; ++k) match = match && sameRow(separate[k], batched.data() + k * n);
+        report("rsi", name, count, oneByOne, together, match);
+        allMatch = allMatch && match;
+
+        oneByOne = bestOfMs(3, [&] {
+            for (size_t k = 0; k < count; ++k) separate[k] = MovingAverage::calculateEMA(prices, periods[k]);
+        });
+        together = bestOfMs(3, [&] {
+            MovingAverage::calculateEMAMany(prices.data(), n, periods.data(), count, batched.data());
+        });
+        match = true;
+        for (size_t k = 0; k < count; ++k) match = match && sameRow(separate[k], batched.data() + k * n);
+        report("ema", name, count, oneByOne, together, match);
+        allMatch = allMatch && match;
+
+        oneByOne = bestOfMs(3, [&] {
+            for (size_t k = 0; k < count; ++k) separateBands[k] = BollingerBands::calculate(prices, periods[k], 2.0);
+        });
+        together = bestOfMs(3, [&] {
+            BollingerBands::calculateMany(prices.data(), n, periods.data(), multipliers.data(), count,
+                                          bandRows.data(), bandRows.data() + count, bandRows.data() + 2 * count);
+        });
+        match = true;
+        for (size_t k = 0; k < count; ++k) {
+            match = match && sameRow(separateBands[k].upper, batchedBands.upper.data() + k * n) &&
+                    sameRow(separateBands[k].middle, batchedBands.middle.data() + k * n) &&
+                    sameRow(separateBands[k].lower, batchedBands.lower.data() + k * n);
+        }
+        report("bollinger", name, count, oneByOne, together, match);
+        allMatch = allMatch && match;
+    }
+
+    // 12 periods x 3 multipliers, unsorted and with out-of-range periods
+    // that must come back as zero rows.
+    std::vector<int> gridPeriods;
+    std::vector<double> gridMultipliers;
+    for (int p : {40, 10, 0, 25, 15, 60, 20, 30, 5, 35, 50, 45, static_cast<int>(n) + 1}) {
+        for (double m : {1.5, 2.0, 2.5}) {
+            gridPeriods.push_back(p);
+            gridMultipliers.push_back(m);
+        }
+    }
+    const size_t pairs = gridPeriods.size();
+    std::vector<double> upper(pairs * n), middle(pairs * n), lower(pairs * n, 1.0);
+    std::vector<double*> rows(3 * pairs);
+    for (size_t k = 0; k < pairs; ++k) {
+        rows[k] = upper.data() + k * n;
+        rows[pairs + k] = middle.data() + k * n;
+        rows[2 * pairs + k] = lower.data() + k * n;
+    }
+    double gridMs = bestOfMs(3, [&] {
+        BollingerBands::calculateMany(prices.data(), n, gridPeriods.data(), gridMultipliers.data(), pairs,
+                                      rows.data(), rows.data() + pairs, rows.data() + 2 * pairs);
+    });
+    bool gridMatch = true;
+    for (size_t k = 0; k < pairs; ++k) {
+        auto expected = BollingerBands::calculate(prices, gridPeriods[k], gridMultipliers[k]);
+        gridMatch = gridMatch && sameRow(expected.upper, rows[k]) && sameRow(expected.middle, rows[pairs + k]) &&
+                    sameRow(expected.lower, rows[2 * pairs + k]);
+    }
+    std::printf("grid      pairs=%zu batched_ms=%.1f match=%s\n", pairs, gridMs, gridMatch ? "yes" : "no");
+    return allMatch && gridMatch ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+// Compile-time pipelines against the virtual strategies they reproduce:
+// 10M bars through Strategy::analyze (virtual onCandle per bar) and through
+// the fused StrategyPipeline::run, with a check that both emit the same
+// trades, plus a Backtester run over each. Each path is timed best of three.
+#include "../src/strategies/PipelineRules.hpp"
+#include "../src/strategies/RSIStrategy.hpp"
+#include "../src/strategies/MACDStrategy.hpp"
+#include "../src/strategies/BollingerBandsStrategy.hpp"
+#include "../src/backtesting/Backtester.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+// Best of three runs, so first-touch page faults in the output buffers do
+// not land on whichever path happens to run first.
+template <typename F>
+double timeMs(F&& f) {
+    double best = 0.0;
+    for (int run = 0; run < 3; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (run == 0 || elapsed.count() < best) best = elapsed.count();
+    }
+    return best;
+}
+
+std::vector<Candle> randomCandles(size_t size) {
+    std::mt19937_64 rng(3);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<Candle> candles(size);
+    double price = 100.0;
+    for (size_t i = 0; i < size; ++i) {
+        price *= std::exp(step(rng) * 0.002);
+        candles[i] = {static_cast<std::time_t>(1600000000 + 60 * i), price, price, price, price, 1000.0};
+    }
+    return candles;
+}
+
+bool same(const std::vector<Trade>& a, const std::vector<Trade>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].type != b[i].type || a[i].timestamp != b[i].timestamp ||
+            a[i].price != b[i].price || a[i].reason != b[i].reason) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Pipeline>
+void compare(const char* name, const std::vector<Candle>& candles,
+             std::shared_ptr<Strategy> original, const std::vector<double>& params) {
+    CandleColumns bars = CandleColumns::fromCandles(candles.data(), candles.size());
+    original->updateParameters(params);
+    auto wrapped = std::make_shared<PipelineStrategy<Pipeline>>();
+    wrapped->updateParameters(params);
+
+    std::vector<Trade> virtualTrades;
+    std::vector<Trade> fusedTrades;
+    double virtualMs = timeMs([&] { virtualTrades = original->analyze(bars); });
+    double fusedMs = timeMs([&] { fusedTrades = wrapped->analyze(bars); });
+
+    Pipeline kernel(wrapped->kernel().parameters());
+    size_t signals = 0;
+    double kernelMs = timeMs([&] {
+        kernel.reset();
+        signals = 0;
+        kernel.run(bars, [&signals](const Trade&) { ++signals; });
+    });
+
+    Backtester backtester(100000.0, 0.001);
+    backtester.setStrategy(original);
+    Backtester::BacktestResult virtualResult;
+    double virtualBacktestMs = timeMs([&] { virtualResult = backtester.run(bars); });
+    backtester.setStrategy(wrapped);
+    Backtester::BacktestResult fusedResult;
+    double fusedBacktestMs = timeMs([&] { fusedResult = backtester.run(bars); });
+
+    double n = static_cast<double>(candles.size());
+    std::printf("%-10s virtual_ns_per_bar=%.2f fused_ns_per_bar=%.2f kernel_ns_per_bar=%.2f speedup=%.2fx "
+                "trades=%zu match=%s backtest_ns_per_bar virtual=%.2f fused=%.2f backtest_match=%s\n",
+                name, virtualMs * 1e6 / n, fusedMs * 1e6 / n, kernelMs * 1e6 / n, virtualMs / fusedMs,
+                fusedTrades.size(),
+                same(virtualTrades, fusedTrades) && signals == fusedTrades.size() ? "yes" : "no",
+                virtualBacktestMs * 1e6 / n, fusedBacktestMs * 1e6 / n,
+                virtualResult.finalBalance == fusedResult.finalBalance ? "yes" : "no");
+}
+
+} // namespace
+
+int main() {
+    std::vector<Candle> candles = randomCandles(10000000);
+
+    compare<RSIPipeline>("rsi", candles, std::make_shared<RSIStrategy>(), {14, 30, 70});
+    compare<MACDPipeline>("macd", candles, std::make_shared<MACDStrategy>(), {12, 26, 9, 0.0});
+    compare<BollingerPipeline>("bollinger", candles, std::make_shared<BollingerBandsStrategy>(), {20, 2.0, 0.2});
+
+    CandleColumns bars = CandleColumns::fromCandles(candles.data(), candles.size());
+    RSITrendPipeline trend;
+    size_t signals = 0;
+    double ms = timeMs([&] {
+        trend.reset();
+        signals = 0;
+        trend.run(bars, [&signals](const Trade&) { ++signals; });
+    });
+    std::printf("rsi_trend  kernel_ns_per_bar=%.2f trades=%zu\n", ms * 1e6 / candles.size(), signals);
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+// Portfolio backtest of 32 symbols with an RSI and a MACD strategy each:
+// sharded signal generation against the single-threaded merged loop, which
+// must agree exactly, plus a one-symbol portfolio against Backtester, both
+// with a comfortable balance and with one small enough to be ruined.
+#include "../src/backtesting/PortfolioBacktester.hpp"
+#include "../src/strategies/RSIStrategy.hpp"
+#include "../src/strategies/MACDStrategy.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+// Symbols trade on staggered, partly gappy minute clocks.
+std::vector<Candle> randomCandles(size_t size, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<Candle> candles(size);
+    double price = 50.0 + seed;
+    std::time_t t = 1600000000;
+    for (size_t i = 0; i < size; ++i) {
+        price *= std::exp(step(rng) * 0.002);
+        t += rng() % 8 == 0 ? 120 : 60;
+        candles[i] = {t, price, price, price, price, 1000.0};
+    }
+    return candles;
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+PortfolioBacktester::Result runPortfolio(const std::vector<std::vector<Candle>>& data, bool sharding) {
+    PortfolioBacktester portfolio(100000.0);
+    portfolio.setSharding(sharding);
+    for (size_t s = 0; s < data.size(); ++s) {
+        size_t id = portfolio.addSymbol("SYM" + std::to_string(s), data[s]);
+        portfolio.subscribe(id, std::make_shared<RSIStrategy>());
+        portfolio.subscribe(id, std::make_shared<MACDStrategy>());
+    }
+    return portfolio.run();
+}
+
+} // namespace
+
+int main() {
+    const size_t symbols = 32;
+    const size_t bars = 50000;
+    std::vector<std::vector<Candle>> data;
+    for (size_t s = 0; s < symbols; ++s) data.push_back(randomCandles(bars, static_cast<unsigned>(s + 1)));
+
+    PortfolioBacktester::Result sharded, merged;
+    double shardedMs = timeMs([&] { sharded = runPortfolio(data, true); });
+    double mergedMs = timeMs([&] { merged = runPortfolio(data, false); });
+
+    size_t fills = 0;
+    for (const auto& symbol : sharded.symbols) fills += symbol.trades.size();
+    bool match = sharded.sharded && !merged.sharded &&
+                 sharded.equityCurve == merged.equityCurve && sharded.timestamps == merged.timestamps;
+
+    PortfolioBacktester single(100000.0);
+    single.subscribe(single.addSymbol("ONE", data[0]), std::make_shared<RSIStrategy>());
+    auto portfolioOne = single.run();
+    Backtester backtester(100000.0);
+    backtester.setStrategy(std::make_shared<RSIStrategy>());
+    auto backtestOne = backtester.run(data[0]);
+    bool matchesBacktester = portfolioOne.equityCurve == backtester.equityCurve() &&
+                             portfolioOne.sharpeRatio == backtestOne.sharpeRatio;
+
+    // A balance the unsized signals soon wipe out: both engines must
+    // liquidate at the same bar and stay flat afterwards.
+    PortfolioBacktester small(2.0);
+    small.subscribe(small.addSymbol("ONE", data[0]), std::make_shared<RSIStrategy>());
+    auto portfolioRuined = small.run();
+    Backtester smallBacktester(2.0);
+    smallBacktester.setStrategy(std::make_shared<RSIStrategy>());
+    auto backtestRuined = smallBacktester.run(data[0]);
+    bool ruinMatches = portfolioRuined.ruined && backtestRuined.ruined &&
+                       portfolioRuined.ruinedAt == backtestRuined.ruinedAt &&
+                       portfolioRuined.equityCurve == smallBacktester.equityCurve() &&
+                       portfolioRuined.symbols[0].position == 0.0 && portfolioRuined.maxDrawdown == 1.0 &&
+                       portfolioRuined.totalReturn == backtestRuined.totalReturn;
+
+    std::printf("symbols=%zu bars=%zu timestamps=%zu fills=%zu threads=%u\n",
+                symbols, symbols * bars, sharded.timestamps.size(), fills,
+                ParallelFor::resolveThreads(0, symbols));
+    std::printf("sharded_ms=%.1f merged_loop_ms=%.1f speedup=%.1fx sharded_matches_merged=%s matches_backtester=%s\n",
+                shardedMs, mergedMs, mergedMs / shardedMs, match ? "yes" : "no",
+                matchesBacktester ? "yes" : "no");
+    std::printf("final=%.2f return=%.4f max_drawdown=%.4f sharpe=%.3f sortino=%.3f win_rate=%.3f commission=%.2f\n",
+                sharded.finalBalance, sharded.totalReturn, sharded.maxDrawdown, sharded.sharpeRatio,
+                sharded.sortinoRatio, sharded.winRate, sharded.totalCommission);
+    std::printf("ruined_at=%zu of %zu final=%.2f matches_backtester=%s\n", portfolioRuined.ruinedAt,
+                portfolioRuined.timestamps.size(), portfolioRuined.finalBalance, ruinMatches ? "yes" : "no");
+    return match && matchesBacktester && ruinMatches ? 0 : 1;
+}
\ No newline at end of file
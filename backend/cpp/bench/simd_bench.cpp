@@ -0,0 +1,72 @@
+// Vector kernel speedups: each element-wise kernel and each batch indicator
+// that uses one, timed at every instruction-set level this CPU supports.
+#include "../src/indicators/VectorKernels.hpp"
+#include "../src/indicators/RSI.hpp"
+#include "../src/indicators/MACD.hpp"
+#include "../src/indicators/BollingerBands.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+template <typename F>
+double bestOfMs(int repeats, F&& f) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best) best = elapsed.count();
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    const size_t n = 4000000;
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<double> prices(n), a(n), b(n), out(n), out2(n);
+    double price = 45000.0;
+    for (size_t i = 0; i < n; ++i) {
+        price += step(rng);
+        prices[i] = price;
+        a[i] = price + 1.0;
+        b[i] = price - 1.0;
+    }
+
+    using Level = VectorKernels::Level;
+    const Level best = VectorKernels::detect();
+    std::printf("elements=%zu detected=%s\n", n, VectorKernels::name(best));
+    std::printf("%-22s %10s %10s %10s\n", "kernel_ms", "scalar", "avx2", "avx512");
+
+    struct Row {
+        const char* name;
+        double ms[3] = {0, 0, 0};
+    };
+    Row rows[] = {{"subtract"}, {"gainLoss"}, {"bands"}, {"percentB"},
+                  {"RSI::calculate"}, {"MACD::calculate"}, {"BollingerBands"}};
+
+    for (Level level : {Level::Scalar, Level::AVX2, Level::AVX512}) {
+        if (level > best) continue;
+        VectorKernels::setLevel(level);
+        int l = static_cast<int>(level);
+        rows[0].ms[l] = bestOfMs(10, [&] { VectorKernels::subtract(a.data(), b.data(), out.data(), n); });
+        rows[1].ms[l] = bestOfMs(10, [&] { VectorKernels::gainLoss(prices.data(), n, out.data(), out2.data()); });
+        rows[2].ms[l] = bestOfMs(10, [&] { VectorKernels::bands(prices.data(), a.data(), 2.0, out.data(), out2.data(), n); });
+        rows[3].ms[l] = bestOfMs(10, [&] { VectorKernels::percentB(prices.data(), a.data(), b.data(), out.data(), n); });
+        rows[4].ms[l] = bestOfMs(5, [&] { RSI::calculate(prices, 14); });
+        rows[5].ms[l] = bestOfMs(5, [&] { MACD::calculate(prices); });
+        rows[6].ms[l] = bestOfMs(5, [&] { BollingerBands::calculate(prices, 20, 2.0); });
+    }
+
+    for (const Row& row : rows) {
+        std::printf("%-22s %10.3f %10.3f %10.3f   best speedup %.2fx\n", row.name,
+                    row.ms[0], row.ms[1], row.ms[2],
+                    row.ms[0] / row.ms[static_cast<int>(best)]);
+    }
+    return 0;
+}
\ No newline at end of file
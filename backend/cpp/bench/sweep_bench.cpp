@@ -0,0 +1,70 @@
+// Parameter-sweep throughput: one RSIStrategy grid backtested with a single
+// worker, with every hardware thread, and with every hardware thread plus a
+// shared IndicatorCache, checking all rankings agree.
+#include "../src/backtesting/ParameterSweep.hpp"
+#include "../src/strategies/RSIStrategy.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+std::vector<Candle> randomCandles(size_t size) {
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<Candle> candles(size);
+    double price = 45000.0;
+    for (size_t i = 0; i < size; ++i) {
+        price += step(rng) * 20.0;
+        candles[i] = {static_cast<std::time_t>(i * 60), price, price, price, price, 1000.0};
+    }
+    return candles;
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main() {
+    const auto candles = randomCandles(100000);
+
+    std::vector<double> periods, oversold, overbought;
+    for (int p = 5; p <= 50; p += 3) periods.push_back(p);
+    for (int o = 15; o <= 40; o += 5) oversold.push_back(o);
+    for (int o = 60; o <= 85; o += 5) overbought.push_back(o);
+    ParameterGrid grid({periods, oversold, overbought});
+
+    RSIStrategy prototype;
+    SweepOptions single;
+    single.threads = 1;
+    SweepOptions all;
+    SweepOptions cached;
+    cached.cache = std::make_shared<IndicatorCache>();
+    cached.seriesId = 1;
+
+    std::vector<ParameterSweep::Result> a, b, c;
+    double singleMs = timeMs([&] { a = ParameterSweep::run(prototype, candles, grid, single); });
+    double allMs = timeMs([&] { b = ParameterSweep::run(prototype, candles, grid, all); });
+    double cachedMs = timeMs([&] { c = ParameterSweep::run(prototype, candles, grid, cached); });
+
+    bool same = a.size() == b.size() && a.size() == c.size();
+    for (size_t i = 0; same && i < a.size(); ++i) {
+        same = a[i].candidate == b[i].candidate && a[i].candidate == c[i].candidate;
+    }
+    auto stats = cached.cache->stats();
+
+    std::printf("bars=%zu candidates=%zu threads=%u\n", candles.size(), grid.size(),
+                ParallelFor::resolveThreads(0, grid.size()));
+    std::printf("single_ms=%.1f parallel_ms=%.1f cached_ms=%.1f speedup=%.1fx cached_speedup=%.1fx ranking_match=%s\n",
+                singleMs, allMs, cachedMs, singleMs / allMs, singleMs / cachedMs, same ? "yes" : "NO");
+    std::printf("cache hits=%llu misses=%llu entries=%zu bytes=%zu\n",
+                static_cast<unsigned long long>(stats.hits),
+                static_cast<unsigned long long>(stats.misses), stats.entries, stats.bytes);
+    return same ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+// Walk-forward optimization of an RSIStrategy grid over a year of 5-minute
+// bars: the WalkForward driver (shared whole-series indicators, windows as
+// index ranges) against copying every window and sweeping it cold.
+#include "../src/backtesting/WalkForward.hpp"
+#include "../src/strategies/RSIStrategy.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+std::vector<Candle> randomCandles(size_t size) {
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<Candle> candles(size);
+    double price = 100.0;
+    for (size_t i = 0; i < size; ++i) {
+        price *= std::exp(step(rng) * 0.002);
+        candles[i] = {static_cast<std::time_t>(1600000000 + i * 300), price, price, price, price, 1000.0};
+    }
+    return candles;
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main() {
+    const auto candles = randomCandles(365 * 288);
+
+    std::vector<double> periods, oversold, overbought;
+    for (int p = 6; p <= 30; p += 6) periods.push_back(p);
+    for (int o = 20; o <= 35; o += 5) oversold.push_back(o);
+    for (int o = 65; o <= 80; o += 5) overbought.push_back(o);
+    ParameterGrid grid({periods, oversold, overbought});
+
+    RSIStrategy prototype;
+    WalkForwardOptions options;
+    options.window = 30 * 86400;
+
+    WalkForward::Result result;
+    double walkMs = timeMs([&] { result = WalkForward::run(prototype, candles, grid, options); });
+
+    // Baseline: copy each in-sample window and optimize it from a cold start.
+    size_t agree = 0;
+    double coldMs = timeMs([&] {
+        SweepOptions sweep;
+        sweep.threads = options.threads;
+        for (const auto& window : result.windows) {
+            std::vector<Candle> inSample(candles.begin() + window.begin, candles.begin() + window.split);
+            auto ranked = ParameterSweep::run(prototype, inSample, grid, sweep);
+            if (ranked.front().candidate == window.candidate) ++agree;
+        }
+    });
+
+    std::printf("bars=%zu candidates=%zu windows=%zu threads=%u\n",
+                candles.size(), grid.size(), result.windows.size(),
+                ParallelFor::resolveThreads(options.threads, grid.size()));
+    std::printf("walk_forward_ms=%.1f cold_window_sweeps_ms=%.1f speedup=%.1fx same_pick_as_cold=%zu/%zu\n",
+                walkMs, coldMs, coldMs / walkMs, agree, result.windows.size());
+    std::printf("oos_return=%.4f oos_max_drawdown=%.4f oos_sharpe=%.3f oos_win_rate=%.3f efficiency=%.3f trades=%zu\n",
+                result.totalReturn, result.maxDrawdown, result.sharpeRatio, result.winRate,
+                result.efficiency, result.trades);
+    return result.windows.empty() ? 1 : 0;
+}
\ No newline at end of file
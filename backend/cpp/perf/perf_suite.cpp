@@ -0,0 +1,346 @@
+// Performance regression suite for the C++ core.
+//
+// Runs every indicator (batch and streaming), every strategy's analyze(),
+// Backtester::run and the bridge's analyze_market_data over synthetic
+// series of each requested size and prints one JSON object per line:
+// ns/bar (median over repetitions), heap allocations and bytes per run,
+// and, where the kernel allows perf_event_open, cycles, instructions and
+// cache misses per bar. Compare two outputs with tools/perf_compare.
+//
+//   perf_suite [--sizes 1000,10000,...] [--filter substring] [--min-ms N]
+//
+// 100M bars need about 6GB for the candle and close arrays.
+#include "../src/backtesting/Backtester.hpp"
+#include "../src/indicators/BollingerBands.hpp"
+#include "../src/indicators/MACD.hpp"
+#include "../src/indicators/MovingAverage.hpp"
+#include "../src/indicators/RSI.hpp"
+#include "../src/strategies/BollingerBandsStrategy.hpp"
+#include "../src/strategies/EnhancedRSIStrategy.hpp"
+#include "../src/strategies/MACDStrategy.hpp"
+#include "../src/strategies/RSIStrategy.hpp"
+#include "../../go/trading/bridge.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifndef PERF_COMMIT
+#define PERF_COMMIT "unknown"
+#endif
+
+namespace {
+
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocatedBytes{0};
+
+// Hardware counters for the calling thread, user space only. Any counter the
+// kernel refuses (no PMU in a VM, perf_event_paranoid, seccomp) is reported
+// as unavailable rather than failing the run.
+class PerfCounters {
+public:
+    enum Event { Cycles, Instructions, CacheMisses, EventCount };
+
+    PerfCounters() {
+#ifdef __linux__
+        const std::uint64_t configs[EventCount] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES
+        };
+        for (int e = 0; e < EventCount; ++e) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[e];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[e] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    bool available(Event e) const { return fds[e] >= 0; }
+    bool any() const { return available(Cycles) || available(Instructions) || available(CacheMisses); }
+
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop(std::uint64_t (&totals)[EventCount]) {
+#ifdef __linux__
+        for (int e = 0; e < EventCount; ++e) {
+            if (fds[e] < 0) continue;
+            ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0);
+            std::uint64_t value = 0;
+            if (read(fds[e], &value, sizeof(value)) == sizeof(value)) totals[e] += value;
+        }
+#else
+        (void)totals;
+#endif
+    }
+
+private:
+    int fds[EventCount] = {-1, -1, -1};
+};
+
+struct Options {
+    std::vector<size_t> sizes{1000, 10000, 100000, 1000000, 10000000};
+    std::string filter;
+    double minMs = 200.0;  // per case, before the repetition cap
+};
+
+struct Series {
+    std::vector<Candle> candles;
+    std::vector<double> closes;
+    CandleColumns columns;
+};
+
+Series syntheticSeries(size_t bars) {
+    Series series;
+    series.candles.resize(bars);
+    series.closes.resize(bars);
+    std::mt19937_64 rng(bars);
+    std::normal_distribution<double> step(0.0, 1.0);
+    double price = 100.0;
+    for (size_t i = 0; i < bars; ++i) {
+        double open = price;
+        price *= std::exp(step(rng) * 0.002);
+        double spread = std::abs(step(rng)) * 0.001 * price;
+        series.candles[i] = {static_cast<std::time_t>(1600000000 + 60 * i), open,
+                             std::max(open, price) + spread, std::min(open, price) - spread, price,
+                             1000.0 + static_cast<double>(rng() % 1000)};
+        series.closes[i] = price;
+    }
+    series.columns = CandleColumns::fromCandles(series.candles.data(), series.candles.size());
+    return series;
+}
+
+// Keeps results observable so the optimizer cannot drop a benchmark body.
+volatile double sink;
+
+class Suite {
+public:
+    explicit Suite(const Options& options) : options(options) {}
+
+    void meta() {
+        std::printf("{\"type\":\"meta\",\"commit\":\"%s\",\"compiler\":\"%s\",\"hardware_threads\":%u,"
+                    "\"perf_events\":%s,\"cycles\":%s,\"instructions\":%s,\"cache_misses\":%s}\n",
+                    PERF_COMMIT, __VERSION__, std::thread::hardware_concurrency(),
+                    counters.any() ? "true" : "false",
+                    counters.available(PerfCounters::Cycles) ? "true" : "false",
+                    counters.available(PerfCounters::Instructions) ? "true" : "false",
+                    counters.available(PerfCounters::CacheMisses) ? "true" : "false");
+        std::fflush(stdout);
+    }
+
+    // Runs body() repeatedly (at least 3 times, until minMs has passed or the
+    // cap is hit) after one untimed warm-up run, and prints the case line.
+    void measure(const char* name, size_t bars, const std::function<void()>& body) {
+        if (!options.filter.empty() && std::string(name).find(options.filter) == std::string::npos) return;
+
+        body();
+
+        std::vector<double> samples;
+        std::uint64_t totals[PerfCounters::EventCount] = {0, 0, 0};
+        size_t allocationsBefore = allocationCount.load();
+        size_t bytesBefore = allocatedBytes.load();
+        double elapsedMs = 0.0;
+        const size_t cap = std::max<size_t>(3, 200000000 / std::max<size_t>(bars, 1));
+        while (samples.size() < 3 || (elapsedMs < options.minMs && samples.size() < cap)) {
+            counters.start();
+            auto begin = std::chrono::steady_clock::now();
+            body();
+            auto end = std::chrono::steady_clock::now();
+            counters.stop(totals);
+            std::chrono::duration<double, std::milli> ms = end - begin;
+            elapsedMs += ms.count();
+            samples.push_back(ms.count() * 1e6 / bars);
+        }
+        size_t reps = samples.size();
+        double allocations = static_cast<double>(allocationCount.load() - allocationsBefore) / reps;
+        double bytes = static_cast<double>(allocatedBytes.load() - bytesBefore) / reps;
+
+        std::sort(samples.begin(), samples.end());
+        double median = samples[reps / 2];
+        double perBar = 1.0 / (static_cast<double>(reps) * bars);
+        std::printf("{\"type\":\"case\",\"bench\":\"%s\",\"bars\":%zu,\"reps\":%zu,"
+                    "\"ns_per_bar\":%.4f,\"ns_per_bar_min\":%.4f,\"ns_per_bar_max\":%.4f,"
+                    "\"allocations_per_run\":%.1f,\"bytes_allocated_per_run\":%.0f,"
+                    "\"cycles_per_bar\":%s,\"instructions_per_bar\":%s,\"cache_misses_per_bar\":%s}\n",
+                    name, bars, reps, median, samples.front(), samples.back(), allocations, bytes,
+                    counter(PerfCounters::Cycles, totals, perBar).c_str(),
+                    counter(PerfCounters::Instructions, totals, perBar).c_str(),
+                    counter(PerfCounters::CacheMisses, totals, perBar).c_str());
+        std::fflush(stdout);
+    }
+
+private:
+    const Options& options;
+    PerfCounters counters;
+
+    std::string counter(PerfCounters::Event e, const std::uint64_t (&totals)[PerfCounters::EventCount],
+                        double perBar) const {
+        if (!counters.available(e)) return "null";
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.4f", totals[e] * perBar);
+        return text;
+    }
+};
+
+template <typename S>
+void strategyCase(Suite& suite, const char* name, const Series& series) {
+    S strategy;
+    suite.measure(name, series.columns.size, [&] {
+        sink = static_cast<double>(strategy.analyze(series.columns).size());
+    });
+}
+
+void runSize(Suite& suite, size_t bars) {
+    Series series = syntheticSeries(bars);
+    const double* closes = series.closes.data();
+
+    suite.measure("indicator.rsi.batch", bars, [&] { sink = RSI::calculate(closes, bars, 14).back(); });
+    suite.measure("indicator.ema.batch", bars, [&] {
+        sink = MovingAverage::calculateEMA(closes, bars, 20).back();
+    });
+    suite.measure("indicator.macd.batch", bars, [&] { sink = MACD::calculate(closes, bars).histogram.back(); });
+    suite.measure("indicator.bollinger.batch", bars, [&] {
+        sink = BollingerBands::calculate(closes, bars).upper.back();
+    });
+
+    suite.measure("indicator.rsi.stream", bars, [&] {
+        RSIStream rsi(14);
+        for (size_t i = 0; i < bars; ++i) rsi.update(closes[i]);
+        sink = rsi.value();
+    });
+    suite.measure("indicator.ema.stream", bars, [&] {
+        EMAStream ema(20);
+        for (size_t i = 0; i < bars; ++i) ema.update(closes[i]);
+        sink = ema.value();
+    });
+    suite.measure("indicator.sma.stream", bars, [&] {
+        SMAStream sma(20);
+        for (size_t i = 0; i < bars; ++i) sma.update(closes[i]);
+        sink = sma.value();
+    });
+    suite.measure("indicator.macd.stream", bars, [&] {
+        MACDStream macd;
+        for (size_t i = 0; i < bars; ++i) macd.update(closes[i]);
+        sink = macd.value().histogram;
+    });
+    suite.measure("indicator.bollinger.stream", bars, [&] {
+        BollingerBandsStream bands;
+        for (size_t i = 0; i < bars; ++i) bands.update(closes[i]);
+        sink = bands.value().upper;
+    });
+
+    strategyCase<RSIStrategy>(suite, "strategy.rsi.analyze", series);
+    strategyCase<MACDStrategy>(suite, "strategy.macd.analyze", series);
+    strategyCase<BollingerBandsStrategy>(suite, "strategy.bollinger.analyze", series);
+    strategyCase<EnhancedRSIStrategy>(suite, "strategy.enhanced_rsi.analyze", series);
+
+    Backtester backtester(100000.0, 0.001);
+    backtester.setStrategy(std::make_shared<RSIStrategy>());
+    Backtester::BacktestResult result;
+    suite.measure("backtester.run", bars, [&] {
+        backtester.run(series.columns, 0, bars, result);
+        sink = result.finalBalance;
+    });
+
+    if (bars <= static_cast<size_t>(INT32_MAX)) {
+        void* strategy = create_rsi_strategy(14, 30, 70);
+        suite.measure("bridge.analyze_market_data", bars, [&] {
+            TradeSignal* signal = analyze_market_data(strategy, series.closes.data(), static_cast<int>(bars));
+            sink = signal ? signal->price : 0.0;
+            free_trade_signal(signal);
+        });
+        destroy_strategy(strategy);
+    }
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--sizes") {
+            options.sizes.clear();
+            size_t start = 0;
+            while (start <= value.size()) {
+                size_t comma = value.find(',', start);
+                if (comma == std::string::npos) comma = value.size();
+                size_t size = std::strtoull(value.substr(start, comma - start).c_str(), nullptr, 10);
+                if (size == 0) return false;
+                options.sizes.push_back(size);
+                start = comma + 1;
+            }
+        } else if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--min-ms") {
+            options.minMs = std::strtod(value.c_str(), nullptr);
+        } else {
+            return false;
+        }
+    }
+    return !options.sizes.empty();
+}
+
+} // namespace
+
+// GCC flags the replaced pair as mismatched once both are inlined into the
+// same translation unit; they are a matching malloc/free pair.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--sizes 1000,10000,...] [--filter substring] [--min-ms N]\n", argv[0]);
+        return 2;
+    }
+
+    Suite suite(options);
+    suite.meta();
+    for (size_t bars : options.sizes) runSize(suite, bars);
+    return 0;
+}
\ No newline at end of file
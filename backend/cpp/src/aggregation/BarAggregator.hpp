@@ -0,0 +1,130 @@
+#pragma once
+#include <algorithm>
+#include <ctime>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../models/Candle.hpp"
+#include "../models/CandleColumns.hpp"
+#include "../models/Tick.hpp"
+
+// Builds Candles for several timeframes at once from a stream of ticks or of
+// finer bars, in one pass. Bars are aligned to multiples of their timeframe
+// since the epoch and stamped with their open time; a bar is emitted when
+// the first input of a later bucket arrives, and buckets without input
+// produce no bar. Each input costs one comparison per timeframe unless it
+// opens a new bucket.
+//
+// Inputs are expected in timestamp order. A late input that falls before
+// the open bar's bucket is folded into the open bar rather than reopening a
+// bar that has already been emitted.
+class BarAggregator {
+private:
+    struct Frame {
+        std::time_t seconds;
+        std::time_t end = 0;  // first timestamp past the open bar
+        bool open = false;
+        Candle bar{};
+    };
+
+    std::vector<Frame> frames;
+
+public:
+    // `timeframes` are bar lengths in seconds, e.g. {1, 60, 300, 3600}.
+    explicit BarAggregator(const std::vector<std::time_t>& timeframes) {
+        if (timeframes.empty()) throw std::invalid_argument("BarAggregator needs at least one timeframe");
+        for (std::time_t seconds : timeframes) {
+            if (seconds <= 0) throw std::invalid_argument("BarAggregator timeframes must be positive");
+            frames.push_back(Frame{seconds});
+        }
+    }
+
+    size_t timeframes() const { return frames.size(); }
+    std::time_t timeframe(size_t index) const { return frames[index].seconds; }
+
+    // Folds one tick into every timeframe. emit(index, bar) is called for
+    // each bar the tick closes, where `index` is the timeframe's position in
+    // the constructor's list.
+    template <typename Emit>
+    void add(const Tick& tick, Emit&& emit) {
+        add(Candle{tick.timestamp, tick.price, tick.price, tick.price, tick.price, tick.volume},
+            std::forward<Emit>(emit));
+    }
+
+    // Folds one finer bar into every timeframe, as for a tick: its open
+    // opens, its high and low widen the range, and its volume adds up. The
+    // input's bars must nest in every timeframe, e.g. minute bars into 5m/1h.
+    template <typename Emit>
+    void add(const Candle& candle, Emit&& emit) {
+        for (size_t i = 0; i < frames.size(); ++i) {
+            Frame& frame = frames[i];
+            if (frame.open && candle.timestamp < frame.end) {
+                frame.bar.high = std::max(frame.bar.high, candle.high);
+                frame.bar.low = std::min(frame.bar.low, candle.low);
+                frame.bar.close = candle.close;
+                frame.bar.volume += candle.volume;
+                continue;
+            }
+            if (frame.open) emit(i, static_cast<const Candle&>(frame.bar));
+
+            std::time_t start = bucketStart(candle.timestamp, frame.seconds);
+            frame.bar = Candle{start, candle.open, candle.high, candle.low, candle.close, candle.volume};
+            frame.end = start + frame.seconds;
+            frame.open = true;
+        }
+    }
+
+    // Emits every bar still open, e.g. at the end of a session or replay,
+    // and starts each timeframe afresh.
+    template <typename Emit>
+    void flush(Emit&& emit) {
+        for (size_t i = 0; i < frames.size(); ++i) {
+            if (frames[i].open) emit(i, static_cast<const Candle&>(frames[i].bar));
+            frames[i].open = false;
+        }
+    }
+
+    // The bar being built for timeframe `index`, if any input has arrived.
+    const Candle* partial(size_t index) const {
+        return frames[index].open ? &frames[index].bar : nullptr;
+    }
+
+    void reset() {
+        for (Frame& frame : frames) frame.open = false;
+    }
+
+    // Rolls an existing series up into each of `timeframes`, one output
+    // series per timeframe, in a single pass over `bars`.
+    static std::vector<std::vector<Candle>> resample(const CandleColumns& bars,
+                                                     const std::vector<std::time_t>& timeframes) {
+        BarAggregator aggregator(timeframes);
+        std::vector<std::vector<Candle>> out(timeframes.size());
+        if (bars.size > 1) {
+            std::time_t span = bars.timestampAt(bars.size - 1) - bars.timestampAt(0);
+            for (size_t i = 0; i < timeframes.size(); ++i) {
+                out[i].reserve(std::min(bars.size, static_cast<size_t>(span / timeframes[i]) + 1));
+            }
+        }
+        auto collect = [&out](size_t index, const Candle& bar) { out[index].push_back(bar); };
+        for (size_t i = 0; i < bars.size; ++i) aggregator.add(bars[i], collect);
+        aggregator.flush(collect);
+        return out;
+    }
+
+    static std::vector<Candle> resample(const CandleColumns& bars, std::time_t timeframe) {
+        return std::move(resample(bars, std::vector<std::time_t>{timeframe})[0]);
+    }
+
+    static std::vector<Candle> resample(const std::vector<Candle>& bars, std::time_t timeframe) {
+        return resample(CandleColumns::fromCandles(bars.data(), bars.size()), timeframe);
+    }
+
+private:
+    // Start of the timeframe bucket holding `t`, rounding down for times
+    // before the epoch too.
+    static std::time_t bucketStart(std::time_t t, std::time_t seconds) {
+        std::time_t offset = t % seconds;
+        if (offset < 0) offset += seconds;
+        return t - offset;
+    }
+};
\ No newline at end of file
@@ -1,90 +1,299 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <optional>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
 #include "../strategies/Strategy.hpp"
 #include "../models/Trade.hpp"
 #include "../models/Candle.hpp"
+#include "../models/CandleColumns.hpp"
+#include "PositionBook.hpp"
+#include "ExecutionSimulator.hpp"
+#include "../storage/Journal.hpp"
 
+// Cost of a fill: rate * notional + perFill, but never less than minimum.
+struct CommissionModel {
+    double rate = 0.0;
+    double perFill = 0.0;
+    double minimum = 0.0;
+
+    double operator()(double notional) const {
+        return std::max(rate * notional + perFill, minimum);
+    }
+};
+
+// Adverse price move applied to every fill: buys pay price * (1 + rate) +
+// perUnit, sells receive price * (1 - rate) - perUnit.
+struct SlippageModel {
+    double rate = 0.0;
+    double perUnit = 0.0;
+
+    double fillPrice(double price, TradeType type) const {
+        return type == TradeType::Buy ? price * (1.0 + rate) + perUnit
+                                      : price * (1.0 - rate) - perUnit;
+    }
+};
+
+// Bar-by-bar simulator over a signed position. Signals are filled at their
+// price adjusted for slippage, the account is marked to market on every
+// close, and fills are matched against the open position at average cost so
+// each round trip (flat -> position -> flat) carries its own net PnL.
+//
+// Signals are taken without a cash or margin check, so equity can reach
+// zero. When it does at a close the account is ruined: the position is
+// liquidated at that close, working orders are cancelled and the rest of
+// the run stays flat. A shortfall the liquidation leaves is not carried:
+// the account ends at zero, a -100% return with a 100% drawdown. The
+// statistics cover the bars up to and including the ruin.
 class Backtester {
 private:
     double initialBalance;
-    double commission;
+    CommissionModel commission;
+    SlippageModel slippage;
+    double periodsPerYear = 0.0;
     std::shared_ptr<Strategy> strategy;
+    std::optional<ExecutionSimulator> execution;
+    std::shared_ptr<Journal> journal;
+    std::uint32_t journalStream = 0;
+    std::vector<double> equity;  // reused across runs, one slot per bar
 
 public:
     Backtester(double balance = 10000.0, double comm = 0.001) 
-        : initialBalance(balance), commission(comm) {}
+        : initialBalance(balance) {
+        commission.rate = comm;
+    }
 
     void setStrategy(std::shared_ptr<Strategy> strat) {
         strategy = strat;
     }
 
+    Strategy* getStrategy() const {
+        return strategy.get();
+    }
+
+    void setCommission(const CommissionModel& model) {
+        commission = model;
+    }
+
+    void setSlippage(const SlippageModel& model) {
+        slippage = model;
+    }
+
+    // Bars per year used to annualise Sharpe and Sortino; 0 infers it from
+    // the average bar spacing of each run.
+    void setPeriodsPerYear(double periods) {
+        periodsPerYear = periods;
+    }
+
+    // Routes signals through an ExecutionSimulator instead of filling each
+    // at its price on its own bar: a signal becomes an order of
+    // options.signalOrder type, sent when its bar closes (the next bar's
+    // timestamp), and fills from later bars' prices and volume. Slippage
+    // and commission still apply to every fill.
+    void setExecution(const ExecutionOptions& options) {
+        execution.emplace(options);
+    }
+
+    void clearExecution() {
+        execution.reset();
+    }
+
+    // Records every bar, signal and fill of later runs to `target` under
+    // `stream`; pass nullptr to stop. Appending never blocks, so a journal
+    // shared by many backtesters costs each of them a queue push per record.
+    void setJournal(std::shared_ptr<Journal> target, std::uint32_t stream = 0) {
+        journal = std::move(target);
+        journalStream = stream;
+    }
+
+    using RoundTrip = ::RoundTrip;
+
     struct BacktestResult {
-        double finalBalance;
-        std::vector<Trade> trades;
+        double finalBalance;  // cash plus the open position at the last close
+        std::vector<Trade> trades;  // executed fills, at fill price
         double maxDrawdown;
         double sharpeRatio;
-        double winRate;
+        double winRate;       // share of round trips with positive PnL
+        double sortinoRatio;
+        double totalReturn;
+        double totalCommission;
+        double totalSlippage;
+        double finalPosition;
+        std::vector<RoundTrip> roundTrips;
+        size_t openOrders;    // orders still working at the end (with an execution model)
+        bool ruined;          // equity reached zero and the account was liquidated
+        size_t ruinedAt;      // bar of the traded range it happened on; the range size if never
     };
 
     BacktestResult run(const std::vector<Candle>& candles) {
+        return run(candles.data(), candles.size());
+    }
+
+    BacktestResult run(const Candle* candles, size_t size) {
+        return run(CandleColumns::fromCandles(candles, size));
+    }
+
+    // Runs directly over columnar data, e.g. a mapped CandleStore range.
+    // Nothing is allocated per bar beyond amortised growth of the fill and
+    // round-trip lists; the equity curve lives in a buffer kept between runs.
+    BacktestResult run(const CandleColumns& candles) {
+        return run(candles, 0, candles.size);
+    }
+
+    // Trades only bars [from, to) of `series`, starting flat with the
+    // initial balance, while the strategy's indicators see the bars before
+    // `from` as history (see Strategy::begin). The equity curve covers the
+    // traded range.
+    BacktestResult run(const CandleColumns& series, size_t from, size_t to) {
+        BacktestResult result{};
+        run(series, from, to, result);
+        return result;
+    }
+
+    // As above, but fills `result` in place: its fill and round-trip lists
+    // are cleared and keep their capacity, so a caller reusing one result
+    // across runs (as the sweeps do per worker) allocates nothing once the
+    // lists have grown to the largest run.
+    void run(const CandleColumns& series, size_t from, size_t to, BacktestResult& result) {
         if (!strategy) throw std::runtime_error("No strategy set");
+        to = std::min(to, series.size);
+        from = std::min(from, to);
+        CandleColumns candles = series.slice(from, to);
+
+        result.trades.clear();
+        result.roundTrips.clear();
+        std::vector<Trade> trades = std::move(result.trades);
+        std::vector<RoundTrip> roundTrips = std::move(result.roundTrips);
+        result = BacktestResult{};
+        result.trades = std::move(trades);
+        result.roundTrips = std::move(roundTrips);
+
+        double cash = initialBalance;
+        PositionBook book;
+        equity.resize(candles.size);
+
+        double peak = initialBalance;
+        double previousEquity = initialBalance;
+        size_t count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+        double downside = 0.0;
+
+        if (execution) execution->reset();
+        auto onFill = [&](const ExecutionSimulator::Fill& executed) {
+            fill(executed.trade, cash, book, result);
+        };
+
+        strategy->begin(series, from, to);
+        for (size_t i = 0; i < candles.size; ++i) {
+            Candle candle = candles[i];
+            if (journal) journal->append(journalStream, candle);
+            if (execution) execution->onBar(candle, onFill);
+            if (auto signal = strategy->onCandle(candle)) {
+                if (journal) journal->append(journalStream, JournalKind::Signal, *signal);
+                if (execution) {
+                    std::time_t closed = i + 1 < candles.size ? candles.timestampAt(i + 1) : candle.timestamp;
+                    send(*signal, closed);
+                } else {
+                    fill(*signal, cash, book, result);
+                }
+            }
 
-        double balance = initialBalance;
-        double maxBalance = balance;
-        double maxDrawdown = 0.0;
-        std::vector<Trade> trades = strategy->analyze(candles);
-        int wins = 0;
-
-        for (const auto& trade : trades) {
-            double cost = trade.price * trade.amount;
-            double commissionCost = cost * commission;
-            
-            if (trade.type == "BUY") {
-                balance -= (cost + commissionCost);
-            } else {
-                balance += (cost - commissionCost);
-                if (balance > maxBalance) maxBalance = balance;
+            double value = cash + book.position() * candle.close;
+            if (!(value > 0.0)) {
+                result.ruined = true;
+                result.ruinedAt = i;
+                if (book.position() != 0.0) {
+                    TradeType side = book.position() > 0.0 ? TradeType::Sell : TradeType::Buy;
+                    fill(Trade{side, candle.timestamp, candle.close, std::abs(book.position()), TradeReason::None},
+                         cash, book, result);
+                }
+                if (execution) execution->reset();
+                value = std::max(cash, 0.0);
             }
+            equity[i] = value;
+
+            if (value > peak) peak = value;
+            if (peak > 0.0) result.maxDrawdown = std::max(result.maxDrawdown, std::min((peak - value) / peak, 1.0));
 
-            double drawdown = (maxBalance - balance) / maxBalance;
-            if (drawdown > maxDrawdown) maxDrawdown = drawdown;
+            double ret = previousEquity > 0.0 ? std::max(value / previousEquity - 1.0, -1.0) : 0.0;
+            previousEquity = value;
+            ++count;
+            double delta = ret - mean;
+            mean += delta / count;
+            m2 += delta * (ret - mean);
+            if (ret < 0.0) downside += ret * ret;
 
-            if (balance > initialBalance) wins++;
+            if (result.ruined) {
+                std::fill(equity.begin() + i + 1, equity.begin() + candles.size, value);
+                break;
+            }
         }
+        if (!result.ruined) result.ruinedAt = candles.size;
+        strategy->finish();
 
-        return {
-            balance,
-            trades,
-            maxDrawdown,
-            calculateSharpeRatio(trades),
-            static_cast<double>(wins) / trades.size()
-        };
+        double scale = std::sqrt(annualisation(candles));
+        double deviation = count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0;
+        double downsideDeviation = count > 0 ? std::sqrt(downside / count) : 0.0;
+
+        size_t wins = 0;
+        for (const auto& trip : result.roundTrips) {
+            if (trip.pnl > 0.0) ++wins;
+        }
+
+        result.finalBalance = previousEquity;
+        result.totalReturn = initialBalance != 0.0 ? previousEquity / initialBalance - 1.0 : 0.0;
+        result.sharpeRatio = deviation > 0.0 ? mean / deviation * scale : 0.0;
+        result.sortinoRatio = downsideDeviation > 0.0 ? mean / downsideDeviation * scale : 0.0;
+        result.winRate = result.roundTrips.empty()
+            ? 0.0 : static_cast<double>(wins) / result.roundTrips.size();
+        result.finalPosition = book.position();
+        result.openOrders = execution ? execution->pending() : 0;
+    }
+
+    // Mark-to-market equity after each bar of the last run.
+    const std::vector<double>& equityCurve() const {
+        return equity;
     }
 
 private:
-    double calculateSharpeRatio(const std::vector<Trade>& trades) {
-        // Simplified Sharpe ratio calculation
-        if (trades.empty()) return 0.0;
-        
-        std::vector<double> returns;
-        double sum = 0.0;
-        
-        for (const auto& trade : trades) {
-            double ret = (trade.type == "SELL" ? 1.0 : -1.0) * 
-                        (trade.price * trade.amount * (1.0 - commission));
-            returns.push_back(ret);
-            sum += ret;
-        }
-        
-        double mean = sum / returns.size();
-        double variance = 0.0;
-        
-        for (double ret : returns) {
-            variance += (ret - mean) * (ret - mean);
-        }
-        
-        variance /= returns.size();
-        return mean / std::sqrt(variance);
+    void fill(Trade trade, double& cash, PositionBook& book, BacktestResult& result) {
+        if (!(trade.amount > 0.0)) return;
+
+        double price = slippage.fillPrice(trade.price, trade.type);
+        double fee = commission(price * trade.amount);
+        double sign = trade.type == TradeType::Buy ? 1.0 : -1.0;
+
+        cash -= sign * price * trade.amount + fee;
+        result.totalCommission += fee;
+        result.totalSlippage += std::abs(price - trade.price) * trade.amount;
+        book.fill(trade.type, trade.amount, price, fee, trade.timestamp, result.roundTrips);
+
+        trade.price = price;
+        result.trades.push_back(trade);
+        if (journal) journal->append(journalStream, JournalKind::Fill, trade);
+    }
+
+    // Limit orders are placed signalOffset better than the signal price and
+    // stops the same distance worse, so a limit buy waits for a dip and a
+    // stop buy for a breakout.
+    void send(const Trade& signal, std::time_t sentAt) {
+        if (!(signal.amount > 0.0)) return;
+        const ExecutionOptions& options = execution->getOptions();
+        double offset = options.signalOffset;
+        if (options.signalOrder == OrderType::Stop) offset = -offset;
+        double price = signal.type == TradeType::Buy ? signal.price * (1.0 - offset)
+                                                     : signal.price * (1.0 + offset);
+        execution->submit(signal.type, options.signalOrder, price, signal.amount, sentAt, signal.reason);
+    }
+
+    double annualisation(const CandleColumns& candles) const {
+        if (periodsPerYear > 0.0) return periodsPerYear;
+        if (candles.size < 2) return 1.0;
+        double span = static_cast<double>(candles.timestampAt(candles.size - 1) - candles.timestampAt(0));
+        if (span <= 0.0) return 1.0;
+        return 365.25 * 86400.0 * (candles.size - 1) / span;
     }
 };
\ No newline at end of file
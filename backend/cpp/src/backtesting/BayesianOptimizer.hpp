@@ -0,0 +1,267 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "Backtester.hpp"
+#include "ParameterSweep.hpp"
+#include "../strategies/Strategy.hpp"
+#include "../indicators/IndicatorCache.hpp"
+#include "../utils/CounterRng.hpp"
+#include "../utils/GaussianProcess.hpp"
+#include "../utils/ParallelFor.hpp"
+
+// Search range of one strategy parameter; integer parameters (periods) are
+// rounded so the optimizer never spends a backtest on an equivalent point.
+struct ParameterRange {
+    double min;
+    double max;
+    bool integer = false;
+};
+
+struct BayesianOptions {
+    size_t initialPoints = 8;    // random parameter sets evaluated before the model takes over
+    size_t iterations = 40;      // model-guided evaluations after them
+    size_t candidates = 2048;    // points scored by the acquisition function per iteration
+    double exploration = 0.01;   // expected-improvement margin, in units of the initial score spread
+    double lengthScale = 0.2;    // kernel length scale, with every range rescaled to [0, 1]
+    std::uint64_t seed = 0;
+    unsigned threads = 0;        // 0 = all hardware threads
+    double initialBalance = 10000.0;
+    double commission = 0.001;
+    std::function<double(const Backtester::BacktestResult&)> objective;  // defaults to Sharpe ratio
+    std::shared_ptr<IndicatorCache> cache;  // optional; a private cache is used otherwise
+    std::uint64_t seriesId = 0;             // cache id of the candles
+};
+
+// Bayesian optimization of a strategy's parameters against the Backtester.
+//
+// A Gaussian process over the parameter space is fitted to every score seen
+// so far; each iteration scores a batch of candidate points by expected
+// improvement over the best score, in parallel, and backtests the most
+// promising one. The process is updated incrementally, so an iteration
+// costs O(n^2) in the number of evaluations rather than a refit. The whole
+// loop runs natively: nothing crosses the bridge between evaluations.
+//
+// Candidates are three parts uniform draws over the ranges and one part
+// local perturbations of the best point. Draw c of iteration t uses its own
+// RNG stream, so results depend on the seed but not the thread count.
+class BayesianOptimizer {
+public:
+    using Options = BayesianOptions;
+    using Objective = std::function<double(const Backtester::BacktestResult&)>;
+
+    struct Evaluation {
+        std::vector<double> params;
+        double score;
+        double predictedMean;        // model prediction before the backtest; NaN for initial points
+        double predictedSd;
+        double expectedImprovement;
+    };
+
+    struct Result {
+        std::vector<Evaluation> evaluations;  // in evaluation order
+        size_t best;                          // index of the highest score
+        size_t tradeCount;                    // fills of the best parameters
+        Backtester::BacktestResult backtest;  // of the best parameters, without fill lists
+    };
+
+    static Result run(const Strategy& prototype,
+                      const CandleColumns& candles,
+                      const std::vector<ParameterRange>& ranges,
+                      const Options& options = Options()) {
+        validate(ranges, options);
+        size_t expected = prototype.parameterCount();
+        if (expected != 0 && ranges.size() != expected) {
+            throw std::invalid_argument(prototype.getName() + " takes " + std::to_string(expected) +
+                                        " parameters, got " + std::to_string(ranges.size()) + " ranges");
+        }
+        size_t dims = ranges.size();
+
+        std::shared_ptr<IndicatorCache> cache = options.cache;
+        std::uint64_t seriesId = options.seriesId;
+        if (!cache) {
+            cache = std::make_shared<IndicatorCache>();
+            seriesId = 0;
+        }
+
+        unsigned workers = ParallelFor::resolveThreads(options.threads, options.initialPoints);
+        std::vector<Backtester> backtesters;
+        backtesters.reserve(workers);
+        for (unsigned w = 0; w < workers; ++w) {
+            backtesters.emplace_back(options.initialBalance, options.commission);
+            std::shared_ptr<Strategy> strategy = prototype.clone();
+            strategy->attachCache(cache, seriesId);
+            backtesters.back().setStrategy(std::move(strategy));
+        }
+        std::vector<Backtester::BacktestResult> scratch(workers);
+
+        const Objective& objective = options.objective
+            ? options.objective : Objective(ParameterSweep::sharpeObjective);
+        auto evaluate = [&](unsigned worker, const std::vector<double>& params) {
+            backtesters[worker].getStrategy()->updateParameters(params);
+            backtesters[worker].run(candles, 0, candles.size, scratch[worker]);
+            return objective(scratch[worker]);
+        };
+
+        Result result{};
+        size_t total = options.initialPoints + options.iterations;
+        result.evaluations.resize(options.initialPoints);
+        std::vector<std::vector<double>> units(total, std::vector<double>(dims));
+
+        // Initial design: independent uniform draws, backtested in parallel.
+        ParallelFor::run(options.initialPoints, workers, [&](size_t i, unsigned worker) {
+            CounterRng rng(options.seed, i);
+            for (size_t d = 0; d < dims; ++d) units[i][d] = rng.uniform();
+            Evaluation& evaluation = result.evaluations[i];
+            evaluation.params = toParams(ranges, units[i]);
+            evaluation.score = evaluate(worker, evaluation.params);
+            evaluation.predictedMean = NAN;
+            evaluation.predictedSd = NAN;
+            evaluation.expectedImprovement = NAN;
+        });
+
+        // Scores are standardised by the initial design's spread so the
+        // kernel's unit signal variance fits any objective. Failed runs
+        // (NaN or infinite scores) enter the model one spread below the
+        // worst score seen and never become the incumbent.
+        double offset = 0.0;
+        double spread = 0.0;
+        size_t finite = 0;
+        for (const auto& evaluation : result.evaluations) {
+            if (!std::isfinite(evaluation.score)) continue;
+            ++finite;
+            double delta = evaluation.score - offset;
+            offset += delta / finite;
+            spread += delta * (evaluation.score - offset);
+        }
+        spread = finite > 1 ? std::sqrt(spread / (finite - 1)) : 0.0;
+        if (!(spread > 0.0)) spread = 1.0;
+
+        GaussianProcess model(dims, options.lengthScale, 1.0, 1e-6);
+        double worst = INFINITY;
+        double incumbent = -INFINITY;  // best standardised score
+        size_t best = 0;
+        auto observe = [&](size_t i) {
+            double score = result.evaluations[i].score;
+            bool valid = std::isfinite(score);
+            double value = valid ? (score - offset) / spread : std::min(worst, 0.0) - 1.0;
+            worst = std::min(worst, value);
+            model.add(units[i], value);
+            if (valid && value > incumbent) {
+                incumbent = value;
+                best = i;
+            }
+        };
+        for (size_t i = 0; i < options.initialPoints; ++i) observe(i);
+
+        std::vector<double> points(options.candidates * dims);
+        std::vector<GaussianProcess::Prediction> predictions(options.candidates);
+        std::vector<double> improvement(options.candidates);
+        unsigned scorers = ParallelFor::resolveThreads(options.threads, options.candidates);
+
+        for (size_t t = 0; t < options.iterations; ++t) {
+            const std::vector<double>& centre = units[best];
+            double target = std::isfinite(incumbent) ? incumbent : worst;
+            std::uint64_t stream = options.initialPoints + t * options.candidates;
+            ParallelFor::run(options.candidates, scorers, [&](size_t c, unsigned) {
+                CounterRng rng(options.seed, stream + c);
+                double* point = points.data() + c * dims;
+                bool local = c % 4 == 3;
+                for (size_t d = 0; d < dims; ++d) {
+                    double u = rng.uniform();
+                    point[d] = local ? std::clamp(centre[d] + (u - 0.5) * options.lengthScale, 0.0, 1.0) : u;
+                }
+                snap(ranges, point);
+                predictions[c] = model.predict(point);
+                improvement[c] = expectedImprovement(predictions[c].mean, predictions[c].sd,
+                                                     target, options.exploration);
+            });
+
+            size_t pick = static_cast<size_t>(std::max_element(improvement.begin(), improvement.end()) -
+                                              improvement.begin());
+            size_t i = result.evaluations.size();
+            units[i].assign(points.begin() + pick * dims, points.begin() + (pick + 1) * dims);
+
+            Evaluation evaluation;
+            evaluation.params = toParams(ranges, units[i]);
+            evaluation.score = evaluate(0, evaluation.params);
+            evaluation.predictedMean = predictions[pick].mean * spread + offset;
+            evaluation.predictedSd = predictions[pick].sd * spread;
+            evaluation.expectedImprovement = improvement[pick] * spread;
+            result.evaluations.push_back(std::move(evaluation));
+            observe(i);
+        }
+
+        result.best = best;
+        backtesters[0].getStrategy()->updateParameters(result.evaluations[result.best].params);
+        backtesters[0].run(candles, 0, candles.size, result.backtest);
+        result.tradeCount = result.backtest.trades.size();
+        result.backtest.trades = {};
+        result.backtest.roundTrips = {};
+        return result;
+    }
+
+    static Result run(const Strategy& prototype,
+                      const Candle* candles, size_t size,
+                      const std::vector<ParameterRange>& ranges,
+                      const Options& options = Options()) {
+        return run(prototype, CandleColumns::fromCandles(candles, size), ranges, options);
+    }
+
+    static Result run(const Strategy& prototype,
+                      const std::vector<Candle>& candles,
+                      const std::vector<ParameterRange>& ranges,
+                      const Options& options = Options()) {
+        return run(prototype, candles.data(), candles.size(), ranges, options);
+    }
+
+    // Expected amount by which a normal(mean, sd) score beats `best` by
+    // more than `margin`.
+    static double expectedImprovement(double mean, double sd, double best, double margin) {
+        double gain = mean - best - margin;
+        if (!(sd > 0.0)) return std::max(gain, 0.0);
+        double z = gain / sd;
+        double cdf = 0.5 * std::erfc(-z / std::sqrt(2.0));
+        double pdf = std::exp(-0.5 * z * z) * 0.3989422804014327;  // 1 / sqrt(2 pi)
+        return gain * cdf + sd * pdf;
+    }
+
+private:
+    static void validate(const std::vector<ParameterRange>& ranges, const Options& options) {
+        if (ranges.empty()) throw std::invalid_argument("Bayesian optimization needs at least one parameter");
+        for (const auto& range : ranges) {
+            if (!(range.min <= range.max)) throw std::invalid_argument("Parameter range must have min <= max");
+        }
+        if (options.initialPoints == 0 || (options.iterations > 0 && options.candidates == 0)) {
+            throw std::invalid_argument("Bayesian optimization needs initial points and candidates");
+        }
+        if (!(options.lengthScale > 0.0)) throw std::invalid_argument("Length scale must be positive");
+    }
+
+    // Moves integer coordinates of a unit-cube point onto the grid of
+    // values their parameter can take.
+    static void snap(const std::vector<ParameterRange>& ranges, double* unit) {
+        for (size_t d = 0; d < ranges.size(); ++d) {
+            const ParameterRange& range = ranges[d];
+            double width = range.max - range.min;
+            if (!range.integer || !(width > 0.0)) continue;
+            double value = std::round(range.min + unit[d] * width);
+            unit[d] = std::clamp((value - range.min) / width, 0.0, 1.0);
+        }
+    }
+
+    static std::vector<double> toParams(const std::vector<ParameterRange>& ranges, std::vector<double>& unit) {
+        snap(ranges, unit.data());
+        std::vector<double> params(ranges.size());
+        for (size_t d = 0; d < ranges.size(); ++d) {
+            const ParameterRange& range = ranges[d];
+            params[d] = range.min + unit[d] * (range.max - range.min);
+            if (range.integer) params[d] = std::round(params[d]);
+        }
+        return params;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,199 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include <stdexcept>
+#include "OrderBook.hpp"
+#include "../models/Candle.hpp"
+#include "../models/Trade.hpp"
+
+struct ExecutionOptions {
+    std::time_t latency = 0;     // seconds from sending an order until it reaches the market
+    std::time_t timeToLive = 0;  // seconds an order works after it is sent; 0 = until filled
+    double participation = 0.0;  // share of each bar's volume the fills may take; 0 = no limit
+    OrderType signalOrder = OrderType::Market;  // order the Backtester sends for each signal
+    double signalOffset = 0.0;   // limit/stop distance from the signal price, as a fraction of it
+};
+
+// Bar-driven order matching, between the strategies that decide and the
+// accounting that books the fills.
+//
+// An order sent at time t reaches the market at t + latency and takes part
+// from the first bar that opens at or after then; the path of the bar it
+// arrives in is unknown, so no fill is guessed from it. Each bar then
+// matches, in this order:
+//   - market orders at the open, oldest first;
+//   - stops whose trigger the bar's range reached, at the trigger or at the
+//     open if the bar gapped through it; what is left of them joins the
+//     market queue for the next bars;
+//   - limits the range reached, at their price or the better open, in
+//     price-time priority.
+// With a participation rate, all fills of a bar together take at most that
+// share of its volume, and what does not fit keeps working. Orders past
+// their time to live are dropped when they next come up.
+class ExecutionSimulator {
+public:
+    using Id = OrderBook::Id;
+
+    struct Fill {
+        Id order;
+        Trade trade;    // side, bar timestamp, fill price, amount filled, reason
+        bool complete;  // nothing of the order is left
+    };
+
+    struct Stats {
+        size_t submitted;
+        size_t fills;
+        size_t completed;
+        size_t expired;
+        size_t cancelled;
+    };
+
+    explicit ExecutionSimulator(const ExecutionOptions& executionOptions = ExecutionOptions())
+        : options(executionOptions) {
+        if (options.latency < 0 || options.timeToLive < 0 || !(options.participation >= 0.0) ||
+            !(options.signalOffset >= 0.0)) {
+            throw std::invalid_argument("Execution latency, lifetime, participation and offset must be non-negative");
+        }
+    }
+
+    const ExecutionOptions& getOptions() const { return options; }
+
+    // Sends an order at `sentAt`. Orders must be sent in time order.
+    Id submit(TradeType side, OrderType type, double price, double amount, std::time_t sentAt,
+              TradeReason reason = TradeReason::None) {
+        if (!(amount > 0.0)) throw std::invalid_argument("Order amount must be positive");
+        if (type != OrderType::Market && !std::isfinite(price)) {
+            throw std::invalid_argument("Limit and stop orders need a finite price");
+        }
+        Order order{side, type, reason, price, amount, sentAt + options.latency,
+                    options.timeToLive > 0 ? sentAt + options.timeToLive : 0};
+        Id id = book.add(order);
+        inFlight.push_back(id);
+        ++counters.submitted;
+        return id;
+    }
+
+    bool cancel(Id id) {
+        if (!book.cancel(id)) return false;
+        ++counters.cancelled;
+        return true;
+    }
+
+    // The order's remaining state, or nullptr once it is done.
+    const Order* find(Id id) { return book.find(id); }
+
+    // Matches the working orders against one bar and passes each fill to
+    // `sink(const Fill&)`, which may submit or cancel orders in turn.
+    template <typename Sink>
+    void onBar(const Candle& candle, Sink&& sink) {
+        std::time_t now = candle.timestamp;
+        while (inFlightHead < inFlight.size()) {
+            Id id = inFlight[inFlightHead];
+            if (const Order* order = book.find(id)) {
+                if (order->arrival > now) break;
+                book.activate(id);
+            }
+            ++inFlightHead;
+        }
+        if (inFlightHead == inFlight.size()) {
+            inFlight.clear();
+            inFlightHead = 0;
+        }
+
+        double budget = options.participation > 0.0 ? options.participation * candle.volume : INFINITY;
+        Id id;
+
+        while (budget > 0.0 && book.nextMarket(id)) {
+            Order& order = *book.find(id);
+            if (expired(order, now)) {
+                book.popMarket();
+                expire(id);
+                continue;
+            }
+            double take = std::min(order.amount, budget);
+            budget -= take;
+            if (take == order.amount) book.popMarket();
+            fill(id, order, candle.open, take, now, sink);
+        }
+
+        for (OrderBook::Ladder ladder : {OrderBook::BuyStops, OrderBook::SellStops}) {
+            bool buy = ladder == OrderBook::BuyStops;
+            while (book.crossed(ladder, buy ? candle.high : -candle.low, id)) {
+                book.popFront(ladder);
+                Order& order = *book.find(id);
+                if (expired(order, now)) {
+                    expire(id);
+                    continue;
+                }
+                double price = buy ? std::max(candle.open, order.price) : std::min(candle.open, order.price);
+                double take = std::min(order.amount, budget);
+                budget -= take;
+                if (take < order.amount) book.toMarket(id);
+                if (take > 0.0) fill(id, order, price, take, now, sink);
+            }
+        }
+
+        for (OrderBook::Ladder ladder : {OrderBook::BuyLimits, OrderBook::SellLimits}) {
+            bool buy = ladder == OrderBook::BuyLimits;
+            while (budget > 0.0 && book.crossed(ladder, buy ? -candle.low : candle.high, id)) {
+                Order& order = *book.find(id);
+                if (expired(order, now)) {
+                    book.popFront(ladder);
+                    expire(id);
+                    continue;
+                }
+                double price = buy ? std::min(candle.open, order.price) : std::max(candle.open, order.price);
+                double take = std::min(order.amount, budget);
+                budget -= take;
+                if (take == order.amount) book.popFront(ladder);
+                fill(id, order, price, take, now, sink);
+            }
+        }
+    }
+
+    // Orders sent and not yet filled, expired or cancelled.
+    size_t pending() const { return book.size(); }
+
+    Stats stats() const { return counters; }
+
+    // Drops every order and zeroes the counters, keeping the storage.
+    void reset() {
+        book.clear();
+        inFlight.clear();
+        inFlightHead = 0;
+        counters = Stats{};
+    }
+
+private:
+    static bool expired(const Order& order, std::time_t now) {
+        return order.expires != 0 && order.expires <= now;
+    }
+
+    void expire(Id id) {
+        book.release(id);
+        ++counters.expired;
+    }
+
+    // Books `amount` of the order at `price`. An order this completes has
+    // already been taken off its queue or ladder and is released before the
+    // sink runs.
+    template <typename Sink>
+    void fill(Id id, Order& order, double price, double amount, std::time_t now, Sink& sink) {
+        Fill result{id, Trade{order.side, now, price, amount, order.reason}, amount == order.amount};
+        order.amount -= amount;
+        ++counters.fills;
+        if (result.complete) {
+            ++counters.completed;
+            book.release(id);
+        }
+        sink(static_cast<const Fill&>(result));
+    }
+
+    ExecutionOptions options;
+    OrderBook book;
+    std::vector<Id> inFlight;  // sent, in arrival order
+    size_t inFlightHead = 0;
+    Stats counters{};
+};
\ No newline at end of file
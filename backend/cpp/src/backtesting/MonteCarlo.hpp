@@ -0,0 +1,313 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "Backtester.hpp"
+#include "../utils/CounterRng.hpp"
+#include "../utils/ParallelFor.hpp"
+
+enum class Resampling : uint8_t {
+    Shuffle,    // every path is a random permutation of the trades
+    Bootstrap   // every path draws trades with replacement
+};
+
+struct MonteCarloOptions {
+    size_t paths = 10000;
+    unsigned threads = 0;          // 0 = all hardware threads
+    std::uint64_t seed = 0;
+    Resampling mode = Resampling::Shuffle;
+    double initialBalance = 10000.0;
+    size_t pathLength = 0;         // bootstrap only; 0 = number of trades
+    double confidence = 0.95;      // width of the reported intervals
+    bool keepDistributions = false;  // return the per-path values as well
+};
+
+struct MonteCarloResult {
+    struct Interval {
+        double lower;
+        double median;
+        double upper;
+        double mean;
+    };
+
+    size_t paths;
+    size_t pathLength;
+    Interval finalBalance;
+    Interval maxDrawdown;
+    Interval sharpeRatio;   // per trade, not annualised
+    Interval winRate;
+
+    // Losses as fractions of the initial balance, taken over final returns.
+    double var95;
+    double var99;
+    double cvar95;
+    double cvar99;
+    double lossProbability;  // final balance below the initial one
+    double ruinProbability;  // balance reached zero at some point
+
+    double averageWinStreak;
+    double averageLossStreak;
+    std::vector<std::uint64_t> maxWinStreaks;   // [k] = paths whose longest winning run was k trades
+    std::vector<std::uint64_t> maxLossStreaks;
+
+    double averageRecoveryTime;  // trades from the first dip below a peak to a new peak
+    size_t maxRecoveryTime;
+    double recoveryProbability;  // share of drawdowns that recovered within the path
+
+    // Per-path values in path order, filled only with keepDistributions.
+    std::vector<double> finalBalances;
+    std::vector<double> maxDrawdowns;
+    std::vector<double> sharpeRatios;
+    std::vector<double> winRates;
+};
+
+// Resamples a sequence of per-trade PnLs into many synthetic equity paths
+// across threads. Path p always uses RNG stream p, so a given seed gives the
+// same answer for any thread count. Each path is reduced to a few scalars on
+// the fly; equity curves are never stored.
+class MonteCarlo {
+public:
+    using Options = MonteCarloOptions;
+    using Result = MonteCarloResult;
+
+    static Result run(const std::vector<Backtester::RoundTrip>& roundTrips,
+                      const Options& options = Options()) {
+        std::vector<double> pnl(roundTrips.size());
+        for (size_t i = 0; i < roundTrips.size(); ++i) pnl[i] = roundTrips[i].pnl;
+        return run(pnl, options);
+    }
+
+    static Result run(const std::vector<double>& pnl, const Options& options = Options()) {
+        return run(pnl.data(), pnl.size(), options);
+    }
+
+    static Result run(const double* pnl, size_t count, const Options& options = Options()) {
+        if (count == 0) throw std::runtime_error("No trades to resample");
+        if (options.paths == 0) throw std::runtime_error("Monte Carlo needs at least one path");
+        if (!(options.initialBalance > 0.0)) throw std::runtime_error("Initial balance must be positive");
+
+        const size_t length = options.mode == Resampling::Bootstrap && options.pathLength > 0
+            ? options.pathLength : count;
+        const size_t paths = options.paths;
+
+        Result result{};
+        result.paths = paths;
+        result.pathLength = length;
+
+        std::vector<double> finals(paths), drawdowns(paths), sharpes(paths), winRates(paths);
+
+        unsigned workers = ParallelFor::resolveThreads(options.threads, paths);
+        std::vector<Tally> tallies(workers);
+        for (auto& tally : tallies) {
+            tally.maxWinStreaks.assign(length + 1, 0);
+            tally.maxLossStreaks.assign(length + 1, 0);
+            if (options.mode == Resampling::Shuffle) tally.scratch.resize(count);
+        }
+
+        ParallelFor::run(paths, workers, [&](size_t p, unsigned worker) {
+            Tally& tally = tallies[worker];
+            CounterRng rng(options.seed, p);
+            double* shuffled = nullptr;
+            if (options.mode == Resampling::Shuffle) {
+                shuffled = tally.scratch.data();
+                std::memcpy(shuffled, pnl, count * sizeof(double));
+            }
+
+            double balance = options.initialBalance;
+            double peak = balance;
+            double maxDrawdown = 0.0;
+            size_t dipStart = 0;
+            bool inDrawdown = false;
+            bool ruined = false;
+
+            // Per-trade returns stay near zero over one path, so plain sums
+            // lose nothing that matters and avoid a division per step.
+            double sum = 0.0;
+            double squares = 0.0;
+
+            // Wins and losses arrive at random, so the streak and drawdown
+            // bookkeeping is kept branch-free; only drawdown entry and
+            // recovery, which are rare, take a branch.
+            size_t wins = 0;
+            size_t winRun = 0;
+            size_t lossRun = 0;
+            size_t winRuns = 0;
+            size_t lossRuns = 0;
+            size_t maxWin = 0;
+            size_t maxLoss = 0;
+
+            for (size_t k = 0; k < length; ++k) {
+                double trade;
+                if (shuffled) {
+                    // Forward Fisher-Yates, one swap per step taken.
+                    size_t j = k + rng.below(count - k);
+                    std::swap(shuffled[k], shuffled[j]);
+                    trade = shuffled[k];
+                } else {
+                    trade = pnl[rng.below(count)];
+                }
+
+                double ret = balance > 0.0 ? trade / balance : 0.0;
+                sum += ret;
+                squares += ret * ret;
+
+                balance += trade;
+                ruined |= balance <= 0.0;
+
+                bool recovering = inDrawdown && balance > peak;
+                bool dipping = !inDrawdown && balance < peak;
+                if (recovering | dipping) {
+                    if (recovering) {
+                        size_t recovery = k + 1 - dipStart;
+                        ++tally.recovered;
+                        tally.recoveryTotal += recovery;
+                        tally.maxRecovery = std::max(tally.maxRecovery, recovery);
+                    } else {
+                        dipStart = k + 1;
+                        ++tally.drawdowns;
+                    }
+                    inDrawdown = dipping;
+                }
+                peak = std::max(peak, balance);
+                maxDrawdown = std::max(maxDrawdown, (peak - balance) / peak);
+
+                bool win = trade > 0.0;
+                wins += win;
+                winRun = (winRun + 1) * win;
+                lossRun = (lossRun + 1) * !win;
+                winRuns += winRun == 1;
+                lossRuns += lossRun == 1;
+                maxWin = std::max(maxWin, winRun);
+                maxLoss = std::max(maxLoss, lossRun);
+            }
+
+            tally.winStreaks += winRuns;
+            tally.winStreakTotal += wins;
+            tally.lossStreaks += lossRuns;
+            tally.lossStreakTotal += length - wins;
+            ++tally.maxWinStreaks[maxWin];
+            ++tally.maxLossStreaks[maxLoss];
+            if (ruined) ++tally.ruined;
+
+            double mean = sum / length;
+            double variance = length > 1 ? std::max(0.0, (squares - sum * mean) / (length - 1)) : 0.0;
+            double deviation = std::sqrt(variance);
+            finals[p] = balance;
+            drawdowns[p] = maxDrawdown;
+            sharpes[p] = deviation > 0.0 ? mean / deviation : 0.0;
+            winRates[p] = static_cast<double>(wins) / length;
+        });
+
+        Tally total;
+        total.maxWinStreaks.assign(length + 1, 0);
+        total.maxLossStreaks.assign(length + 1, 0);
+        for (const auto& tally : tallies) total.merge(tally);
+
+        result.maxWinStreaks = std::move(total.maxWinStreaks);
+        result.maxLossStreaks = std::move(total.maxLossStreaks);
+        result.averageWinStreak = total.winStreaks
+            ? static_cast<double>(total.winStreakTotal) / total.winStreaks : 0.0;
+        result.averageLossStreak = total.lossStreaks
+            ? static_cast<double>(total.lossStreakTotal) / total.lossStreaks : 0.0;
+        result.averageRecoveryTime = total.recovered
+            ? static_cast<double>(total.recoveryTotal) / total.recovered : 0.0;
+        result.maxRecoveryTime = total.maxRecovery;
+        result.recoveryProbability = total.drawdowns
+            ? static_cast<double>(total.recovered) / total.drawdowns : 0.0;
+        result.ruinProbability = static_cast<double>(total.ruined) / paths;
+
+        if (options.keepDistributions) {
+            result.finalBalances = finals;
+            result.maxDrawdowns = drawdowns;
+            result.sharpeRatios = sharpes;
+            result.winRates = winRates;
+        }
+
+        // Everything below reorders the per-path arrays in place.
+        result.finalBalance = interval(finals, options.confidence);
+        result.maxDrawdown = interval(drawdowns, options.confidence);
+        result.sharpeRatio = interval(sharpes, options.confidence);
+        result.winRate = interval(winRates, options.confidence);
+
+        std::vector<double>& returns = finals;
+        size_t losses = 0;
+        for (double& value : returns) {
+            value = value / options.initialBalance - 1.0;
+            if (value < 0.0) ++losses;
+        }
+        result.lossProbability = static_cast<double>(losses) / paths;
+        valueAtRisk(returns, 0.05, result.var95, result.cvar95);
+        valueAtRisk(returns, 0.01, result.var99, result.cvar99);
+        return result;
+    }
+
+private:
+    // Per-worker counters, merged once all paths are done. Only integer
+    // sums, so the totals do not depend on how paths were scheduled.
+    struct alignas(64) Tally {
+        std::vector<double> scratch;
+        std::vector<std::uint64_t> maxWinStreaks;
+        std::vector<std::uint64_t> maxLossStreaks;
+        std::uint64_t winStreaks = 0;
+        std::uint64_t winStreakTotal = 0;
+        std::uint64_t lossStreaks = 0;
+        std::uint64_t lossStreakTotal = 0;
+        std::uint64_t drawdowns = 0;
+        std::uint64_t recovered = 0;
+        std::uint64_t recoveryTotal = 0;
+        size_t maxRecovery = 0;
+        std::uint64_t ruined = 0;
+
+        void merge(const Tally& other) {
+            for (size_t i = 0; i < maxWinStreaks.size(); ++i) {
+                maxWinStreaks[i] += other.maxWinStreaks[i];
+                maxLossStreaks[i] += other.maxLossStreaks[i];
+            }
+            winStreaks += other.winStreaks;
+            winStreakTotal += other.winStreakTotal;
+            lossStreaks += other.lossStreaks;
+            lossStreakTotal += other.lossStreakTotal;
+            drawdowns += other.drawdowns;
+            recovered += other.recovered;
+            recoveryTotal += other.recoveryTotal;
+            maxRecovery = std::max(maxRecovery, other.maxRecovery);
+            ruined += other.ruined;
+        }
+    };
+
+    // Value at floor(q * n) of the sorted data, found by selection.
+    static double quantile(std::vector<double>& values, double q) {
+        size_t index = std::min(values.size() - 1, static_cast<size_t>(q * values.size()));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    static MonteCarloResult::Interval interval(std::vector<double>& values, double confidence) {
+        double sum = 0.0;
+        for (double v : values) sum += v;
+        MonteCarloResult::Interval out;
+        out.mean = sum / values.size();
+        out.lower = quantile(values, (1.0 - confidence) / 2.0);
+        out.median = quantile(values, 0.5);
+        out.upper = quantile(values, (1.0 + confidence) / 2.0);
+        return out;
+    }
+
+    // VaR is the loss at the `tail` quantile of returns, CVaR the mean loss
+    // of the paths strictly beyond it (the VaR itself when none are).
+    static void valueAtRisk(std::vector<double>& returns, double tail, double& var, double& cvar) {
+        size_t index = std::min(returns.size() - 1, static_cast<size_t>(tail * returns.size()));
+        std::nth_element(returns.begin(), returns.begin() + index, returns.end());
+        var = -returns[index];
+        if (index == 0) {
+            cvar = var;
+            return;
+        }
+        double sum = 0.0;
+        for (size_t i = 0; i < index; ++i) sum += returns[i];
+        cvar = -sum / index;
+    }
+};
\ No newline at end of file
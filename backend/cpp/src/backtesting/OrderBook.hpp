@@ -0,0 +1,289 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include "../models/Trade.hpp"
+
+enum class OrderType : std::uint8_t {
+    Market,
+    Limit,
+    Stop
+};
+
+struct Order {
+    TradeType side;
+    OrderType type;
+    TradeReason reason;
+    double price;         // limit price or stop trigger; unused for market orders
+    double amount;        // still to be filled
+    std::time_t arrival;  // when the order reaches the market
+    std::time_t expires;  // 0 = works until filled or cancelled
+};
+
+// Working orders of one instrument in price-time priority.
+//
+// Orders live in a slot pool recycled through a free list. Resting limit
+// and stop orders are indexed by four price ladders (buy/sell x limit/stop),
+// each a 4-ary heap of 16-byte entries in one flat array: the order nearest
+// the market is at the front and its successors share its cache lines, so
+// matching a bar touches only the orders it actually crosses. Ladder keys
+// are prices, negated where higher prices come first (buy limits, sell
+// stops), so every ladder is a min-heap and "crossed" is always key <= bound.
+// Market orders, including triggered stops, queue in arrival order.
+//
+// Cancelling frees the slot at once; entries still pointing at it are
+// recognised by their sequence number and dropped when they reach the
+// front, and a ladder is rebuilt once most of it is such dead entries.
+class OrderBook {
+public:
+    // Slot in the low 32 bits, sequence number in the high 32.
+    using Id = std::uint64_t;
+
+    enum Ladder : std::uint8_t { BuyLimits, SellLimits, BuyStops, SellStops };
+
+    // Stores an order without making it work yet; see activate().
+    Id add(const Order& order) {
+        std::uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<std::uint32_t>(orders.size());
+            orders.emplace_back();
+            sequences.emplace_back();
+            state.emplace_back(Free);
+        }
+        std::uint32_t sequence = nextSequence++;
+        orders[slot] = order;
+        sequences[slot] = sequence;
+        state[slot] = Stored;
+        ++live;
+        return makeId(slot, sequence);
+    }
+
+    // Puts an order on its ladder, or at the back of the market queue.
+    void activate(Id id) {
+        std::uint32_t slot = slotOf(id);
+        const Order& order = orders[slot];
+        Entry entry{0.0, sequenceOf(id), slot};
+        if (order.type == OrderType::Market) {
+            market.push_back(entry);
+            return;
+        }
+        Ladder ladder = ladderOf(order);
+        entry.key = descending(ladder) ? -order.price : order.price;
+        state[slot] = Resting;
+        push(ladders[ladder], entry);
+    }
+
+    // The order, or nullptr once it has been filled, expired or cancelled.
+    Order* find(Id id) {
+        std::uint32_t slot = slotOf(id);
+        if (slot >= orders.size() || state[slot] == Free || sequences[slot] != sequenceOf(id)) return nullptr;
+        return &orders[slot];
+    }
+
+    bool cancel(Id id) {
+        if (!find(id)) return false;
+        release(id);
+        return true;
+    }
+
+    // Frees a filled, expired or cancelled order's slot.
+    void release(Id id) {
+        std::uint32_t slot = slotOf(id);
+        bool resting = state[slot] == Resting;
+        state[slot] = Free;
+        freeSlots.push_back(slot);
+        --live;
+        if (!resting) return;
+
+        Heap& ladder = ladders[ladderOf(orders[slot])];
+        ++ladder.dead;
+        if (ladder.heap.size() > 64 && ladder.dead * 2 > ladder.heap.size()) compact(ladder);
+    }
+
+    // Front of `ladder` if its key is <= bound: a buy limit priced at or
+    // above -bound, a sell limit or buy stop at or below bound, a sell stop
+    // at or above -bound. Dead entries met on the way are dropped.
+    bool crossed(Ladder ladder, double bound, Id& id) {
+        Heap& heap = ladders[ladder];
+        while (!heap.heap.empty()) {
+            const Entry& front = heap.heap.front();
+            if (alive(front)) {
+                if (!(front.key <= bound)) return false;
+                id = makeId(front.slot, front.sequence);
+                return true;
+            }
+            pop(heap);
+            if (heap.dead > 0) --heap.dead;
+        }
+        return false;
+    }
+
+    // Takes the front entry found by crossed() off its ladder.
+    void popFront(Ladder ladder) {
+        state[ladders[ladder].heap.front().slot] = Stored;
+        pop(ladders[ladder]);
+    }
+
+    // Oldest live market order.
+    bool nextMarket(Id& id) {
+        while (marketHead < market.size()) {
+            const Entry& front = market[marketHead];
+            if (alive(front)) {
+                id = makeId(front.slot, front.sequence);
+                return true;
+            }
+            ++marketHead;
+        }
+        return false;
+    }
+
+    void popMarket() {
+        ++marketHead;
+        if (marketHead == market.size()) {
+            market.clear();
+            marketHead = 0;
+        } else if (marketHead > 1024 && marketHead * 2 > market.size()) {
+            market.erase(market.begin(), market.begin() + static_cast<std::ptrdiff_t>(marketHead));
+            marketHead = 0;
+        }
+    }
+
+    // Turns a triggered stop into a market order at the back of the queue.
+    void toMarket(Id id) {
+        orders[slotOf(id)].type = OrderType::Market;
+        market.push_back(Entry{0.0, sequenceOf(id), slotOf(id)});
+    }
+
+    // Orders stored and not yet released, in flight or working.
+    size_t size() const { return live; }
+
+    // Resting limit and stop orders, dead ladder entries included.
+    size_t ladderEntries() const {
+        size_t total = 0;
+        for (const auto& ladder : ladders) total += ladder.heap.size();
+        return total;
+    }
+
+    // Drops every order but keeps the storage.
+    void clear() {
+        orders.clear();
+        sequences.clear();
+        state.clear();
+        freeSlots.clear();
+        for (auto& ladder : ladders) {
+            ladder.heap.clear();
+            ladder.dead = 0;
+        }
+        market.clear();
+        marketHead = 0;
+        live = 0;
+    }
+
+    static Ladder ladderOf(const Order& order) {
+        bool buy = order.side == TradeType::Buy;
+        if (order.type == OrderType::Limit) return buy ? BuyLimits : SellLimits;
+        return buy ? BuyStops : SellStops;
+    }
+
+    static bool descending(Ladder ladder) {
+        return ladder == BuyLimits || ladder == SellStops;
+    }
+
+private:
+    enum SlotState : std::uint8_t { Free, Stored, Resting };
+
+    struct Entry {
+        double key;
+        std::uint32_t sequence;
+        std::uint32_t slot;
+    };
+
+    struct Heap {
+        std::vector<Entry> heap;
+        size_t dead = 0;  // entries known to point at released slots
+    };
+
+    static Id makeId(std::uint32_t slot, std::uint32_t sequence) {
+        return static_cast<Id>(sequence) << 32 | slot;
+    }
+    static std::uint32_t slotOf(Id id) { return static_cast<std::uint32_t>(id); }
+    static std::uint32_t sequenceOf(Id id) { return static_cast<std::uint32_t>(id >> 32); }
+
+    bool alive(const Entry& entry) const {
+        return state[entry.slot] != Free && sequences[entry.slot] == entry.sequence;
+    }
+
+    // Lower price key first, then earlier sequence. Sequences compare by
+    // their wrapped difference, which stays correct while the orders in a
+    // ladder span fewer than 2^31 submissions.
+    static bool before(const Entry& a, const Entry& b) {
+        if (a.key != b.key) return a.key < b.key;
+        return static_cast<std::int32_t>(a.sequence - b.sequence) < 0;
+    }
+
+    static void push(Heap& heap, Entry entry) {
+        std::vector<Entry>& h = heap.heap;
+        size_t i = h.size();
+        h.push_back(entry);
+        while (i > 0) {
+            size_t parent = (i - 1) / 4;
+            if (!before(entry, h[parent])) break;
+            h[i] = h[parent];
+            i = parent;
+        }
+        h[i] = entry;
+    }
+
+    static void pop(Heap& heap) {
+        std::vector<Entry>& h = heap.heap;
+        Entry last = h.back();
+        h.pop_back();
+        if (h.empty()) return;
+        siftDown(h, 0, last);
+    }
+
+    static void siftDown(std::vector<Entry>& h, size_t i, Entry entry) {
+        size_t n = h.size();
+        for (;;) {
+            size_t first = 4 * i + 1;
+            if (first >= n) break;
+            size_t best = first;
+            size_t end = std::min(first + 4, n);
+            for (size_t c = first + 1; c < end; ++c) {
+                if (before(h[c], h[best])) best = c;
+            }
+            if (!before(h[best], entry)) break;
+            h[i] = h[best];
+            i = best;
+        }
+        h[i] = entry;
+    }
+
+    // Drops dead entries and restores the heap order bottom-up.
+    void compact(Heap& heap) {
+        std::vector<Entry>& h = heap.heap;
+        size_t kept = 0;
+        for (const Entry& entry : h) {
+            if (alive(entry)) h[kept++] = entry;
+        }
+        h.resize(kept);
+        heap.dead = 0;
+        if (kept < 2) return;
+        for (size_t i = (kept - 2) / 4 + 1; i-- > 0;) siftDown(h, i, h[i]);
+    }
+
+    std::vector<Order> orders;
+    std::vector<std::uint32_t> sequences;
+    std::vector<SlotState> state;
+    std::vector<std::uint32_t> freeSlots;
+    Heap ladders[4];
+    std::vector<Entry> market;
+    size_t marketHead = 0;
+    std::uint32_t nextSequence = 0;
+    size_t live = 0;
+};
\ No newline at end of file
@@ -0,0 +1,183 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <optional>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "Backtester.hpp"
+#include "../strategies/Strategy.hpp"
+#include "../utils/ParallelFor.hpp"
+
+// Cartesian product of per-parameter value lists, enumerated lazily by
+// index (mixed radix, last axis fastest) so huge grids are never materialized.
+class ParameterGrid {
+private:
+    std::vector<std::vector<double>> axes;
+    size_t combinations = 0;
+
+public:
+    explicit ParameterGrid(std::vector<std::vector<double>> values)
+        : axes(std::move(values)) {
+        combinations = axes.empty() ? 0 : 1;
+        for (const auto& axis : axes) combinations *= axis.size();
+    }
+
+    size_t size() const { return combinations; }
+    size_t dimensions() const { return axes.size(); }
+
+    void at(size_t index, std::vector<double>& params) const {
+        params.resize(axes.size());
+        for (size_t d = axes.size(); d-- > 0;) {
+            params[d] = axes[d][index % axes[d].size()];
+            index /= axes[d].size();
+        }
+    }
+};
+
+struct SweepOptions {
+    unsigned threads = 0;         // 0 = all hardware threads
+    double initialBalance = 10000.0;
+    double commission = 0.001;
+    bool keepTrades = false;      // fill and round-trip lists are dropped by default to bound memory
+    std::function<double(const Backtester::BacktestResult&)> objective;  // defaults to Sharpe ratio
+    std::shared_ptr<IndicatorCache> cache;  // optional; shared by every worker's strategy
+    std::uint64_t seriesId = 0;             // cache id of the swept candles
+    std::optional<ExecutionOptions> execution;  // order simulation; signals fill at their price without
+};
+
+// Backtests one strategy type over many parameter sets in parallel.
+//
+// Every worker thread owns a single clone of the prototype strategy and a
+// Backtester; candidates are distributed by ParallelFor's work stealing and
+// all workers read the same candle buffer. With a cache in the options,
+// candidates that share an indicator parameterization compute it once, and
+// the strategy's prefetch() computes every candidate's series up front in
+// batched passes over the prices.
+// Results come back sorted by score, best first.
+class ParameterSweep {
+public:
+    using Options = SweepOptions;
+    using Objective = std::function<double(const Backtester::BacktestResult&)>;
+
+    struct Result {
+        size_t candidate;             // index into the grid / candidate list
+        std::vector<double> params;
+        double score;
+        size_t tradeCount;
+        Backtester::BacktestResult backtest;
+    };
+
+    static double sharpeObjective(const Backtester::BacktestResult& result) {
+        return result.sharpeRatio;
+    }
+
+    static std::vector<Result> run(const Strategy& prototype,
+                                   const CandleColumns& candles,
+                                   const ParameterGrid& grid,
+                                   const Options& options = Options()) {
+        return sweep(prototype, candles, grid.size(), options,
+                     [&grid](size_t i, std::vector<double>& params) { grid.at(i, params); });
+    }
+
+    static std::vector<Result> run(const Strategy& prototype,
+                                   const CandleColumns& candles,
+                                   const std::vector<std::vector<double>>& candidates,
+                                   const Options& options = Options()) {
+        return sweep(prototype, candles, candidates.size(), options,
+                     [&candidates](size_t i, std::vector<double>& params) { params = candidates[i]; });
+    }
+
+    template <typename Candidates>
+    static std::vector<Result> run(const Strategy& prototype,
+                                   const Candle* candles, size_t size,
+                                   const Candidates& candidates,
+                                   const Options& options = Options()) {
+        return run(prototype, CandleColumns::fromCandles(candles, size), candidates, options);
+    }
+
+    template <typename Candidates>
+    static std::vector<Result> run(const Strategy& prototype,
+                                   const std::vector<Candle>& candles,
+                                   const Candidates& candidates,
+                                   const Options& options = Options()) {
+        return run(prototype, candles.data(), candles.size(), candidates, options);
+    }
+
+    // Throws std::invalid_argument if any of paramsAt(0) ..
+    // paramsAt(count - 1) has the wrong number of values for `prototype`,
+    // before a single backtest is spent on the others.
+    template <typename ParamsAt>
+    static void checkCandidates(const Strategy& prototype, size_t count, ParamsAt& paramsAt) {
+        if (prototype.parameterCount() == 0) return;
+        std::vector<double> params;
+        for (size_t i = 0; i < count; ++i) {
+            paramsAt(i, params);
+            prototype.checkParameters(params);
+        }
+    }
+
+private:
+    template <typename ParamsAt>
+    static std::vector<Result> sweep(const Strategy& prototype,
+                                     const CandleColumns& candles,
+                                     size_t count, const Options& options,
+                                     ParamsAt paramsAt) {
+        std::vector<Result> results(count);
+        if (count == 0) return results;
+        checkCandidates(prototype, count, paramsAt);
+
+        unsigned workers = ParallelFor::resolveThreads(options.threads, count);
+        std::vector<Backtester> backtesters;
+        backtesters.reserve(workers);
+        for (unsigned w = 0; w < workers; ++w) {
+            backtesters.emplace_back(options.initialBalance, options.commission);
+            if (options.execution) backtesters.back().setExecution(*options.execution);
+            std::shared_ptr<Strategy> strategy = prototype.clone();
+            if (options.cache) strategy->attachCache(options.cache, options.seriesId);
+            backtesters.back().setStrategy(std::move(strategy));
+        }
+        // Each worker backtests into one reused result, so candidates after
+        // the first allocate nothing for their fill and round-trip lists.
+        std::vector<Backtester::BacktestResult> scratch(workers);
+        std::vector<Strategy*> strategies(workers);
+        for (unsigned w = 0; w < workers; ++w) strategies[w] = backtesters[w].getStrategy();
+
+        const Objective& objective = options.objective ? options.objective : Objective(sharpeObjective);
+        if (options.cache) strategies[0]->prefetch(candles, count, paramsAt);
+
+        ParallelFor::run(count, workers, [&](size_t i, unsigned worker) {
+            Result& result = results[i];
+            result.candidate = i;
+            paramsAt(i, result.params);
+            strategies[worker]->updateParameters(result.params);
+
+            Backtester::BacktestResult& run = scratch[worker];
+            backtesters[worker].run(candles, 0, candles.size, run);
+            result.tradeCount = run.trades.size();
+            result.score = objective(run);
+            if (std::isnan(result.score)) result.score = -INFINITY;
+            keep(run, result.backtest, options.keepTrades);
+        });
+
+        std::stable_sort(results.begin(), results.end(),
+                         [](const Result& a, const Result& b) { return a.score > b.score; });
+        return results;
+    }
+
+    // Copies a worker's run into its candidate's result; the fill and
+    // round-trip lists only when asked for, and without disturbing the
+    // capacity the worker keeps for its next run.
+    static void keep(Backtester::BacktestResult& run, Backtester::BacktestResult& out, bool lists) {
+        std::vector<Trade> trades = std::move(run.trades);
+        std::vector<Backtester::RoundTrip> roundTrips = std::move(run.roundTrips);
+        out = run;
+        if (lists) {
+            out.trades = trades;
+            out.roundTrips = roundTrips;
+        }
+        run.trades = std::move(trades);
+        run.roundTrips = std::move(roundTrips);
+    }
+};
\ No newline at end of file
@@ -0,0 +1,362 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <string>
+#include <queue>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include "Backtester.hpp"
+#include "PositionBook.hpp"
+#include "../strategies/Strategy.hpp"
+#include "../models/CandleColumns.hpp"
+#include "../utils/ParallelFor.hpp"
+
+// Backtests many symbols and strategies against one shared cash book.
+//
+// Every symbol's candle stream is merged by timestamp with a binary heap
+// (ties go to the symbol added first), each bar is dispatched to the
+// strategies subscribed to that symbol, and fills update the shared cash
+// balance and that symbol's own position. The portfolio is marked to market
+// once per distinct timestamp.
+//
+// A strategy only sees its own symbol's bars and fills never depend on the
+// book, so when no strategy instance is subscribed to more than one symbol
+// the signals of each symbol are generated on their own ParallelFor worker
+// first and the merge just replays them. A shared instance must see bars in
+// merged order, which forces the single-threaded path.
+//
+// Ruin is handled as in Backtester: once the marked portfolio is worth
+// nothing, every open position is liquidated at its last close, trading
+// stops and the remaining timestamps carry the leftover cash, floored at
+// zero.
+class PortfolioBacktester {
+private:
+    struct Symbol {
+        std::string name;
+        CandleColumns candles;
+        std::vector<std::shared_ptr<Strategy>> strategies;
+    };
+
+    double initialBalance;
+    CommissionModel commission;
+    SlippageModel slippage;
+    double periodsPerYear = 0.0;
+    unsigned threads = 0;
+    bool sharding = true;
+    std::vector<Symbol> symbols;
+
+public:
+    PortfolioBacktester(double balance = 10000.0, double comm = 0.001)
+        : initialBalance(balance) {
+        commission.rate = comm;
+    }
+
+    void setCommission(const CommissionModel& model) {
+        commission = model;
+    }
+
+    void setSlippage(const SlippageModel& model) {
+        slippage = model;
+    }
+
+    // Bars per year used to annualise Sharpe and Sortino; 0 infers it from
+    // the average spacing of the merged timestamps.
+    void setPeriodsPerYear(double periods) {
+        periodsPerYear = periods;
+    }
+
+    // Workers for per-symbol signal generation (0 = all hardware threads).
+    void setThreads(unsigned count) {
+        threads = count;
+    }
+
+    // Disables per-symbol sharding for strategies that share state in ways
+    // the engine cannot see, e.g. through a common external object.
+    void setSharding(bool enabled) {
+        sharding = enabled;
+    }
+
+    // Adds a symbol whose candles (ascending timestamps) stay owned by the
+    // caller for as long as the backtester runs over them.
+    size_t addSymbol(std::string name, const CandleColumns& candles) {
+        symbols.push_back(Symbol{std::move(name), candles, {}});
+        return symbols.size() - 1;
+    }
+
+    size_t addSymbol(std::string name, const std::vector<Candle>& candles) {
+        return addSymbol(std::move(name), CandleColumns::fromCandles(candles.data(), candles.size()));
+    }
+
+    void subscribe(size_t symbol, std::shared_ptr<Strategy> strategy) {
+        if (symbol >= symbols.size()) throw std::runtime_error("Unknown symbol");
+        if (!strategy) throw std::runtime_error("No strategy set");
+        symbols[symbol].strategies.push_back(std::move(strategy));
+    }
+
+    struct SymbolResult {
+        std::string symbol;
+        double pnl;          // net cash flow plus the open position at the last close
+        double position;
+        double lastPrice;
+        double commission;
+        double slippage;
+        double winRate;
+        std::vector<Trade> trades;  // executed fills, at fill price
+        std::vector<RoundTrip> roundTrips;
+    };
+
+    struct Result {
+        double finalBalance;  // cash plus every open position at its last close
+        double cash;
+        double totalReturn;
+        double maxDrawdown;
+        double sharpeRatio;
+        double sortinoRatio;
+        double winRate;       // over every symbol's round trips
+        double totalCommission;
+        bool sharded;
+        bool ruined;          // equity reached zero and the book was liquidated
+        size_t ruinedAt;      // index into timestamps where it happened; their count if never
+        std::vector<SymbolResult> symbols;
+        std::vector<time_t> timestamps;   // one per distinct bar timestamp
+        std::vector<double> equityCurve;  // portfolio value at each of them
+    };
+
+    Result run() {
+        Result result{};
+        result.cash = initialBalance;
+        result.sharded = sharding && shardable();
+        result.symbols.resize(symbols.size());
+        for (size_t s = 0; s < symbols.size(); ++s) result.symbols[s].symbol = symbols[s].name;
+
+        std::vector<std::vector<Signal>> signals(symbols.size());
+        if (result.sharded) {
+            ParallelFor::run(symbols.size(), threads, [&](size_t s, unsigned) {
+                signals[s] = generate(symbols[s]);
+            });
+        } else {
+            begin();
+        }
+
+        std::vector<PositionBook> books(symbols.size());
+        std::vector<double> lastClose(symbols.size(), 0.0);
+        std::vector<size_t> nextSignal(symbols.size(), 0);
+
+        std::priority_queue<Cursor, std::vector<Cursor>, Later> heap;
+        size_t longest = 0;
+        for (size_t s = 0; s < symbols.size(); ++s) {
+            if (symbols[s].candles.size > 0) heap.push({symbols[s].candles.timestampAt(0), s, 0});
+            longest = std::max(longest, symbols[s].candles.size);
+        }
+        result.timestamps.reserve(longest);
+        result.equityCurve.reserve(longest);
+
+        double peak = initialBalance;
+        double previousEquity = initialBalance;
+        size_t count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+        double downside = 0.0;
+
+        while (!heap.empty()) {
+            Cursor cursor = heap.top();
+            heap.pop();
+            const Symbol& symbol = symbols[cursor.symbol];
+            Candle candle = symbol.candles[cursor.bar];
+            lastClose[cursor.symbol] = candle.close;
+
+            SymbolResult& book = result.symbols[cursor.symbol];
+            if (result.sharded) {
+                const auto& pending = signals[cursor.symbol];
+                size_t& next = nextSignal[cursor.symbol];
+                for (; next < pending.size() && pending[next].bar == cursor.bar; ++next) {
+                    fill(pending[next].trade, result, book, books[cursor.symbol]);
+                }
+            } else {
+                for (const auto& strategy : symbol.strategies) {
+                    if (auto signal = strategy->onCandle(candle)) {
+                        fill(*signal, result, book, books[cursor.symbol]);
+                    }
+                }
+            }
+
+            if (cursor.bar + 1 < symbol.candles.size) {
+                heap.push({symbol.candles.timestampAt(cursor.bar + 1), cursor.symbol, cursor.bar + 1});
+            }
+            if (!heap.empty() && heap.top().timestamp == cursor.timestamp) continue;
+
+            // Last bar of this timestamp: mark the whole book.
+            double value = result.cash;
+            for (size_t s = 0; s < books.size(); ++s) value += books[s].position() * lastClose[s];
+            if (!(value > 0.0)) {
+                result.ruined = true;
+                result.ruinedAt = result.timestamps.size();
+                for (size_t s = 0; s < books.size(); ++s) {
+                    double position = books[s].position();
+                    if (position == 0.0) continue;
+                    TradeType side = position > 0.0 ? TradeType::Sell : TradeType::Buy;
+                    fill(Trade{side, cursor.timestamp, lastClose[s], std::abs(position), TradeReason::None},
+                         result, result.symbols[s], books[s]);
+                }
+                value = std::max(result.cash, 0.0);
+            }
+            result.timestamps.push_back(cursor.timestamp);
+            result.equityCurve.push_back(value);
+
+            if (value > peak) peak = value;
+            if (peak > 0.0) result.maxDrawdown = std::max(result.maxDrawdown, std::min((peak - value) / peak, 1.0));
+            double ret = previousEquity > 0.0 ? std::max(value / previousEquity - 1.0, -1.0) : 0.0;
+            previousEquity = value;
+            ++count;
+            double delta = ret - mean;
+            mean += delta / count;
+            m2 += delta * (ret - mean);
+            if (ret < 0.0) downside += ret * ret;
+
+            if (result.ruined) {
+                // Flat from here on: the rest of the merged timestamps just
+                // carry the final value.
+                while (!heap.empty()) {
+                    Cursor rest = heap.top();
+                    heap.pop();
+                    if (rest.timestamp != result.timestamps.back()) {
+                        result.timestamps.push_back(rest.timestamp);
+                        result.equityCurve.push_back(value);
+                    }
+                    const Symbol& restSymbol = symbols[rest.symbol];
+                    if (rest.bar + 1 < restSymbol.candles.size) {
+                        heap.push({restSymbol.candles.timestampAt(rest.bar + 1), rest.symbol, rest.bar + 1});
+                    }
+                }
+            }
+        }
+        if (!result.ruined) result.ruinedAt = result.timestamps.size();
+
+        if (!result.sharded) finish();
+
+        size_t trips = 0;
+        size_t wins = 0;
+        for (size_t s = 0; s < symbols.size(); ++s) {
+            SymbolResult& symbol = result.symbols[s];
+            symbol.position = books[s].position();
+            symbol.lastPrice = lastClose[s];
+            symbol.pnl += symbol.position * symbol.lastPrice;
+            size_t symbolWins = 0;
+            for (const auto& trip : symbol.roundTrips) {
+                if (trip.pnl > 0.0) ++symbolWins;
+            }
+            symbol.winRate = symbol.roundTrips.empty()
+                ? 0.0 : static_cast<double>(symbolWins) / symbol.roundTrips.size();
+            trips += symbol.roundTrips.size();
+            wins += symbolWins;
+        }
+
+        double scale = std::sqrt(annualisation(result.timestamps));
+        double deviation = count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0;
+        double downsideDeviation = count > 0 ? std::sqrt(downside / count) : 0.0;
+
+        result.finalBalance = previousEquity;
+        result.totalReturn = initialBalance != 0.0 ? previousEquity / initialBalance - 1.0 : 0.0;
+        result.sharpeRatio = deviation > 0.0 ? mean / deviation * scale : 0.0;
+        result.sortinoRatio = downsideDeviation > 0.0 ? mean / downsideDeviation * scale : 0.0;
+        result.winRate = trips ? static_cast<double>(wins) / trips : 0.0;
+        return result;
+    }
+
+private:
+    struct Cursor {
+        time_t timestamp;
+        size_t symbol;
+        size_t bar;
+    };
+
+    struct Later {
+        bool operator()(const Cursor& a, const Cursor& b) const {
+            return a.timestamp != b.timestamp ? a.timestamp > b.timestamp : a.symbol > b.symbol;
+        }
+    };
+
+    struct Signal {
+        size_t bar;
+        Trade trade;
+    };
+
+    bool shardable() const {
+        std::unordered_map<const Strategy*, size_t> owner;
+        for (size_t s = 0; s < symbols.size(); ++s) {
+            for (const auto& strategy : symbols[s].strategies) {
+                auto inserted = owner.emplace(strategy.get(), s);
+                if (!inserted.second && inserted.first->second != s) return false;
+            }
+        }
+        return true;
+    }
+
+    // One symbol's signals in the order the merged loop would produce them:
+    // by bar, then by subscription.
+    static std::vector<Signal> generate(const Symbol& symbol) {
+        std::vector<Signal> signals;
+        for (const auto& strategy : symbol.strategies) strategy->begin(symbol.candles);
+        for (size_t i = 0; i < symbol.candles.size; ++i) {
+            Candle candle = symbol.candles[i];
+            for (const auto& strategy : symbol.strategies) {
+                if (auto signal = strategy->onCandle(candle)) signals.push_back({i, *signal});
+            }
+        }
+        for (const auto& strategy : symbol.strategies) strategy->finish();
+        return signals;
+    }
+
+    // Instances confined to one symbol start a batch run over it; shared
+    // instances see interleaved bars, so they only get a clean state.
+    void begin() {
+        std::unordered_map<const Strategy*, size_t> subscriptions;
+        for (const auto& symbol : symbols) {
+            for (const auto& strategy : symbol.strategies) ++subscriptions[strategy.get()];
+        }
+        for (const auto& symbol : symbols) {
+            for (const auto& strategy : symbol.strategies) {
+                if (subscriptions[strategy.get()] == 1) {
+                    strategy->begin(symbol.candles);
+                } else {
+                    strategy->reset();
+                }
+            }
+        }
+    }
+
+    void finish() {
+        for (const auto& symbol : symbols) {
+            for (const auto& strategy : symbol.strategies) strategy->finish();
+        }
+    }
+
+    void fill(Trade trade, Result& result, SymbolResult& symbol, PositionBook& book) {
+        if (!(trade.amount > 0.0)) return;
+
+        double price = slippage.fillPrice(trade.price, trade.type);
+        double fee = commission(price * trade.amount);
+        double sign = trade.type == TradeType::Buy ? 1.0 : -1.0;
+        double flow = -sign * price * trade.amount - fee;
+
+        result.cash += flow;
+        result.totalCommission += fee;
+        symbol.pnl += flow;
+        symbol.commission += fee;
+        symbol.slippage += std::abs(price - trade.price) * trade.amount;
+        book.fill(trade.type, trade.amount, price, fee, trade.timestamp, symbol.roundTrips);
+
+        trade.price = price;
+        symbol.trades.push_back(trade);
+    }
+
+    double annualisation(const std::vector<time_t>& timestamps) const {
+        if (periodsPerYear > 0.0) return periodsPerYear;
+        if (timestamps.size() < 2) return 1.0;
+        double span = static_cast<double>(timestamps.back() - timestamps.front());
+        if (span <= 0.0) return 1.0;
+        return 365.25 * 86400.0 * (timestamps.size() - 1) / span;
+    }
+};
\ No newline at end of file
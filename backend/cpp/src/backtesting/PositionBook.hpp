@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include "../models/Trade.hpp"
+
+struct RoundTrip {
+    time_t entryTime;
+    time_t exitTime;
+    double quantity;    // largest size held; negative for shorts
+    double entryPrice;  // average entry fill
+    double exitPrice;   // average exit fill
+    double pnl;         // realised, net of commission on both legs
+};
+
+// Signed position in one instrument carried at average cost. Fills against
+// the position realise PnL into the round trip in progress, which is
+// emitted once the position is flat again; a fill that flips the position
+// closes one round trip and opens the next. Cash is the caller's concern.
+class PositionBook {
+private:
+    double quantity = 0.0;
+    double averagePrice = 0.0;
+    RoundTrip open{};  // round trip in progress while quantity != 0
+    double exitQuantity = 0.0;
+    double exitNotional = 0.0;
+
+public:
+    double position() const { return quantity; }
+    double average() const { return averagePrice; }
+
+    // Applies a fill of `amount` (> 0) at `price`, paying `fee`; completed
+    // round trips are appended to `roundTrips`.
+    void fill(TradeType type, double amount, double price, double fee, time_t timestamp,
+              std::vector<RoundTrip>& roundTrips) {
+        double sign = type == TradeType::Buy ? 1.0 : -1.0;
+        double remaining = amount;
+
+        if (quantity != 0.0 && (quantity > 0.0) != (sign > 0.0)) {
+            double held = std::abs(quantity);
+            double closing = std::min(remaining, held);
+            open.pnl += closing * (price - averagePrice) * -sign - fee * (closing / amount);
+            exitQuantity += closing;
+            exitNotional += closing * price;
+            remaining -= closing;
+
+            if (closing == held) {
+                quantity = 0.0;
+                open.exitTime = timestamp;
+                open.exitPrice = exitNotional / exitQuantity;
+                roundTrips.push_back(open);
+            } else {
+                quantity += sign * closing;
+            }
+        }
+
+        if (remaining > 0.0) {
+            if (quantity == 0.0) {
+                open = RoundTrip{timestamp, timestamp, 0.0, 0.0, 0.0, 0.0};
+                averagePrice = 0.0;
+                exitQuantity = 0.0;
+                exitNotional = 0.0;
+            }
+            double held = std::abs(quantity);
+            averagePrice = (averagePrice * held + price * remaining) / (held + remaining);
+            quantity += sign * remaining;
+            open.pnl -= fee * (remaining / amount);
+            open.entryPrice = averagePrice;
+            if (std::abs(quantity) > std::abs(open.quantity)) open.quantity = quantity;
+        }
+    }
+
+    void reset() {
+        *this = PositionBook();
+    }
+};
\ No newline at end of file
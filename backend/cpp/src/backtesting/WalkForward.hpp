@@ -0,0 +1,254 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "Backtester.hpp"
+#include "ParameterSweep.hpp"
+#include "../strategies/Strategy.hpp"
+#include "../indicators/IndicatorCache.hpp"
+#include "../utils/ParallelFor.hpp"
+
+struct WalkForwardOptions {
+    std::time_t window = 90 * 86400;  // in-sample plus out-of-sample span, in seconds
+    double trainRatio = 0.7;          // in-sample share of each window
+    std::time_t step = 0;             // window advance; 0 = out-of-sample length
+    unsigned threads = 0;             // 0 = all hardware threads
+    double initialBalance = 10000.0;
+    double commission = 0.001;
+    std::function<double(const Backtester::BacktestResult&)> objective;  // defaults to Sharpe ratio
+    std::shared_ptr<IndicatorCache> cache;  // optional; a private cache is used otherwise
+    std::uint64_t seriesId = 0;             // cache id of the candles
+};
+
+// Rolling walk-forward optimization: every window picks the candidate with
+// the best in-sample score and trades it on the out-of-sample bars that
+// follow.
+//
+// Windows are index ranges into the one candle series, never copies. All
+// (window, candidate) in-sample runs are spread over ParallelFor workers,
+// each owning one strategy clone and Backtester. Strategies read their
+// indicators from an IndicatorCache computed once over the whole series and
+// seek to each window's first bar, so indicator state carries across window
+// boundaries instead of restarting cold at every window.
+class WalkForward {
+public:
+    using Options = WalkForwardOptions;
+    using Objective = std::function<double(const Backtester::BacktestResult&)>;
+
+    struct Window {
+        size_t begin;   // in-sample bars are [begin, split)
+        size_t split;   // out-of-sample bars are [split, end)
+        size_t end;
+        size_t candidate;
+        std::vector<double> params;
+        double inSampleScore;
+        double outOfSampleScore;
+        Backtester::BacktestResult outOfSample;
+    };
+
+    struct Result {
+        std::vector<Window> windows;
+        std::vector<double> equityCurve;  // out-of-sample equity, each window compounding the last
+        double finalBalance;
+        double totalReturn;
+        double maxDrawdown;
+        double sharpeRatio;
+        double winRate;      // over every out-of-sample round trip
+        double efficiency;   // mean out-of-sample score / mean in-sample score
+        size_t trades;
+        size_t roundTrips;
+    };
+
+    // Bar ranges of the windows `options` lays over `candles`; windows whose
+    // in-sample or out-of-sample part holds no bars are skipped.
+    static std::vector<Window> plan(const CandleColumns& candles, const Options& options) {
+        if (options.window <= 0 || !(options.trainRatio > 0.0 && options.trainRatio < 1.0)) {
+            throw std::runtime_error("Walk-forward window must be positive with a train ratio in (0, 1)");
+        }
+        std::vector<Window> windows;
+        if (candles.size == 0) return windows;
+
+        auto train = static_cast<std::time_t>(options.window * options.trainRatio);
+        std::time_t step = options.step > 0 ? options.step : options.window - train;
+        if (step <= 0) step = 1;
+        std::time_t last = candles.timestampAt(candles.size - 1);
+
+        for (std::time_t start = candles.timestampAt(0); start + options.window <= last + 1; start += step) {
+            Window window{};
+            window.begin = candles.lowerBound(start);
+            window.split = candles.lowerBound(start + train);
+            window.end = candles.lowerBound(start + options.window);
+            if (window.begin < window.split && window.split < window.end) {
+                windows.push_back(std::move(window));
+            }
+        }
+        return windows;
+    }
+
+    static Result run(const Strategy& prototype,
+                      const CandleColumns& candles,
+                      const ParameterGrid& grid,
+                      const Options& options = Options()) {
+        return walk(prototype, candles, grid.size(), options,
+                    [&grid](size_t i, std::vector<double>& params) { grid.at(i, params); });
+    }
+
+    static Result run(const Strategy& prototype,
+                      const CandleColumns& candles,
+                      const std::vector<std::vector<double>>& candidates,
+                      const Options& options = Options()) {
+        return walk(prototype, candles, candidates.size(), options,
+                    [&candidates](size_t i, std::vector<double>& params) { params = candidates[i]; });
+    }
+
+    template <typename Candidates>
+    static Result run(const Strategy& prototype,
+                      const Candle* candles, size_t size,
+                      const Candidates& candidates,
+                      const Options& options = Options()) {
+        return run(prototype, CandleColumns::fromCandles(candles, size), candidates, options);
+    }
+
+    template <typename Candidates>
+    static Result run(const Strategy& prototype,
+                      const std::vector<Candle>& candles,
+                      const Candidates& candidates,
+                      const Options& options = Options()) {
+        return run(prototype, candles.data(), candles.size(), candidates, options);
+    }
+
+private:
+    template <typename ParamsAt>
+    static Result walk(const Strategy& prototype,
+                       const CandleColumns& candles,
+                       size_t count, const Options& options,
+                       ParamsAt paramsAt) {
+        if (!(options.initialBalance > 0.0)) throw std::runtime_error("Initial balance must be positive");
+        Result result{};
+        result.windows = plan(candles, options);
+        std::vector<Window>& windows = result.windows;
+        if (windows.empty() || count == 0) return result;
+        ParameterSweep::checkCandidates(prototype, count, paramsAt);
+
+        std::shared_ptr<IndicatorCache> cache = options.cache;
+        std::uint64_t seriesId = options.seriesId;
+        if (!cache) {
+            cache = std::make_shared<IndicatorCache>();
+            seriesId = 0;
+        }
+
+        size_t tasks = windows.size() * count;
+        unsigned workers = ParallelFor::resolveThreads(options.threads, tasks);
+        std::vector<Backtester> backtesters;
+        backtesters.reserve(workers);
+        for (unsigned w = 0; w < workers; ++w) {
+            backtesters.emplace_back(options.initialBalance, options.commission);
+            std::shared_ptr<Strategy> strategy = prototype.clone();
+            strategy->attachCache(cache, seriesId);
+            backtesters.back().setStrategy(std::move(strategy));
+        }
+        std::vector<std::vector<double>> params(workers);
+        std::vector<Backtester::BacktestResult> scratch(workers);
+
+        const Objective& objective = options.objective
+            ? options.objective : Objective(ParameterSweep::sharpeObjective);
+        auto score = [&objective](const Backtester::BacktestResult& backtest) {
+            double value = objective(backtest);
+            return std::isnan(value) ? -INFINITY : value;
+        };
+
+        // In-sample: every candidate on every window.
+        std::vector<double> scores(tasks);
+        ParallelFor::run(tasks, workers, [&](size_t task, unsigned worker) {
+            const Window& window = windows[task / count];
+            paramsAt(task % count, params[worker]);
+            backtesters[worker].getStrategy()->updateParameters(params[worker]);
+            backtesters[worker].run(candles, window.begin, window.split, scratch[worker]);
+            scores[task] = score(scratch[worker]);
+        });
+
+        // Out-of-sample: each window's best candidate on the bars after it.
+        std::vector<std::vector<double>> equity(windows.size());
+        ParallelFor::run(windows.size(), workers, [&](size_t w, unsigned worker) {
+            Window& window = windows[w];
+            const double* row = scores.data() + w * count;
+            window.candidate = static_cast<size_t>(std::max_element(row, row + count) - row);
+            window.inSampleScore = row[window.candidate];
+            paramsAt(window.candidate, window.params);
+
+            Backtester& backtester = backtesters[worker];
+            backtester.getStrategy()->updateParameters(window.params);
+            window.outOfSample = backtester.run(candles, window.split, window.end);
+            window.outOfSampleScore = score(window.outOfSample);
+            equity[w] = backtester.equityCurve();
+        });
+
+        aggregate(result, equity, candles, options.initialBalance);
+        return result;
+    }
+
+    static void aggregate(Result& result, const std::vector<std::vector<double>>& equity,
+                          const CandleColumns& candles, double initialBalance) {
+        size_t bars = 0;
+        for (const auto& curve : equity) bars += curve.size();
+        result.equityCurve.reserve(bars);
+
+        double capital = initialBalance;
+        double peak = capital;
+        double previous = capital;
+        double mean = 0.0;
+        double m2 = 0.0;
+        size_t count = 0;
+        size_t wins = 0;
+        double inSample = 0.0;
+        double outOfSample = 0.0;
+
+        for (size_t w = 0; w < result.windows.size(); ++w) {
+            const Window& window = result.windows[w];
+            // A ruined account stays flat rather than compounding a
+            // negative balance into the next window.
+            bool ruined = !(capital > 0.0);
+            double scale = ruined ? 0.0 : capital / initialBalance;
+            for (double value : equity[w]) {
+                value = ruined ? capital : value * scale;
+                result.equityCurve.push_back(value);
+
+                if (value > peak) peak = value;
+                if (peak > 0.0) result.maxDrawdown = std::max(result.maxDrawdown, (peak - value) / peak);
+                double ret = previous > 0.0 ? value / previous - 1.0 : 0.0;
+                previous = value;
+                ++count;
+                double delta = ret - mean;
+                mean += delta / count;
+                m2 += delta * (ret - mean);
+            }
+            if (!ruined) capital = window.outOfSample.finalBalance * scale;
+
+            result.trades += window.outOfSample.trades.size();
+            result.roundTrips += window.outOfSample.roundTrips.size();
+            for (const auto& trip : window.outOfSample.roundTrips) {
+                if (trip.pnl > 0.0) ++wins;
+            }
+            inSample += window.inSampleScore;
+            outOfSample += window.outOfSampleScore;
+        }
+
+        double periodsPerYear = 1.0;
+        if (candles.size > 1) {
+            double span = static_cast<double>(candles.timestampAt(candles.size - 1) - candles.timestampAt(0));
+            if (span > 0.0) periodsPerYear = 365.25 * 86400.0 * (candles.size - 1) / span;
+        }
+        double deviation = count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0;
+
+        result.finalBalance = capital;
+        result.totalReturn = capital / initialBalance - 1.0;
+        result.sharpeRatio = deviation > 0.0 ? mean / deviation * std::sqrt(periodsPerYear) : 0.0;
+        result.winRate = result.roundTrips ? static_cast<double>(wins) / result.roundTrips : 0.0;
+        result.efficiency = std::isfinite(inSample) && std::isfinite(outOfSample) && inSample != 0.0
+            ? outOfSample / inSample : 0.0;
+    }
+};
\ No newline at end of file
@@ -1,7 +1,12 @@
 #pragma once
 #include <vector>
 #include <cmath>
+#include <algorithm>
 #include "MovingAverage.hpp"
+#include "RollingStats.hpp"
+#include "VectorKernels.hpp"
+#include "../utils/Arena.hpp"
+#include "../models/Candle.hpp"
 
 class BollingerBands {
 public:
@@ -11,34 +16,235 @@ public:
         std::vector<double> lower;
     };
 
+    struct Point {
+        double upper;
+        double middle;
+        double lower;
+    };
+
+    // O(n) total: the window mean and variance are maintained incrementally by
+    // RollingStats instead of being re-summed for every bar. Compared with the
+    // previous two-pass O(n * period) loop the bands are bit-identical at
+    // every re-sync point (each `period` bars) and in between differ by at
+    // most a few ulps of the band value; bench/bollinger_bench.cpp reports
+    // the observed maximum (below 1e-13 relative on a random walk for periods
+    // 20, 200 and 2000).
     static BBands calculate(const std::vector<double>& prices, 
                           int period = 20, 
                           double multiplier = 2.0) {
-        std::vector<double> upper(prices.size());
-        std::vector<double> middle(prices.size());
-        std::vector<double> lower(prices.size());
+        return calculate(prices.data(), prices.size(), period, multiplier);
+    }
+
+    static BBands calculate(const double* prices, size_t size,
+                          int period = 20, 
+                          double multiplier = 2.0) {
+        BBands bands{
+            std::vector<double>(size),
+            std::vector<double>(size),
+            std::vector<double>(size)
+        };
+        if (period <= 0) return bands;
+
+        // The rolling pass leaves each bar's standard deviation in `upper`;
+        // the band pass then turns it into upper/lower in one vector sweep.
+        RollingStats stats(period);
+        size_t first = size;
+        for (size_t i = 0; i < size; ++i) {
+            stats.push(prices[i]);
+            if (!stats.full()) continue;
+
+            if (first == size) first = i;
+            bands.middle[i] = stats.average();
+            bands.upper[i] = stats.stdDev();
+        }
+        if (first < size) {
+            VectorKernels::bands(bands.middle.data() + first, bands.upper.data() + first, multiplier,
+                                 bands.upper.data() + first, bands.lower.data() + first, size - first);
+        }
         
-        // Calculate SMA for middle band
-        for (size_t i = period - 1; i < prices.size(); ++i) {
-            double sum = 0.0;
-            for (size_t j = 0; j < period; ++j) {
-                sum += prices[i - j];
+        return bands;
+    }
+
+    // Bands for `count` periods in one pass over the prices, bit-identical
+    // to calling calculate() once per period. Each of upper, middle and
+    // lower is period-major: row k (`size` values) belongs to periods[k].
+    static BBands calculateMany(const std::vector<double>& prices, const std::vector<int>& periods,
+                                double multiplier = 2.0) {
+        size_t size = prices.size();
+        size_t count = periods.size();
+        BBands bands{
+            std::vector<double>(count * size),
+            std::vector<double>(count * size),
+            std::vector<double>(count * size)
+        };
+        Arena::Scope scratch;
+        double* multipliers = scratch.allocate<double>(count);
+        double** rows = scratch.allocate<double*>(3 * count);
+        for (size_t k = 0; k < count; ++k) {
+            multipliers[k] = multiplier;
+            rows[k] = bands.upper.data() + k * size;
+            rows[count + k] = bands.middle.data() + k * size;
+            rows[2 * count + k] = bands.lower.data() + k * size;
+        }
+        calculateMany(prices.data(), size, periods.data(), multipliers, count,
+                      rows, rows + count, rows + 2 * count);
+        return bands;
+    }
+
+    // Same for (periods[k], multipliers[k]) pairs, writing to upper[k],
+    // middle[k] and lower[k]. Pairs sharing a period share one rolling
+    // window, so a period x multiplier grid pays for each distinct period
+    // once. The windows advance together, one bar at a time, reading the
+    // prices in place; each is re-summed every `period` bars exactly as
+    // RollingStats does.
+    static void calculateMany(const double* prices, size_t size, const int* periods, const double* multipliers,
+                              size_t count, double* const* upper, double* const* middle, double* const* lower) {
+        Arena::Scope scratch;
+        size_t* order = scratch.allocate<size_t>(count);
+        size_t valid = 0;
+        for (size_t k = 0; k < count; ++k) {
+            if (periods[k] > 0 && size >= static_cast<size_t>(periods[k])) {
+                order[valid++] = k;
+            } else {
+                std::fill(upper[k], upper[k] + size, 0.0);
+                std::fill(middle[k], middle[k] + size, 0.0);
+                std::fill(lower[k], lower[k] + size, 0.0);
+            }
+        }
+        if (valid == 0) return;
+        std::sort(order, order + valid, [periods](size_t a, size_t b) { return periods[a] < periods[b]; });
+
+        // One lane per distinct period, in ascending order, shared by every
+        // pair with that period.
+        size_t* laneOf = scratch.allocate<size_t>(valid);
+        int* window = scratch.allocate<int>(valid);
+        size_t lanes = 0;
+        for (size_t i = 0; i < valid; ++i) {
+            int period = periods[order[i]];
+            if (lanes == 0 || period != window[lanes - 1]) window[lanes++] = period;
+            laneOf[i] = lanes - 1;
+        }
+        double* mean = scratch.allocate<double>(lanes);
+        double* m2 = scratch.allocate<double>(lanes);
+        int* untilResync = scratch.allocate<int>(lanes);
+
+        // Each tile is written out while it is still in cache: middle and the
+        // standard deviation go to the pair's rows, which VectorKernels::bands
+        // then turns into upper and lower in place, so every output value is
+        // written to memory once.
+        size_t tileBars = std::max<size_t>(16, VectorKernels::laneTile / (2 * lanes));
+        double* meanTile = scratch.allocate<double>(tileBars * lanes);
+        double* stdDevTile = scratch.allocate<double>(tileBars * lanes);
+        size_t started = 0;
+        size_t startedPairs = 0;
+        for (size_t bar = static_cast<size_t>(window[0]) - 1; bar < size;) {
+            for (; started < lanes && static_cast<size_t>(window[started]) - 1 == bar; ++started) {
+                untilResync[started] = 1;
             }
-            middle[i] = sum / period;
-            
-            // Calculate standard deviation
-            double variance = 0.0;
-            for (size_t j = 0; j < period; ++j) {
-                variance += std::pow(prices[i - j] - middle[i], 2);
+            while (startedPairs < valid && laneOf[startedPairs] < started) ++startedPairs;
+            size_t end = std::min(size, bar + tileBars);
+            if (started < lanes) end = std::min(end, static_cast<size_t>(window[started]) - 1);
+
+            for (size_t b = bar; b < end; ++b) {
+                double value = prices[b];
+                double* meanRow = meanTile + (b - bar) * started;
+                double* stdDevRow = stdDevTile + (b - bar) * started;
+                for (size_t j = 0; j < started; ++j) {
+                    int period = window[j];
+                    if (--untilResync[j] == 0) {
+                        resync(prices + b, period, mean[j], m2[j]);
+                        untilResync[j] = period;
+                    } else {
+                        double oldest = prices[b - period];
+                        double delta = value - oldest;
+                        double oldMean = mean[j];
+                        mean[j] += delta / period;
+                        m2[j] += delta * (value - mean[j] + oldest - oldMean);
+                        if (m2[j] < 0.0) m2[j] = 0.0;
+                    }
+                    meanRow[j] = mean[j];
+                    stdDevRow[j] = std::sqrt(m2[j] / period);
+                }
             }
-            variance /= period;
-            double stdDev = std::sqrt(variance);
-            
-            // Calculate upper and lower bands
-            upper[i] = middle[i] + (multiplier * stdDev);
-            lower[i] = middle[i] - (multiplier * stdDev);
+            for (size_t i = 0; i < startedPairs; ++i) {
+                size_t k = order[i];
+                size_t j = laneOf[i];
+                double* middleOut = middle[k] + bar;
+                double* upperOut = upper[k] + bar;
+                for (size_t b = 0; b < end - bar; ++b) {
+                    middleOut[b] = meanTile[b * started + j];
+                    upperOut[b] = stdDevTile[b * started + j];
+                }
+                VectorKernels::bands(middleOut, upperOut, multipliers[k], upperOut, lower[k] + bar, end - bar);
+            }
+            bar = end;
         }
-        
-        return {upper, middle, lower};
+        for (size_t i = 0; i < valid; ++i) {
+            size_t k = order[i];
+            size_t first = static_cast<size_t>(periods[k]) - 1;
+            std::fill(upper[k], upper[k] + first, 0.0);
+            std::fill(middle[k], middle[k] + first, 0.0);
+            std::fill(lower[k], lower[k] + first, 0.0);
+        }
+    }
+
+private:
+    // RollingStats' exact re-sum of the window ending at `newest`, newest
+    // value first.
+    static void resync(const double* newest, int period, double& mean, double& m2) {
+        double sum = 0.0;
+        for (int j = 0; j < period; ++j) sum += newest[-j];
+        mean = sum / period;
+
+        double squares = 0.0;
+        for (int j = 0; j < period; ++j) {
+            double d = newest[-j] - mean;
+            squares += d * d;
+        }
+        m2 = squares;
+    }
+};
+
+// Streaming counterpart of BollingerBands::calculate backed by RollingStats,
+// so each bar costs O(1) regardless of `period`. Bands are 0 until the window
+// is full, as in the batch version.
+class BollingerBandsStream {
+private:
+    RollingStats stats;
+    double multiplier;
+    BollingerBands::Point current{0.0, 0.0, 0.0};
+
+public:
+    explicit BollingerBandsStream(int period = 20, double multiplier = 2.0)
+        : stats(period), multiplier(multiplier) {}
+
+    BollingerBands::Point update(const Candle& candle) {
+        return update(candle.close);
+    }
+
+    BollingerBands::Point update(double price) {
+        stats.push(price);
+        if (stats.full()) {
+            double stdDev = stats.stdDev();
+            current.middle = stats.average();
+            current.upper = current.middle + (multiplier * stdDev);
+            current.lower = current.middle - (multiplier * stdDev);
+        }
+        return current;
+    }
+
+    // Same as assigning a new stream, without reallocating the window.
+    void configure(int period, double bandMultiplier) {
+        stats.setPeriod(period);
+        multiplier = bandMultiplier;
+        current = {0.0, 0.0, 0.0};
+    }
+
+    bool ready() const { return stats.full(); }
+    const BollingerBands::Point& value() const { return current; }
+
+    void reset() {
+        stats.reset();
+        current = {0.0, 0.0, 0.0};
     }
 };
\ No newline at end of file
@@ -0,0 +1,383 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "RSI.hpp"
+#include "MACD.hpp"
+#include "MovingAverage.hpp"
+#include "BollingerBands.hpp"
+#include "../models/CandleColumns.hpp"
+#include "../utils/Metrics.hpp"
+
+// Shared store of computed indicator series, keyed by
+// (series id, indicator, parameters).
+//
+// The series id names one immutable candle series; callers choose it (for
+// example one id per symbol/timeframe buffer) and must not reuse it for
+// different data. Lookups take a shared lock; a miss inserts an in-flight
+// placeholder so concurrent requests for the same key wait for one
+// computation instead of repeating it. Values are handed out as
+// shared_ptr<const ...>, so eviction never invalidates a series in use.
+// When the resident size exceeds the memory budget the least recently used
+// ready entries are evicted.
+class IndicatorCache {
+public:
+    using Series = std::shared_ptr<const std::vector<double>>;
+    using MACDSeries = std::shared_ptr<const MACD::MACDData>;
+    using BandsSeries = std::shared_ptr<const BollingerBands::BBands>;
+
+    struct Stats {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t evictions;
+        size_t bytes;
+        size_t entries;
+    };
+
+    explicit IndicatorCache(size_t memoryBudget = size_t(256) << 20)
+        : budget(memoryBudget) {}
+
+    // Close prices of a strided (array-of-structs) series, extracted once.
+    Series closes(std::uint64_t seriesId, const CandleColumns& bars) {
+        return get<std::vector<double>>(Key{seriesId, Kind::Close, {0, 0, 0}}, [&] {
+            std::vector<double> prices(bars.size);
+            for (size_t i = 0; i < bars.size; ++i) prices[i] = bars.closeAt(i);
+            return prices;
+        });
+    }
+
+    Series rsi(std::uint64_t seriesId, const CandleColumns& bars, int period) {
+        return get<std::vector<double>>(Key{seriesId, Kind::RSI, {double(period), 0, 0}}, [&] {
+            Prices prices = closePrices(seriesId, bars);
+            return RSI::calculate(prices.data, bars.size, period);
+        });
+    }
+
+    Series ema(std::uint64_t seriesId, const CandleColumns& bars, int period) {
+        return get<std::vector<double>>(Key{seriesId, Kind::EMA, {double(period), 0, 0}}, [&] {
+            Prices prices = closePrices(seriesId, bars);
+            return MovingAverage::calculateEMA(prices.data, bars.size, period);
+        });
+    }
+
+    // Built from the cached EMAs, so MACD variants sharing a fast or slow
+    // period (and any strategy using the same EMA) reuse them.
+    MACDSeries macd(std::uint64_t seriesId, const CandleColumns& bars,
+                    int fastPeriod, int slowPeriod, int signalPeriod) {
+        Key key{seriesId, Kind::MACD, {double(fastPeriod), double(slowPeriod), double(signalPeriod)}};
+        return get<MACD::MACDData>(key, [&] {
+            size_t size = bars.size;
+            auto fastEMA = ema(seriesId, bars, fastPeriod);
+            auto slowEMA = ema(seriesId, bars, slowPeriod);
+
+            MACD::MACDData data;
+            data.macd.resize(size);
+            VectorKernels::subtract(fastEMA->data(), slowEMA->data(), data.macd.data(), size);
+            data.signal = MovingAverage::calculateEMA(data.macd, signalPeriod);
+            data.histogram.resize(size);
+            VectorKernels::subtract(data.macd.data(), data.signal.data(), data.histogram.data(), size);
+            return data;
+        });
+    }
+
+    BandsSeries bollinger(std::uint64_t seriesId, const CandleColumns& bars,
+                          int period, double multiplier) {
+        return get<BollingerBands::BBands>(Key{seriesId, Kind::Bollinger, {double(period), multiplier, 0}}, [&] {
+            Prices prices = closePrices(seriesId, bars);
+            return BollingerBands::calculate(prices.data, bars.size, period, multiplier);
+        });
+    }
+
+    // Batched lookups for a sweep's worth of parameterizations. Every
+    // series missing from the cache is computed in one shared pass over the
+    // prices (RSI::calculateMany and friends) and then stored under its own
+    // key, so the single-period lookups above hit afterwards. A series some
+    // other thread stores first wins; the batch's copy is dropped.
+    std::vector<Series> rsi(std::uint64_t seriesId, const CandleColumns& bars, const std::vector<int>& periods) {
+        return many(seriesId, Kind::RSI, bars, periods,
+                    [](const double* prices, size_t size, const int* missing, size_t count, double* const* rows) {
+                        RSI::calculateMany(prices, size, missing, count, rows);
+                    });
+    }
+
+    std::vector<Series> ema(std::uint64_t seriesId, const CandleColumns& bars, const std::vector<int>& periods) {
+        return many(seriesId, Kind::EMA, bars, periods,
+                    [](const double* prices, size_t size, const int* missing, size_t count, double* const* rows) {
+                        MovingAverage::calculateEMAMany(prices, size, missing, count, rows);
+                    });
+    }
+
+    // (periods[k], multipliers[k]) pairs.
+    std::vector<BandsSeries> bollinger(std::uint64_t seriesId, const CandleColumns& bars,
+                                       const std::vector<int>& periods, const std::vector<double>& multipliers) {
+        if (periods.size() != multipliers.size()) {
+            throw std::invalid_argument("Bollinger periods and multipliers must pair up");
+        }
+        std::vector<int> missingPeriods;
+        std::vector<double> missingMultipliers;
+        for (size_t k = 0; k < periods.size(); ++k) {
+            Key key{seriesId, Kind::Bollinger, {double(periods[k]), multipliers[k], 0}};
+            bool repeated = false;
+            for (size_t m = 0; m < missingPeriods.size() && !repeated; ++m) {
+                repeated = missingPeriods[m] == periods[k] && missingMultipliers[m] == multipliers[k];
+            }
+            if (!repeated && !contains(key)) {
+                missingPeriods.push_back(periods[k]);
+                missingMultipliers.push_back(multipliers[k]);
+            }
+        }
+
+        std::vector<BollingerBands::BBands> computed(missingPeriods.size());
+        if (!computed.empty()) {
+            TRADING_TIMED("indicator_compute_ns", "");
+            Prices prices = closePrices(seriesId, bars);
+            std::vector<double*> rows(3 * computed.size());
+            for (size_t m = 0; m < computed.size(); ++m) {
+                computed[m] = {std::vector<double>(bars.size), std::vector<double>(bars.size),
+                               std::vector<double>(bars.size)};
+                rows[m] = computed[m].upper.data();
+                rows[computed.size() + m] = computed[m].middle.data();
+                rows[2 * computed.size() + m] = computed[m].lower.data();
+            }
+            BollingerBands::calculateMany(prices.data, bars.size, missingPeriods.data(), missingMultipliers.data(),
+                                          computed.size(), rows.data(), rows.data() + computed.size(),
+                                          rows.data() + 2 * computed.size());
+        }
+
+        std::vector<BandsSeries> result(periods.size());
+        for (size_t k = 0; k < periods.size(); ++k) {
+            Key key{seriesId, Kind::Bollinger, {double(periods[k]), multipliers[k], 0}};
+            result[k] = get<BollingerBands::BBands>(key, [&] {
+                for (size_t m = 0; m < missingPeriods.size(); ++m) {
+                    if (missingPeriods[m] == periods[k] && missingMultipliers[m] == multipliers[k]) {
+                        return std::move(computed[m]);
+                    }
+                }
+                return BollingerBands::calculate(closePrices(seriesId, bars).data, bars.size,
+                                                 periods[k], multipliers[k]);
+            });
+        }
+        return result;
+    }
+
+    Stats stats() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return {
+            hits.load(std::memory_order_relaxed),
+            misses.load(std::memory_order_relaxed),
+            evictions.load(std::memory_order_relaxed),
+            residentBytes,
+            entries.size()
+        };
+    }
+
+    void clear() {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->second->ready) {
+                residentBytes -= it->second->bytes;
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+private:
+    // Close prices for an indicator computation: read in place when the
+    // close column is dense, otherwise from the cached extraction (kept
+    // alive by `owner` for the duration of the computation).
+    struct Prices {
+        const double* data;
+        Series owner;
+    };
+
+    Prices closePrices(std::uint64_t seriesId, const CandleColumns& bars) {
+        if (bars.contiguous()) return {bars.close, nullptr};
+        Series owner = closes(seriesId, bars);
+        return {owner->data(), owner};
+    }
+
+    enum class Kind : std::uint8_t { Close, RSI, EMA, MACD, Bollinger };
+
+    struct Key {
+        std::uint64_t seriesId;
+        Kind kind;
+        double params[3];
+
+        bool operator==(const Key& other) const {
+            return seriesId == other.seriesId && kind == other.kind &&
+                   std::memcmp(params, other.params, sizeof(params)) == 0;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            std::uint64_t h = key.seriesId * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint64_t>(key.kind);
+            for (double p : key.params) {
+                std::uint64_t bits;
+                std::memcpy(&bits, &p, sizeof(bits));
+                h = (h ^ bits) * 0x100000001B3ull;
+                h ^= h >> 29;
+            }
+            return static_cast<size_t>(h);
+        }
+    };
+
+    // Shared body of the batched single-series lookups; computeRows has
+    // RSI::calculateMany's row-pointer signature.
+    template <typename ComputeRows>
+    std::vector<Series> many(std::uint64_t seriesId, Kind kind, const CandleColumns& bars,
+                             const std::vector<int>& periods, ComputeRows computeRows) {
+        std::vector<int> missing;
+        for (int period : periods) {
+            if (!contains(Key{seriesId, kind, {double(period), 0, 0}})) missing.push_back(period);
+        }
+        std::sort(missing.begin(), missing.end());
+        missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+
+        std::vector<std::vector<double>> computed(missing.size());
+        if (!computed.empty()) {
+            TRADING_TIMED("indicator_compute_ns", "");
+            Prices prices = closePrices(seriesId, bars);
+            std::vector<double*> rows(computed.size());
+            for (size_t m = 0; m < computed.size(); ++m) {
+                computed[m].resize(bars.size);
+                rows[m] = computed[m].data();
+            }
+            computeRows(prices.data, bars.size, missing.data(), missing.size(), rows.data());
+        }
+
+        std::vector<Series> result(periods.size());
+        for (size_t k = 0; k < periods.size(); ++k) {
+            result[k] = get<std::vector<double>>(Key{seriesId, kind, {double(periods[k]), 0, 0}}, [&] {
+                auto it = std::lower_bound(missing.begin(), missing.end(), periods[k]);
+                if (it != missing.end() && *it == periods[k]) return std::move(computed[it - missing.begin()]);
+                // Evicted between the check and now: compute it alone.
+                std::vector<double> row(bars.size);
+                double* out = row.data();
+                computeRows(closePrices(seriesId, bars).data, bars.size, &periods[k], 1, &out);
+                return row;
+            });
+        }
+        return result;
+    }
+
+    bool contains(const Key& key) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return entries.count(key) != 0;
+    }
+
+    struct Entry {
+        std::shared_future<std::shared_ptr<const void>> value;
+        std::atomic<std::uint64_t> lastUsed{0};
+        size_t bytes = 0;
+        bool ready = false;
+    };
+
+    static size_t footprint(const std::vector<double>& v) { return v.size() * sizeof(double); }
+    static size_t footprint(const MACD::MACDData& d) {
+        return footprint(d.macd) + footprint(d.signal) + footprint(d.histogram);
+    }
+    static size_t footprint(const BollingerBands::BBands& b) {
+        return footprint(b.upper) + footprint(b.middle) + footprint(b.lower);
+    }
+
+    template <typename T, typename Compute>
+    std::shared_ptr<const T> get(const Key& key, Compute compute) {
+        std::uint64_t now = clock.fetch_add(1, std::memory_order_relaxed);
+        std::shared_future<std::shared_ptr<const void>> pending;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = entries.find(key);
+            if (it != entries.end()) {
+                it->second->lastUsed.store(now, std::memory_order_relaxed);
+                pending = it->second->value;
+            }
+        }
+        if (pending.valid()) {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            TRADING_COUNT("indicator_cache_hits", "", 1);
+            return std::static_pointer_cast<const T>(pending.get());
+        }
+
+        std::promise<std::shared_ptr<const void>> promise;
+        std::shared_ptr<Entry> entry;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            auto it = entries.find(key);
+            if (it != entries.end()) {
+                it->second->lastUsed.store(now, std::memory_order_relaxed);
+                pending = it->second->value;
+            } else {
+                entry = std::make_shared<Entry>();
+                entry->value = promise.get_future().share();
+                entry->lastUsed.store(now, std::memory_order_relaxed);
+                entries.emplace(key, entry);
+            }
+        }
+        if (pending.valid()) {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            TRADING_COUNT("indicator_cache_hits", "", 1);
+            return std::static_pointer_cast<const T>(pending.get());
+        }
+
+        misses.fetch_add(1, std::memory_order_relaxed);
+        std::shared_ptr<const T> result;
+        try {
+            TRADING_TIMED("indicator_compute_ns", "");
+            result = std::make_shared<const T>(compute());
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            entries.erase(key);
+            throw;
+        }
+        promise.set_value(result);
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        entry->bytes = footprint(*result);
+        entry->ready = true;
+        residentBytes += entry->bytes;
+        evictOverBudget();
+        return result;
+    }
+
+    // Caller holds the unique lock. Drops least recently used ready entries
+    // until the cache fits its budget again.
+    void evictOverBudget() {
+        while (residentBytes > budget) {
+            auto victim = entries.end();
+            std::uint64_t oldest = UINT64_MAX;
+            for (auto it = entries.begin(); it != entries.end(); ++it) {
+                std::uint64_t used = it->second->lastUsed.load(std::memory_order_relaxed);
+                if (it->second->ready && used < oldest) {
+                    oldest = used;
+                    victim = it;
+                }
+            }
+            if (victim == entries.end()) return;
+
+            residentBytes -= victim->second->bytes;
+            entries.erase(victim);
+            evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    size_t budget;
+    size_t residentBytes = 0;
+    mutable std::shared_mutex mutex;
+    std::unordered_map<Key, std::shared_ptr<Entry>, KeyHash> entries;
+    std::atomic<std::uint64_t> clock{0};
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> evictions{0};
+};
\ No newline at end of file
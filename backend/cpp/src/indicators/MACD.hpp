@@ -1,7 +1,10 @@
 #pragma once
 #include "MovingAverage.hpp"
+#include "VectorKernels.hpp"
+#include "../utils/Arena.hpp"
 #include <vector>
 #include <tuple>
+#include "../models/Candle.hpp"
 
 class MACD {
 public:
@@ -11,25 +14,73 @@ public:
         std::vector<double> histogram;
     };
 
+    struct Point {
+        double macd;
+        double signal;
+        double histogram;
+    };
+
     static MACDData calculate(const std::vector<double>& prices, 
                             int fastPeriod = 12, 
                             int slowPeriod = 26, 
                             int signalPeriod = 9) {
-        auto fastEMA = MovingAverage::calculateEMA(prices, fastPeriod);
-        auto slowEMA = MovingAverage::calculateEMA(prices, slowPeriod);
+        return calculate(prices.data(), prices.size(), fastPeriod, slowPeriod, signalPeriod);
+    }
+
+    static MACDData calculate(const double* prices, size_t size,
+                            int fastPeriod = 12, 
+                            int slowPeriod = 26, 
+                            int signalPeriod = 9) {
+        Arena::Scope scratch;
+        double* fastEMA = scratch.allocate<double>(size);
+        double* slowEMA = scratch.allocate<double>(size);
+        MovingAverage::calculateEMA(prices, size, fastPeriod, fastEMA);
+        MovingAverage::calculateEMA(prices, size, slowPeriod, slowEMA);
         
-        std::vector<double> macdLine(prices.size());
-        for (size_t i = 0; i < prices.size(); ++i) {
-            macdLine[i] = fastEMA[i] - slowEMA[i];
-        }
+        std::vector<double> macdLine(size);
+        VectorKernels::subtract(fastEMA, slowEMA, macdLine.data(), size);
         
         auto signalLine = MovingAverage::calculateEMA(macdLine, signalPeriod);
         
-        std::vector<double> histogram(prices.size());
-        for (size_t i = 0; i < prices.size(); ++i) {
-            histogram[i] = macdLine[i] - signalLine[i];
-        }
+        std::vector<double> histogram(size);
+        VectorKernels::subtract(macdLine.data(), signalLine.data(), histogram.data(), size);
         
-        return {macdLine, signalLine, histogram};
+        return {std::move(macdLine), std::move(signalLine), std::move(histogram)};
+    }
+};
+
+// Streaming counterpart of MACD::calculate built from three EMAStreams. Like
+// the batch version, the signal EMA is fed the MACD line from the very first
+// bar, so the two agree value for value.
+class MACDStream {
+private:
+    EMAStream fastEMA;
+    EMAStream slowEMA;
+    EMAStream signalEMA;
+    MACD::Point current{0.0, 0.0, 0.0};
+
+public:
+    explicit MACDStream(int fastPeriod = 12, int slowPeriod = 26, int signalPeriod = 9)
+        : fastEMA(fastPeriod), slowEMA(slowPeriod), signalEMA(signalPeriod) {}
+
+    MACD::Point update(const Candle& candle) {
+        return update(candle.close);
+    }
+
+    MACD::Point update(double price) {
+        current.macd = fastEMA.update(price) - slowEMA.update(price);
+        current.signal = signalEMA.update(current.macd);
+        current.histogram = current.macd - current.signal;
+        return current;
+    }
+
+    bool ready() const { return slowEMA.ready() && signalEMA.ready(); }
+    const MACD::Point& value() const { return current; }
+
+    void reset() {
+        fastEMA.reset();
+        slowEMA.reset();
+        signalEMA.reset();
+        current = {0.0, 0.0, 0.0};
     }
 };
\ No newline at end of file
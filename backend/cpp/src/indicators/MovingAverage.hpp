@@ -1,6 +1,10 @@
 #pragma once
 #include <vector>
 #include <numeric>
+#include <algorithm>
+#include "VectorKernels.hpp"
+#include "../utils/Arena.hpp"
+#include "../models/Candle.hpp"
 
 class MovingAverage {
 public:
@@ -13,19 +17,197 @@ public:
     }
 
     static std::vector<double> calculateEMA(const std::vector<double>& prices, int period) {
-        std::vector<double> ema(prices.size());
+        return calculateEMA(prices.data(), prices.size(), period);
+    }
+
+    static std::vector<double> calculateEMA(const double* prices, size_t size, int period) {
+        std::vector<double> ema(size);
+        calculateEMA(prices, size, period, ema.data());
+        return ema;
+    }
+
+    // Writes `size` EMA values to caller-provided storage, 0 before the seed.
+    static void calculateEMA(const double* prices, size_t size, int period, double* ema) {
+        if (period <= 0 || size < static_cast<size_t>(period)) {
+            std::fill(ema, ema + size, 0.0);
+            return;
+        }
         double multiplier = 2.0 / (period + 1.0);
+        std::fill(ema, ema + period - 1, 0.0);
         
         // Initialize EMA with SMA for first period
-        ema[period-1] = calculateSMA(std::vector<double>(prices.begin(), 
-                                                        prices.begin() + period), 
-                                   period);
+        ema[period-1] = std::accumulate(prices, prices + period, 0.0) / period;
         
         // Calculate EMA for remaining prices
-        for (size_t i = period; i < prices.size(); ++i) {
+        for (size_t i = period; i < size; ++i) {
             ema[i] = (prices[i] - ema[i-1]) * multiplier + ema[i-1];
         }
-        
-        return ema;
+    }
+
+    // EMAs for `count` periods in one pass over the prices, bit-identical
+    // to calling calculateEMA() once per period. The result is
+    // period-major: row k (`size` values) belongs to periods[k].
+    static std::vector<double> calculateEMAMany(const std::vector<double>& prices, const std::vector<int>& periods) {
+        std::vector<double> out(periods.size() * prices.size());
+        calculateEMAMany(prices.data(), prices.size(), periods.data(), periods.size(), out.data());
+        return out;
+    }
+
+    static void calculateEMAMany(const double* prices, size_t size, const int* periods, size_t count, double* out) {
+        Arena::Scope scratch;
+        double** rows = scratch.allocate<double*>(count);
+        for (size_t k = 0; k < count; ++k) rows[k] = out + k * size;
+        calculateEMAMany(prices, size, periods, count, rows);
+    }
+
+    // Same, writing periods[k] to rows[k]. Every period is a lane of
+    // VectorKernels::emaLanes, whose output is transposed into the rows a
+    // tile at a time.
+    static void calculateEMAMany(const double* prices, size_t size, const int* periods, size_t count,
+                                 double* const* rows) {
+        Arena::Scope scratch;
+        // Lanes are the computable periods in ascending order, so they join
+        // the pass one after another as it reaches each seed.
+        size_t* order = scratch.allocate<size_t>(count);
+        size_t lanes = 0;
+        for (size_t k = 0; k < count; ++k) {
+            if (periods[k] > 0 && size >= static_cast<size_t>(periods[k])) {
+                order[lanes++] = k;
+            } else {
+                std::fill(rows[k], rows[k] + size, 0.0);
+            }
+        }
+        if (lanes == 0) return;
+        std::sort(order, order + lanes, [periods](size_t a, size_t b) { return periods[a] < periods[b]; });
+
+        double* multiplier = scratch.allocate<double>(lanes);
+        double* state = scratch.allocate<double>(lanes);
+        double* seed = scratch.allocate<double>(lanes);
+        double sum = 0.0;
+        for (size_t i = 0, j = 0; j < lanes; ++i) {
+            sum += prices[i];
+            for (; j < lanes && static_cast<size_t>(periods[order[j]]) == i + 1; ++j) {
+                int period = periods[order[j]];
+                multiplier[j] = 2.0 / (period + 1.0);
+                seed[j] = sum / period;
+            }
+        }
+
+        size_t tileBars = std::max<size_t>(16, VectorKernels::laneTile / lanes);
+        double* tile = scratch.allocate<double>(tileBars * lanes);
+        size_t started = 0;
+        for (size_t bar = static_cast<size_t>(periods[order[0]]); bar < size;) {
+            for (; started < lanes && static_cast<size_t>(periods[order[started]]) == bar; ++started) {
+                state[started] = seed[started];
+            }
+            size_t end = std::min(size, bar + tileBars);
+            if (started < lanes) end = std::min(end, static_cast<size_t>(periods[order[started]]));
+
+            VectorKernels::emaLanes(prices + bar, end - bar, multiplier, state, started, tile);
+            for (size_t j = 0; j < started; ++j) {
+                double* row = rows[order[j]] + bar;
+                for (size_t b = 0; b < end - bar; ++b) row[b] = tile[b * started + j];
+            }
+            bar = end;
+        }
+        for (size_t j = 0; j < lanes; ++j) {
+            double* row = rows[order[j]];
+            int period = periods[order[j]];
+            std::fill(row, row + period - 1, 0.0);
+            row[period - 1] = seed[j];
+        }
+    }
+};
+
+// Streaming counterpart of MovingAverage::calculateSMA: O(1) work per bar.
+// The running sum is recomputed from the window once every `period` bars so
+// rounding error cannot accumulate over long sessions. A period of 0 or
+// less is never ready and yields 0, like the batch version.
+class SMAStream {
+private:
+    int period;
+    std::vector<double> window;
+    size_t head = 0;
+    size_t count = 0;
+    size_t sinceResync = 0;
+    double sum = 0.0;
+    double current = 0.0;
+
+public:
+    explicit SMAStream(int period = 20)
+        : period(std::max(period, 0)), window(this->period, 0.0) {}
+
+    double update(const Candle& candle) {
+        return update(candle.close);
+    }
+
+    double update(double price) {
+        if (period == 0) return current;
+        if (count < static_cast<size_t>(period)) {
+            sum += price;
+            window[head] = price;
+            ++count;
+        } else {
+            sum += price - window[head];
+            window[head] = price;
+            if (++sinceResync == static_cast<size_t>(period)) {
+                sum = std::accumulate(window.begin(), window.end(), 0.0);
+                sinceResync = 0;
+            }
+        }
+        head = (head + 1) % period;
+
+        if (ready()) current = sum / period;
+        return current;
+    }
+
+    bool ready() const { return period > 0 && count >= static_cast<size_t>(period); }
+    double value() const { return current; }
+
+    void reset() {
+        std::fill(window.begin(), window.end(), 0.0);
+        head = count = sinceResync = 0;
+        sum = current = 0.0;
+    }
+};
+
+// Streaming counterpart of MovingAverage::calculateEMA. Emits 0 until
+// `period` prices have been seen, then seeds with their SMA exactly like the
+// batch version, so both produce identical values bar for bar.
+class EMAStream {
+private:
+    int period;
+    double multiplier;
+    size_t count = 0;
+    double seedSum = 0.0;
+    double current = 0.0;
+
+public:
+    explicit EMAStream(int period = 20)
+        : period(period), multiplier(2.0 / (period + 1.0)) {}
+
+    double update(const Candle& candle) {
+        return update(candle.close);
+    }
+
+    double update(double price) {
+        ++count;
+        if (count < static_cast<size_t>(period)) {
+            seedSum += price;
+        } else if (count == static_cast<size_t>(period)) {
+            seedSum += price;
+            current = seedSum / period;
+        } else {
+            current = (price - current) * multiplier + current;
+        }
+        return current;
+    }
+
+    bool ready() const { return count >= static_cast<size_t>(period); }
+    double value() const { return current; }
+
+    void reset() {
+        count = 0;
+        seedSum = current = 0.0;
     }
 };
\ No newline at end of file
@@ -1,27 +1,34 @@
 #pragma once
 #include <vector>
 #include <cmath>
+#include <numeric>
+#include <algorithm>
+#include "VectorKernels.hpp"
+#include "../utils/Arena.hpp"
+#include "../models/Candle.hpp"
 
 class RSI {
 public:
     static std::vector<double> calculate(const std::vector<double>& prices, int period = 14) {
-        std::vector<double> rsi(prices.size());
-        std::vector<double> gains;
-        std::vector<double> losses;
+        return calculate(prices.data(), prices.size(), period);
+    }
+
+    static std::vector<double> calculate(const double* prices, size_t size, int period = 14) {
+        std::vector<double> rsi(size);
+        if (period <= 0 || size <= static_cast<size_t>(period)) return rsi;
+        Arena::Scope scratch;
+        double* gains = scratch.allocate<double>(size - 1);
+        double* losses = scratch.allocate<double>(size - 1);
         
         // Calculate price changes
-        for (size_t i = 1; i < prices.size(); ++i) {
-            double change = prices[i] - prices[i-1];
-            gains.push_back(std::max(change, 0.0));
-            losses.push_back(std::max(-change, 0.0));
-        }
+        VectorKernels::gainLoss(prices, size, gains, losses);
         
         // Calculate initial averages
-        double avgGain = std::accumulate(gains.begin(), gains.begin() + period, 0.0) / period;
-        double avgLoss = std::accumulate(losses.begin(), losses.begin() + period, 0.0) / period;
+        double avgGain = std::accumulate(gains, gains + period, 0.0) / period;
+        double avgLoss = std::accumulate(losses, losses + period, 0.0) / period;
         
         // Calculate RSI
-        for (size_t i = period; i < prices.size(); ++i) {
+        for (size_t i = period; i < size; ++i) {
             avgGain = (avgGain * (period - 1) + gains[i-1]) / period;
             avgLoss = (avgLoss * (period - 1) + losses[i-1]) / period;
             
@@ -31,4 +38,148 @@ public:
         
         return rsi;
     }
+
+    // RSI for `count` periods in one pass over the prices, bit-identical to
+    // calling calculate() once per period. The result is period-major:
+    // row k (`size` values) belongs to periods[k].
+    static std::vector<double> calculateMany(const std::vector<double>& prices, const std::vector<int>& periods) {
+        std::vector<double> out(periods.size() * prices.size());
+        calculateMany(prices.data(), prices.size(), periods.data(), periods.size(), out.data());
+        return out;
+    }
+
+    static void calculateMany(const double* prices, size_t size, const int* periods, size_t count, double* out) {
+        Arena::Scope scratch;
+        double** rows = scratch.allocate<double*>(count);
+        for (size_t k = 0; k < count; ++k) rows[k] = out + k * size;
+        calculateMany(prices, size, periods, count, rows);
+    }
+
+    // Same, writing periods[k] to rows[k]. The gains and losses are
+    // computed once; every period is a lane of VectorKernels::rsiLanes,
+    // whose output is transposed into the rows a tile at a time.
+    static void calculateMany(const double* prices, size_t size, const int* periods, size_t count,
+                              double* const* rows) {
+        Arena::Scope scratch;
+        // Lanes are the computable periods in ascending order, so they join
+        // the pass one after another as it reaches each period.
+        size_t* order = scratch.allocate<size_t>(count);
+        size_t lanes = 0;
+        for (size_t k = 0; k < count; ++k) {
+            if (periods[k] > 0 && size > static_cast<size_t>(periods[k])) {
+                order[lanes++] = k;
+            } else {
+                std::fill(rows[k], rows[k] + size, 0.0);
+            }
+        }
+        if (lanes == 0) return;
+        std::sort(order, order + lanes, [periods](size_t a, size_t b) { return periods[a] < periods[b]; });
+
+        double* period = scratch.allocate<double>(lanes);
+        double* avgGain = scratch.allocate<double>(lanes);
+        double* avgLoss = scratch.allocate<double>(lanes);
+        for (size_t j = 0; j < lanes; ++j) period[j] = periods[order[j]];
+
+        double* gains = scratch.allocate<double>(size - 1);
+        double* losses = scratch.allocate<double>(size - 1);
+        VectorKernels::gainLoss(prices, size, gains, losses);
+
+        // Seed averages from running sums, which add in std::accumulate's order.
+        double* seedGain = scratch.allocate<double>(lanes);
+        double* seedLoss = scratch.allocate<double>(lanes);
+        double sumGain = 0.0;
+        double sumLoss = 0.0;
+        for (size_t i = 0, j = 0; j < lanes; ++i) {
+            sumGain += gains[i];
+            sumLoss += losses[i];
+            for (; j < lanes && period[j] == i + 1; ++j) {
+                seedGain[j] = sumGain / period[j];
+                seedLoss[j] = sumLoss / period[j];
+            }
+        }
+
+        size_t tileBars = std::max<size_t>(16, VectorKernels::laneTile / lanes);
+        double* tile = scratch.allocate<double>(tileBars * lanes);
+        size_t started = 0;
+        for (size_t bar = static_cast<size_t>(period[0]); bar < size;) {
+            for (; started < lanes && period[started] == bar; ++started) {
+                avgGain[started] = seedGain[started];
+                avgLoss[started] = seedLoss[started];
+            }
+            size_t end = std::min(size, bar + tileBars);
+            if (started < lanes) end = std::min(end, static_cast<size_t>(period[started]));
+
+            VectorKernels::rsiLanes(gains + bar - 1, losses + bar - 1, end - bar, period,
+                                    avgGain, avgLoss, started, tile);
+            for (size_t j = 0; j < started; ++j) {
+                double* row = rows[order[j]] + bar;
+                for (size_t b = 0; b < end - bar; ++b) row[b] = tile[b * started + j];
+            }
+            bar = end;
+        }
+        for (size_t j = 0; j < lanes; ++j) {
+            std::fill(rows[order[j]], rows[order[j]] + periods[order[j]], 0.0);
+        }
+    }
+};
+
+// Streaming counterpart of RSI::calculate. Keeps Wilder's running averages
+// and reproduces the batch seeding (the first smoothed value re-applies the
+// last change of the seed window), so values match the batch series exactly.
+class RSIStream {
+private:
+    int period;
+    size_t changes = 0;
+    bool hasPrevious = false;
+    double previous = 0.0;
+    double avgGain = 0.0;
+    double avgLoss = 0.0;
+    double current = 0.0;
+
+public:
+    explicit RSIStream(int period = 14) : period(period) {}
+
+    double update(const Candle& candle) {
+        return update(candle.close);
+    }
+
+    double update(double price) {
+        if (!hasPrevious) {
+            hasPrevious = true;
+            previous = price;
+            return current;
+        }
+
+        double change = price - previous;
+        previous = price;
+        double gain = std::max(change, 0.0);
+        double loss = std::max(-change, 0.0);
+        ++changes;
+
+        if (changes < static_cast<size_t>(period)) {
+            avgGain += gain;
+            avgLoss += loss;
+            return current;
+        }
+        if (changes == static_cast<size_t>(period)) {
+            avgGain = (avgGain + gain) / period;
+            avgLoss = (avgLoss + loss) / period;
+        }
+
+        avgGain = (avgGain * (period - 1) + gain) / period;
+        avgLoss = (avgLoss * (period - 1) + loss) / period;
+
+        double rs = avgGain / (avgLoss > 0 ? avgLoss : 1e-10);
+        current = 100.0 - (100.0 / (1.0 + rs));
+        return current;
+    }
+
+    bool ready() const { return changes >= static_cast<size_t>(period); }
+    double value() const { return current; }
+
+    void reset() {
+        changes = 0;
+        hasPrevious = false;
+        previous = avgGain = avgLoss = current = 0.0;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+// Fixed-size sliding window with O(1) mean / population variance updates.
+//
+// Once the window is full every push replaces the oldest value using the
+// sliding form of Welford's update:
+//     mean' = mean + (x_new - x_old) / n
+//     M2'   = M2 + (x_new - x_old) * (x_new - mean' + x_old - mean)
+// Every `period` pushes (and on the first full window) mean and M2 are
+// recomputed exactly with a two-pass sum over the window, newest value first,
+// which is the same order the original Bollinger Bands loop used. Rounding
+// error therefore never spans more than `period` incremental updates and the
+// amortized cost stays O(1) per push. On a random walk around 45000 the
+// bands stay within 1e-9 standard deviations of the two-pass result at
+// periods 20 to 2000 (bench/bollinger_bench checks this); the error grows as
+// the deviation shrinks relative to the price level.
+//
+// A period of 0 or less, like in the batch calculations, gives a window
+// that is never full and whose statistics stay 0.
+class RollingStats {
+private:
+    int period;
+    std::vector<double> window;
+    size_t head = 0;
+    size_t count = 0;
+    size_t sinceResync = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void resync() {
+        double sum = 0.0;
+        for (int j = 0; j < period; ++j) {
+            sum += window[(head + period - 1 - j) % period];
+        }
+        mean = sum / period;
+
+        double squares = 0.0;
+        for (int j = 0; j < period; ++j) {
+            double d = window[(head + period - 1 - j) % period] - mean;
+            squares += d * d;
+        }
+        m2 = squares;
+        sinceResync = 0;
+    }
+
+public:
+    explicit RollingStats(int period)
+        : period(std::max(period, 0)), window(this->period, 0.0) {}
+
+    void push(double value) {
+        if (period == 0) return;
+        if (count < static_cast<size_t>(period)) {
+            window[head] = value;
+            head = (head + 1) % period;
+            if (++count == static_cast<size_t>(period)) resync();
+            return;
+        }
+
+        double oldest = window[head];
+        window[head] = value;
+        head = (head + 1) % period;
+
+        if (++sinceResync == static_cast<size_t>(period)) {
+            resync();
+            return;
+        }
+
+        double delta = value - oldest;
+        double oldMean = mean;
+        mean += delta / period;
+        m2 += delta * (value - mean + oldest - oldMean);
+        if (m2 < 0.0) m2 = 0.0;
+    }
+
+    // Changes the window length and empties it, reusing the window's storage
+    // when it is already large enough.
+    void setPeriod(int newPeriod) {
+        period = std::max(newPeriod, 0);
+        window.assign(period, 0.0);
+        head = count = sinceResync = 0;
+        mean = m2 = 0.0;
+    }
+
+    bool full() const { return period > 0 && count >= static_cast<size_t>(period); }
+    double average() const { return mean; }
+    double variance() const { return period > 0 ? m2 / period : 0.0; }
+    double stdDev() const { return std::sqrt(variance()); }
+
+    void reset() {
+        std::fill(window.begin(), window.end(), 0.0);
+        head = count = sinceResync = 0;
+        mean = m2 = 0.0;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,415 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define VECTOR_KERNELS_X86 1
+// AVX-512F implies FMA, and GCC contracts a * b + c into it by default in
+// C++; contraction is switched off so every level rounds alike.
+#define VECTOR_KERNELS_TARGET(isa) __attribute__((target(isa), optimize("fp-contract=off")))
+#endif
+
+// Element-wise passes shared by the batch indicators and strategies, with
+// AVX2 and AVX-512 implementations chosen at runtime from CPU features.
+//
+// The instruction set is detected once, on first use, and can be capped with
+// the TRADINALGO_SIMD environment variable (scalar, avx2, avx512) or with
+// setLevel(). Every implementation performs the same IEEE operations in the
+// same order as the scalar loop (no FMA contraction), so results are
+// bit-identical whichever level runs. Loads are unaligned; on the 64-byte
+// aligned CandleStore columns they run at full aligned speed.
+class VectorKernels {
+public:
+    enum class Level { Scalar, AVX2, AVX512 };
+
+    // out[i] = a[i] - b[i]
+    static void subtract(const double* a, const double* b, double* out, size_t n) {
+        table().subtract(a, b, out, n);
+    }
+
+    // For i in [1, n): gains[i-1] = max(p[i] - p[i-1], 0), losses[i-1] = max(p[i-1] - p[i], 0)
+    static void gainLoss(const double* prices, size_t n, double* gains, double* losses) {
+        table().gainLoss(prices, n, gains, losses);
+    }
+
+    // upper[i] = middle[i] + k * stdDev[i], lower[i] = middle[i] - k * stdDev[i].
+    // stdDev may alias upper or lower.
+    static void bands(const double* middle, const double* stdDev, double k,
+                      double* upper, double* lower, size_t n) {
+        table().bands(middle, stdDev, k, upper, lower, n);
+    }
+
+    // out[i] = (price[i] - lower[i]) / (upper[i] - lower[i])
+    static void percentB(const double* price, const double* upper, const double* lower,
+                         double* out, size_t n) {
+        table().percentB(price, upper, lower, out, n);
+    }
+
+    // Values per block of lane output (256 KB) that the multi-period
+    // indicators transpose into their rows while it is still in L2. Big
+    // enough that each row gets a run of a few KB per block: with dozens of
+    // rows, shorter runs leave too many output streams for the hardware
+    // prefetchers and every store waits on its cache line.
+    static constexpr size_t laneTile = 32768;
+
+    // Lane-parallel recurrences behind the multi-period indicators: `lanes`
+    // independent series advance together, one bar per step, so the
+    // dependency chain of one period overlaps with the others instead of
+    // bounding the loop. Bar b of lane l is written to out[b * lanes + l].
+
+    // state[l] = (prices[b] - state[l]) * multiplier[l] + state[l]
+    static void emaLanes(const double* prices, size_t bars, const double* multiplier,
+                         double* state, size_t lanes, double* out) {
+        table().emaLanes(prices, bars, multiplier, state, lanes, out);
+    }
+
+    // Wilder smoothing of gains and losses with period[l], emitting
+    // 100 - 100 / (1 + avgGain / avgLoss) with avgLoss floored at 1e-10.
+    static void rsiLanes(const double* gains, const double* losses, size_t bars, const double* period,
+                         double* avgGain, double* avgLoss, size_t lanes, double* out) {
+        table().rsiLanes(gains, losses, bars, period, avgGain, avgLoss, lanes, out);
+    }
+
+    static Level level() { return table().level; }
+
+    // Best level this CPU supports, ignoring any override.
+    static Level detect() {
+#ifdef VECTOR_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return Level::AVX512;
+        if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+#endif
+        return Level::Scalar;
+    }
+
+    // Selects `requested`, clamped to what the CPU supports. Returns the
+    // level actually in use.
+    static Level setLevel(Level requested) {
+        Level chosen = std::min(requested, detect());
+        slot().store(&tableFor(chosen), std::memory_order_release);
+        return chosen;
+    }
+
+    static const char* name(Level l) {
+        switch (l) {
+            case Level::AVX512: return "avx512";
+            case Level::AVX2: return "avx2";
+            case Level::Scalar: break;
+        }
+        return "scalar";
+    }
+
+private:
+    struct Table {
+        Level level;
+        void (*subtract)(const double*, const double*, double*, size_t);
+        void (*gainLoss)(const double*, size_t, double*, double*);
+        void (*bands)(const double*, const double*, double, double*, double*, size_t);
+        void (*percentB)(const double*, const double*, const double*, double*, size_t);
+        void (*emaLanes)(const double*, size_t, const double*, double*, size_t, double*);
+        void (*rsiLanes)(const double*, const double*, size_t, const double*, double*, double*, size_t, double*);
+    };
+
+    static std::atomic<const Table*>& slot() {
+        static std::atomic<const Table*> current{nullptr};
+        return current;
+    }
+
+    static const Table& table() {
+        const Table* t = slot().load(std::memory_order_acquire);
+        if (!t) {
+            setLevel(requestedLevel());
+            t = slot().load(std::memory_order_acquire);
+        }
+        return *t;
+    }
+
+    static Level requestedLevel() {
+        const char* env = std::getenv("TRADINALGO_SIMD");
+        if (!env) return Level::AVX512;
+        if (std::strcmp(env, "scalar") == 0) return Level::Scalar;
+        if (std::strcmp(env, "avx2") == 0) return Level::AVX2;
+        return Level::AVX512;
+    }
+
+    static const Table& tableFor(Level l) {
+        static const Table scalar{Level::Scalar, subtractScalar, gainLossScalar, bandsScalar, percentBScalar,
+                                  emaLanesScalar, rsiLanesScalar};
+#ifdef VECTOR_KERNELS_X86
+        static const Table avx2{Level::AVX2, subtractAVX2, gainLossAVX2, bandsAVX2, percentBAVX2,
+                                emaLanesAVX2, rsiLanesAVX2};
+        static const Table avx512{Level::AVX512, subtractAVX512, gainLossAVX512, bandsAVX512, percentBAVX512,
+                                  emaLanesAVX512, rsiLanesAVX512};
+        if (l == Level::AVX512) return avx512;
+        if (l == Level::AVX2) return avx2;
+#endif
+        (void)l;
+        return scalar;
+    }
+
+    // Scalar reference implementations; the vector loops below finish their
+    // tails with these.
+    static void subtractScalar(const double* a, const double* b, double* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = a[i] - b[i];
+    }
+
+    static void gainLossScalar(const double* prices, size_t n, double* gains, double* losses) {
+        for (size_t i = 1; i < n; ++i) {
+            double change = prices[i] - prices[i-1];
+            gains[i-1] = std::max(change, 0.0);
+            losses[i-1] = std::max(-change, 0.0);
+        }
+    }
+
+    static void bandsScalar(const double* middle, const double* stdDev, double k,
+                            double* upper, double* lower, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            double width = k * stdDev[i];
+            double mid = middle[i];
+            upper[i] = mid + width;
+            lower[i] = mid - width;
+        }
+    }
+
+    static void percentBScalar(const double* price, const double* upper, const double* lower,
+                               double* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = (price[i] - lower[i]) / (upper[i] - lower[i]);
+    }
+
+    // The *From variants start at lane `first` so the vector versions can
+    // finish the lanes past their last full register with them.
+    static void emaLanesScalar(const double* prices, size_t bars, const double* multiplier,
+                               double* state, size_t lanes, double* out) {
+        emaLanesFrom(0, prices, bars, multiplier, state, lanes, out);
+    }
+
+    static void emaLanesFrom(size_t first, const double* prices, size_t bars, const double* multiplier,
+                             double* state, size_t lanes, double* out) {
+        for (size_t b = 0; b < bars; ++b) {
+            double price = prices[b];
+            double* row = out + b * lanes;
+            for (size_t l = first; l < lanes; ++l) {
+                state[l] = (price - state[l]) * multiplier[l] + state[l];
+                row[l] = state[l];
+            }
+        }
+    }
+
+    static void rsiLanesScalar(const double* gains, const double* losses, size_t bars, const double* period,
+                               double* avgGain, double* avgLoss, size_t lanes, double* out) {
+        rsiLanesFrom(0, gains, losses, bars, period, avgGain, avgLoss, lanes, out);
+    }
+
+    static void rsiLanesFrom(size_t first, const double* gains, const double* losses, size_t bars,
+                             const double* period, double* avgGain, double* avgLoss, size_t lanes, double* out) {
+        for (size_t b = 0; b < bars; ++b) {
+            double* row = out + b * lanes;
+            for (size_t l = first; l < lanes; ++l) {
+                avgGain[l] = (avgGain[l] * (period[l] - 1) + gains[b]) / period[l];
+                avgLoss[l] = (avgLoss[l] * (period[l] - 1) + losses[b]) / period[l];
+                double rs = avgGain[l] / (avgLoss[l] > 0 ? avgLoss[l] : 1e-10);
+                row[l] = 100.0 - (100.0 / (1.0 + rs));
+            }
+        }
+    }
+
+#ifdef VECTOR_KERNELS_X86
+    // max_pd(0, x) returns x unless 0 > x, matching std::max(x, 0.0) for
+    // negative zero and NaN as well.
+    VECTOR_KERNELS_TARGET("avx2")
+    static void subtractAVX2(const double* a, const double* b, double* out, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        }
+        subtractScalar(a + i, b + i, out + i, n - i);
+    }
+
+    VECTOR_KERNELS_TARGET("avx2")
+    static void gainLossAVX2(const double* prices, size_t n, double* gains, double* losses) {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d sign = _mm256_set1_pd(-0.0);
+        size_t i = 1;
+        for (; i + 4 <= n; i += 4) {
+            __m256d change = _mm256_sub_pd(_mm256_loadu_pd(prices + i), _mm256_loadu_pd(prices + i - 1));
+            _mm256_storeu_pd(gains + i - 1, _mm256_max_pd(zero, change));
+            _mm256_storeu_pd(losses + i - 1, _mm256_max_pd(zero, _mm256_xor_pd(change, sign)));
+        }
+        if (i < n) gainLossScalar(prices + i - 1, n - i + 1, gains + i - 1, losses + i - 1);
+    }
+
+    VECTOR_KERNELS_TARGET("avx2")
+    static void bandsAVX2(const double* middle, const double* stdDev, double k,
+                          double* upper, double* lower, size_t n) {
+        const __m256d factor = _mm256_set1_pd(k);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d width = _mm256_mul_pd(factor, _mm256_loadu_pd(stdDev + i));
+            __m256d mid = _mm256_loadu_pd(middle + i);
+            _mm256_storeu_pd(upper + i, _mm256_add_pd(mid, width));
+            _mm256_storeu_pd(lower + i, _mm256_sub_pd(mid, width));
+        }
+        bandsScalar(middle + i, stdDev + i, k, upper + i, lower + i, n - i);
+    }
+
+    VECTOR_KERNELS_TARGET("avx2")
+    static void percentBAVX2(const double* price, const double* upper, const double* lower,
+                             double* out, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d lo = _mm256_loadu_pd(lower + i);
+            __m256d num = _mm256_sub_pd(_mm256_loadu_pd(price + i), lo);
+            __m256d den = _mm256_sub_pd(_mm256_loadu_pd(upper + i), lo);
+            _mm256_storeu_pd(out + i, _mm256_div_pd(num, den));
+        }
+        percentBScalar(price + i, upper + i, lower + i, out + i, n - i);
+    }
+
+    // Bars run in the outer loop so every register of lanes is an
+    // independent chain; the state round-trips through L1 between bars.
+    VECTOR_KERNELS_TARGET("avx2")
+    static void emaLanesAVX2(const double* prices, size_t bars, const double* multiplier,
+                             double* state, size_t lanes, double* out) {
+        size_t vectorLanes = lanes & ~size_t(3);
+        for (size_t b = 0; b < bars; ++b) {
+            __m256d price = _mm256_set1_pd(prices[b]);
+            double* row = out + b * lanes;
+            for (size_t l = 0; l < vectorLanes; l += 4) {
+                __m256d s = _mm256_loadu_pd(state + l);
+                s = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(price, s), _mm256_loadu_pd(multiplier + l)), s);
+                _mm256_storeu_pd(state + l, s);
+                _mm256_storeu_pd(row + l, s);
+            }
+        }
+        if (vectorLanes < lanes) emaLanesFrom(vectorLanes, prices, bars, multiplier, state, lanes, out);
+    }
+
+    VECTOR_KERNELS_TARGET("avx2")
+    static void rsiLanesAVX2(const double* gains, const double* losses, size_t bars, const double* period,
+                             double* avgGain, double* avgLoss, size_t lanes, double* out) {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d hundred = _mm256_set1_pd(100.0);
+        const __m256d floor = _mm256_set1_pd(1e-10);
+        size_t vectorLanes = lanes & ~size_t(3);
+        for (size_t b = 0; b < bars; ++b) {
+            __m256d gain = _mm256_set1_pd(gains[b]);
+            __m256d loss = _mm256_set1_pd(losses[b]);
+            double* row = out + b * lanes;
+            for (size_t l = 0; l < vectorLanes; l += 4) {
+                __m256d p = _mm256_loadu_pd(period + l);
+                __m256d keep = _mm256_sub_pd(p, one);
+                __m256d g = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(avgGain + l), keep), gain), p);
+                __m256d d = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(avgLoss + l), keep), loss), p);
+                _mm256_storeu_pd(avgGain + l, g);
+                _mm256_storeu_pd(avgLoss + l, d);
+                __m256d rs = _mm256_div_pd(g, _mm256_blendv_pd(floor, d, _mm256_cmp_pd(d, zero, _CMP_GT_OQ)));
+                _mm256_storeu_pd(row + l, _mm256_sub_pd(hundred, _mm256_div_pd(hundred, _mm256_add_pd(one, rs))));
+            }
+        }
+        if (vectorLanes < lanes) rsiLanesFrom(vectorLanes, gains, losses, bars, period, avgGain, avgLoss, lanes, out);
+    }
+
+    // GCC 12 flags the undefined passthrough operand inside _mm512_max_pd.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    VECTOR_KERNELS_TARGET("avx512f")
+    static void subtractAVX512(const double* a, const double* b, double* out, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm512_storeu_pd(out + i, _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+        }
+        subtractScalar(a + i, b + i, out + i, n - i);
+    }
+
+    VECTOR_KERNELS_TARGET("avx512f")
+    static void gainLossAVX512(const double* prices, size_t n, double* gains, double* losses) {
+        const __m512d zero = _mm512_setzero_pd();
+        const __m512i sign = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull));
+        size_t i = 1;
+        for (; i + 8 <= n; i += 8) {
+            __m512d change = _mm512_sub_pd(_mm512_loadu_pd(prices + i), _mm512_loadu_pd(prices + i - 1));
+            __m512d negated = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(change), sign));
+            _mm512_storeu_pd(gains + i - 1, _mm512_max_pd(zero, change));
+            _mm512_storeu_pd(losses + i - 1, _mm512_max_pd(zero, negated));
+        }
+        if (i < n) gainLossScalar(prices + i - 1, n - i + 1, gains + i - 1, losses + i - 1);
+    }
+
+    VECTOR_KERNELS_TARGET("avx512f")
+    static void bandsAVX512(const double* middle, const double* stdDev, double k,
+                            double* upper, double* lower, size_t n) {
+        const __m512d factor = _mm512_set1_pd(k);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m512d width = _mm512_mul_pd(factor, _mm512_loadu_pd(stdDev + i));
+            __m512d mid = _mm512_loadu_pd(middle + i);
+            _mm512_storeu_pd(upper + i, _mm512_add_pd(mid, width));
+            _mm512_storeu_pd(lower + i, _mm512_sub_pd(mid, width));
+        }
+        bandsScalar(middle + i, stdDev + i, k, upper + i, lower + i, n - i);
+    }
+
+    VECTOR_KERNELS_TARGET("avx512f")
+    static void percentBAVX512(const double* price, const double* upper, const double* lower,
+                               double* out, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m512d lo = _mm512_loadu_pd(lower + i);
+            __m512d num = _mm512_sub_pd(_mm512_loadu_pd(price + i), lo);
+            __m512d den = _mm512_sub_pd(_mm512_loadu_pd(upper + i), lo);
+            _mm512_storeu_pd(out + i, _mm512_div_pd(num, den));
+        }
+        percentBScalar(price + i, upper + i, lower + i, out + i, n - i);
+    }
+
+    VECTOR_KERNELS_TARGET("avx512f")
+    static void emaLanesAVX512(const double* prices, size_t bars, const double* multiplier,
+                               double* state, size_t lanes, double* out) {
+        size_t vectorLanes = lanes & ~size_t(7);
+        for (size_t b = 0; b < bars; ++b) {
+            __m512d price = _mm512_set1_pd(prices[b]);
+            double* row = out + b * lanes;
+            for (size_t l = 0; l < vectorLanes; l += 8) {
+                __m512d s = _mm512_loadu_pd(state + l);
+                s = _mm512_add_pd(_mm512_mul_pd(_mm512_sub_pd(price, s), _mm512_loadu_pd(multiplier + l)), s);
+                _mm512_storeu_pd(state + l, s);
+                _mm512_storeu_pd(row + l, s);
+            }
+        }
+        if (vectorLanes < lanes) emaLanesFrom(vectorLanes, prices, bars, multiplier, state, lanes, out);
+    }
+
+    VECTOR_KERNELS_TARGET("avx512f")
+    static void rsiLanesAVX512(const double* gains, const double* losses, size_t bars, const double* period,
+                               double* avgGain, double* avgLoss, size_t lanes, double* out) {
+        const __m512d zero = _mm512_setzero_pd();
+        const __m512d one = _mm512_set1_pd(1.0);
+        const __m512d hundred = _mm512_set1_pd(100.0);
+        const __m512d floor = _mm512_set1_pd(1e-10);
+        size_t vectorLanes = lanes & ~size_t(7);
+        for (size_t b = 0; b < bars; ++b) {
+            __m512d gain = _mm512_set1_pd(gains[b]);
+            __m512d loss = _mm512_set1_pd(losses[b]);
+            double* row = out + b * lanes;
+            for (size_t l = 0; l < vectorLanes; l += 8) {
+                __m512d p = _mm512_loadu_pd(period + l);
+                __m512d keep = _mm512_sub_pd(p, one);
+                __m512d g = _mm512_div_pd(_mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(avgGain + l), keep), gain), p);
+                __m512d d = _mm512_div_pd(_mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(avgLoss + l), keep), loss), p);
+                _mm512_storeu_pd(avgGain + l, g);
+                _mm512_storeu_pd(avgLoss + l, d);
+                __mmask8 positive = _mm512_cmp_pd_mask(d, zero, _CMP_GT_OQ);
+                __m512d rs = _mm512_div_pd(g, _mm512_mask_blend_pd(positive, floor, d));
+                _mm512_storeu_pd(row + l, _mm512_sub_pd(hundred, _mm512_div_pd(hundred, _mm512_add_pd(one, rs))));
+            }
+        }
+        if (vectorLanes < lanes) rsiLanesFrom(vectorLanes, gains, losses, bars, period, avgGain, avgLoss, lanes, out);
+    }
+#pragma GCC diagnostic pop
+#endif
+};
\ No newline at end of file
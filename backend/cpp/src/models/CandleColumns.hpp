@@ -0,0 +1,83 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
+#include "Candle.hpp"
+
+static_assert(sizeof(std::time_t) == sizeof(double),
+              "CandleColumns addresses every column with one stride");
+
+// Read-only structure-of-arrays view over a candle series.
+//
+// Each column is addressed as base + index * stride bytes, so the same view
+// covers columnar storage (stride = 8, e.g. a mapped CandleStore) and an
+// ordinary Candle array (stride = sizeof(Candle)) without copying either.
+// Timestamps are expected in ascending order for the time-range lookups.
+struct CandleColumns {
+    const std::time_t* timestamp = nullptr;
+    const double* open = nullptr;
+    const double* high = nullptr;
+    const double* low = nullptr;
+    const double* close = nullptr;
+    const double* volume = nullptr;
+    size_t size = 0;
+    size_t stride = sizeof(double);
+
+    static CandleColumns fromCandles(const Candle* candles, size_t size) {
+        if (size == 0) return CandleColumns();
+        return {
+            &candles->timestamp, &candles->open, &candles->high,
+            &candles->low, &candles->close, &candles->volume,
+            size, sizeof(Candle)
+        };
+    }
+
+    // True when every column is a dense array that can be handed to the
+    // batch indicators as a plain double*.
+    bool contiguous() const { return stride == sizeof(double); }
+
+    template <typename T>
+    const T& at(const T* column, size_t i) const {
+        return *reinterpret_cast<const T*>(reinterpret_cast<const char*>(column) + i * stride);
+    }
+
+    std::time_t timestampAt(size_t i) const { return at(timestamp, i); }
+    double closeAt(size_t i) const { return at(close, i); }
+
+    Candle operator[](size_t i) const {
+        return {at(timestamp, i), at(open, i), at(high, i), at(low, i), at(close, i), at(volume, i)};
+    }
+
+    // Bars [begin, end), clamped to the series.
+    CandleColumns slice(size_t begin, size_t end) const {
+        end = std::min(end, size);
+        begin = std::min(begin, end);
+        if (begin == end) return CandleColumns();
+        return {
+            &at(timestamp, begin), &at(open, begin), &at(high, begin),
+            &at(low, begin), &at(close, begin), &at(volume, begin),
+            end - begin, stride
+        };
+    }
+
+    // Index of the first bar with timestamp >= t (binary search).
+    size_t lowerBound(std::time_t t) const {
+        size_t first = 0;
+        size_t count = size;
+        while (count > 0) {
+            size_t half = count / 2;
+            if (timestampAt(first + half) < t) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first;
+    }
+
+    // Bars whose timestamp lies in [from, to).
+    CandleColumns between(std::time_t from, std::time_t to) const {
+        return slice(lowerBound(from), lowerBound(to));
+    }
+};
\ No newline at end of file
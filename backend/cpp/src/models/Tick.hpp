@@ -0,0 +1,9 @@
+#pragma once
+#include <ctime>
+
+// A single trade print: the raw input that BarAggregator rolls into Candles.
+struct Tick {
+    std::time_t timestamp;
+    double price;
+    double volume;
+};
\ No newline at end of file
@@ -1,11 +1,58 @@
 #pragma once
-#include <string>
 #include <ctime>
+#include <cstdint>
+#include <type_traits>
+
+enum class TradeType : std::uint8_t {
+    Buy,
+    Sell
+};
+
+// Why a signal fired. Stored as a small ID so Trade stays trivially copyable;
+// toString maps it back to the human-readable label.
+enum class TradeReason : std::uint8_t {
+    None,
+    RSIOverbought,
+    RSIOversold,
+    MACDBullishCrossover,
+    MACDBearishCrossover,
+    BBOversold,
+    BBOverbought,
+    StopLoss,
+    TakeProfit,
+    RSIOversoldEMASupport,
+    RSIOverboughtEMAResistance
+};
+
+inline const char* toString(TradeType type) {
+    return type == TradeType::Buy ? "BUY" : "SELL";
+}
+
+inline const char* toString(TradeReason reason) {
+    switch (reason) {
+        case TradeReason::RSIOverbought: return "RSI Overbought";
+        case TradeReason::RSIOversold: return "RSI Oversold";
+        case TradeReason::MACDBullishCrossover: return "MACD Bullish Crossover";
+        case TradeReason::MACDBearishCrossover: return "MACD Bearish Crossover";
+        case TradeReason::BBOversold: return "BB Oversold";
+        case TradeReason::BBOverbought: return "BB Overbought";
+        case TradeReason::StopLoss: return "Stop Loss";
+        case TradeReason::TakeProfit: return "Take Profit";
+        case TradeReason::RSIOversoldEMASupport: return "RSI Oversold + EMA Support";
+        case TradeReason::RSIOverboughtEMAResistance: return "RSI Overbought + EMA Resistance";
+        case TradeReason::None: break;
+    }
+    return "";
+}
 
 struct Trade {
-    std::string type;        // "BUY" or "SELL"
+    TradeType type;
     std::time_t timestamp;
     double price;
     double amount;
-    std::string reason;
-};
\ No newline at end of file
+    TradeReason reason;
+};
+
+static_assert(std::is_trivially_copyable<Trade>::value &&
+              std::is_standard_layout<Trade>::value,
+              "Trade must stay a POD so signals never allocate");
\ No newline at end of file
@@ -0,0 +1,281 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../models/CandleColumns.hpp"
+
+// Binary, columnar candle file that is memory-mapped and read in place.
+//
+// Layout (host byte order, little-endian on every platform we deploy to):
+//
+//     Header (128 bytes)
+//     timestamp[count]  int64, seconds since the epoch, ascending
+//     open[count] high[count] low[count] close[count] volume[count]  double
+//
+// Every column starts on a 64-byte boundary so it can be fed to vectorized
+// indicator kernels directly. Opening a store maps the file and validates
+// the header; no candle data is read until a column is touched, so a
+// multi-year history is available in milliseconds regardless of its size.
+class CandleStore {
+public:
+    static constexpr std::uint32_t FormatVersion = 1;
+    static constexpr size_t ColumnAlignment = 64;
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t count;
+        std::uint64_t offsets[6];  // timestamp, open, high, low, close, volume
+        std::uint8_t reserved[56];
+    };
+    static_assert(sizeof(Header) == 128, "CandleStore header must stay 128 bytes");
+
+    explicit CandleStore(const std::string& path) {
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("CandleStore: cannot open " + path + ": " + std::strerror(errno));
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+            ::close(fd);
+            throw std::runtime_error("CandleStore: " + path + " is not a candle store");
+        }
+        length = static_cast<size_t>(info.st_size);
+
+        void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("CandleStore: cannot map " + path + ": " + std::strerror(errno));
+        }
+        base = static_cast<const char*>(mapped);
+
+        try {
+            validate(path);
+        } catch (...) {
+            release();
+            throw;
+        }
+
+        const Header& header = *reinterpret_cast<const Header*>(base);
+        bars.size = static_cast<size_t>(header.count);
+        bars.stride = sizeof(double);
+        if (bars.size > 0) {
+            bars.timestamp = reinterpret_cast<const std::time_t*>(base + header.offsets[0]);
+            bars.open = reinterpret_cast<const double*>(base + header.offsets[1]);
+            bars.high = reinterpret_cast<const double*>(base + header.offsets[2]);
+            bars.low = reinterpret_cast<const double*>(base + header.offsets[3]);
+            bars.close = reinterpret_cast<const double*>(base + header.offsets[4]);
+            bars.volume = reinterpret_cast<const double*>(base + header.offsets[5]);
+        }
+    }
+
+    CandleStore(const CandleStore&) = delete;
+    CandleStore& operator=(const CandleStore&) = delete;
+
+    CandleStore(CandleStore&& other) noexcept
+        : fd(other.fd), base(other.base), length(other.length), bars(other.bars) {
+        other.fd = -1;
+        other.base = nullptr;
+        other.length = 0;
+        other.bars = CandleColumns();
+    }
+
+    ~CandleStore() { release(); }
+
+    const CandleColumns& columns() const { return bars; }
+    size_t size() const { return bars.size; }
+
+    // Bars with timestamps in [from, to), found by binary search.
+    CandleColumns range(std::time_t from, std::time_t to) const {
+        return bars.between(from, to);
+    }
+
+    // Writes `candles` (timestamps ascending) as a store. The file is built
+    // under a temporary name and renamed into place, so readers never see a
+    // partially written store.
+    static void write(const std::string& path, const CandleColumns& candles) {
+        for (size_t i = 1; i < candles.size; ++i) {
+            if (candles.timestampAt(i) < candles.timestampAt(i - 1)) {
+                throw std::invalid_argument("CandleStore: timestamps must be ascending");
+            }
+        }
+
+        Header header{};
+        std::memcpy(header.magic, Magic, sizeof(header.magic));
+        header.version = FormatVersion;
+        header.headerSize = sizeof(Header);
+        header.count = candles.size;
+        size_t columnBytes = alignUp(candles.size * sizeof(double));
+        for (int c = 0; c < 6; ++c) {
+            header.offsets[c] = alignUp(sizeof(Header)) + c * columnBytes;
+        }
+
+        std::string temp = path + ".tmp";
+        FILE* file = std::fopen(temp.c_str(), "wb");
+        if (!file) throw std::runtime_error("CandleStore: cannot create " + temp + ": " + std::strerror(errno));
+
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+        ok = ok && pad(file, alignUp(sizeof(Header)) - sizeof(Header));
+
+        const void* columns[6] = {candles.timestamp, candles.open, candles.high,
+                                  candles.low, candles.close, candles.volume};
+        double chunk[4096];
+        for (int c = 0; ok && c < 6; ++c) {
+            for (size_t i = 0; ok && i < candles.size; i += 4096) {
+                size_t n = std::min<size_t>(4096, candles.size - i);
+                for (size_t j = 0; j < n; ++j) {
+                    std::memcpy(&chunk[j], &candles.at(static_cast<const double*>(columns[c]), i + j), sizeof(double));
+                }
+                ok = std::fwrite(chunk, sizeof(double), n, file) == n;
+            }
+            ok = ok && pad(file, columnBytes - candles.size * sizeof(double));
+        }
+
+        ok = (std::fflush(file) == 0) && ok;
+        ok = (::fsync(::fileno(file)) == 0) && ok;
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+            std::remove(temp.c_str());
+            throw std::runtime_error("CandleStore: failed writing " + path);
+        }
+    }
+
+    static void write(const std::string& path, const std::vector<Candle>& candles) {
+        write(path, CandleColumns::fromCandles(candles.data(), candles.size()));
+    }
+
+    // Converts a CSV of `timestamp,open,high,low,close,volume` rows into a
+    // store. Timestamps are Unix seconds, or milliseconds (detected by
+    // magnitude). A non-numeric first line is treated as a header. Rows out
+    // of time order are sorted. Returns the number of candles written.
+    static size_t convertCsv(const std::string& csvPath, const std::string& storePath) {
+        FILE* file = std::fopen(csvPath.c_str(), "r");
+        if (!file) throw std::runtime_error("CandleStore: cannot open " + csvPath + ": " + std::strerror(errno));
+
+        std::vector<std::time_t> timestamp;
+        std::vector<double> open, high, low, close, volume;
+        char line[512];
+        size_t lineNumber = 0;
+        while (std::fgets(line, sizeof(line), file)) {
+            ++lineNumber;
+            const char* p = line;
+            while (*p == ' ' || *p == '\t') ++p;
+            if (*p == '\n' || *p == '\r' || *p == '\0') continue;
+
+            char* end;
+            long long ts = std::strtoll(p, &end, 10);
+            if (end == p) {
+                if (lineNumber == 1) continue;  // header row
+                std::fclose(file);
+                throw std::runtime_error("CandleStore: bad timestamp on line " + std::to_string(lineNumber));
+            }
+            if (*end == '.') std::strtod(p, &end);  // fractional seconds are truncated
+
+            double values[5];
+            for (double& value : values) {
+                p = end;
+                while (*p == ',' || *p == ' ' || *p == '\t') ++p;
+                value = std::strtod(p, &end);
+                if (end == p) {
+                    std::fclose(file);
+                    throw std::runtime_error("CandleStore: bad value on line " + std::to_string(lineNumber));
+                }
+            }
+
+            timestamp.push_back(static_cast<std::time_t>(ts > 100000000000LL ? ts / 1000 : ts));
+            open.push_back(values[0]);
+            high.push_back(values[1]);
+            low.push_back(values[2]);
+            close.push_back(values[3]);
+            volume.push_back(values[4]);
+        }
+        std::fclose(file);
+
+        if (!std::is_sorted(timestamp.begin(), timestamp.end())) {
+            std::vector<size_t> order(timestamp.size());
+            std::iota(order.begin(), order.end(), size_t(0));
+            std::stable_sort(order.begin(), order.end(),
+                             [&](size_t a, size_t b) { return timestamp[a] < timestamp[b]; });
+            auto permute = [&order](auto& column) {
+                auto sorted = column;
+                for (size_t i = 0; i < order.size(); ++i) sorted[i] = column[order[i]];
+                column.swap(sorted);
+            };
+            permute(timestamp);
+            permute(open);
+            permute(high);
+            permute(low);
+            permute(close);
+            permute(volume);
+        }
+
+        CandleColumns columns;
+        columns.size = timestamp.size();
+        if (columns.size > 0) {
+            columns.timestamp = timestamp.data();
+            columns.open = open.data();
+            columns.high = high.data();
+            columns.low = low.data();
+            columns.close = close.data();
+            columns.volume = volume.data();
+        }
+        write(storePath, columns);
+        return columns.size;
+    }
+
+private:
+    static constexpr char Magic[8] = {'T', 'A', 'C', 'N', 'D', 'L', 'S', '1'};
+
+    static size_t alignUp(size_t bytes) {
+        return (bytes + ColumnAlignment - 1) / ColumnAlignment * ColumnAlignment;
+    }
+
+    static bool pad(FILE* file, size_t bytes) {
+        static const char zeros[ColumnAlignment] = {};
+        return bytes == 0 || std::fwrite(zeros, 1, bytes, file) == bytes;
+    }
+
+    void validate(const std::string& path) const {
+        const Header& header = *reinterpret_cast<const Header*>(base);
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 ||
+            header.headerSize != sizeof(Header)) {
+            throw std::runtime_error("CandleStore: " + path + " is not a candle store");
+        }
+        if (header.version != FormatVersion) {
+            throw std::runtime_error("CandleStore: " + path + " has unsupported version " +
+                                     std::to_string(header.version));
+        }
+        // Compared by division so a corrupt count cannot overflow the
+        // column size into a small, passing value.
+        for (std::uint64_t offset : header.offsets) {
+            if (offset % ColumnAlignment != 0 || offset > length ||
+                header.count > (length - offset) / sizeof(double)) {
+                throw std::runtime_error("CandleStore: " + path + " is truncated or corrupt");
+            }
+        }
+    }
+
+    void release() {
+        if (base) ::munmap(const_cast<char*>(base), length);
+        if (fd >= 0) ::close(fd);
+        base = nullptr;
+        fd = -1;
+    }
+
+    int fd = -1;
+    const char* base = nullptr;
+    size_t length = 0;
+    CandleColumns bars;
+};
\ No newline at end of file
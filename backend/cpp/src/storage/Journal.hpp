@@ -0,0 +1,392 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../models/Candle.hpp"
+#include "../models/Trade.hpp"
+#include "../utils/MpscQueue.hpp"
+
+enum class JournalKind : std::uint8_t {
+    Invalid,  // never written; marks the end of a journal cut short by a crash
+    Candle,
+    Signal,   // a strategy's signal, before any execution model
+    Fill      // an executed trade, at its fill price
+};
+
+// One fixed-size journal record. `stream` is chosen by the caller to tell
+// sources apart, e.g. one id per strategy or symbol.
+struct JournalRecord {
+    std::int64_t recordedAt;  // nanoseconds since the epoch when appended
+    std::int64_t timestamp;   // of the candle or trade, seconds since the epoch
+    std::uint32_t stream;
+    JournalKind kind;
+    TradeType side;
+    TradeReason reason;
+    std::uint8_t reserved;
+    double values[5];         // open, high, low, close, volume; or price, amount
+
+    Candle candle() const {
+        return Candle{static_cast<std::time_t>(timestamp), values[0], values[1], values[2], values[3], values[4]};
+    }
+
+    Trade trade() const {
+        return Trade{side, static_cast<std::time_t>(timestamp), values[0], values[1], reason};
+    }
+};
+static_assert(sizeof(JournalRecord) == 64, "Journal records must stay one cache line");
+
+// Layout (host byte order):
+//
+//     Header (64 bytes)
+//     JournalRecord[...]  64 bytes each, in append order
+//
+// The file is only ever appended to; a journal cut short by a crash ends
+// at its last whole record.
+struct JournalFormat {
+    static constexpr std::uint32_t Version = 1;
+    static constexpr char Magic[8] = {'T', 'A', 'J', 'R', 'N', 'L', 'S', '1'};
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint32_t recordSize;
+        std::uint8_t reserved[44];
+    };
+    static_assert(sizeof(Header) == 64, "Journal header must stay 64 bytes");
+
+    static Header header() {
+        Header header{};
+        std::memcpy(header.magic, Magic, sizeof(header.magic));
+        header.version = Version;
+        header.headerSize = sizeof(Header);
+        header.recordSize = sizeof(JournalRecord);
+        return header;
+    }
+
+    static void validate(const Header& header, const std::string& path) {
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.headerSize != sizeof(Header) ||
+            header.recordSize != sizeof(JournalRecord)) {
+            throw std::runtime_error("Journal: " + path + " is not a journal");
+        }
+        if (header.version != Version) {
+            throw std::runtime_error("Journal: " + path + " has unsupported version " +
+                                     std::to_string(header.version));
+        }
+    }
+};
+
+struct JournalOptions {
+    size_t capacity = 65536;  // records queued before append() starts refusing them
+    size_t batch = 4096;      // most records per write()
+    std::chrono::milliseconds syncInterval{100};  // fsync at most this often; 0 = after every write
+};
+
+// Append-only binary journal of candles, signals and fills.
+//
+// append() only stamps the record and pushes it onto an MpscQueue, so any
+// number of threads can journal from their hot paths without locking or
+// making system calls. A background thread drains the queue in batches of
+// up to `batch` records per write() and fsyncs at most every
+// `syncInterval`; flush() waits until everything appended before it is on
+// disk. When the writer falls `capacity` records behind, append() drops
+// the record and returns false, and the drop is counted.
+class Journal {
+public:
+    struct Stats {
+        std::uint64_t appended;  // accepted records
+        std::uint64_t dropped;   // refused because the queue was full
+        std::uint64_t written;   // handed to the file
+        std::uint64_t synced;    // known to be on disk
+    };
+
+    explicit Journal(const std::string& path, const JournalOptions& journalOptions = JournalOptions())
+        : options(journalOptions), queue(journalOptions.capacity), path(path) {
+        if (options.batch == 0) throw std::invalid_argument("Journal batch must be positive");
+        open();
+        writer = std::thread([this] { drain(); });
+    }
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Writes everything still queued, syncs and closes the file.
+    ~Journal() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        writer.join();
+        ::close(fd);
+    }
+
+    bool append(std::uint32_t stream, const Candle& candle) {
+        JournalRecord record{};
+        record.timestamp = static_cast<std::int64_t>(candle.timestamp);
+        record.stream = stream;
+        record.kind = JournalKind::Candle;
+        record.values[0] = candle.open;
+        record.values[1] = candle.high;
+        record.values[2] = candle.low;
+        record.values[3] = candle.close;
+        record.values[4] = candle.volume;
+        return append(record);
+    }
+
+    bool append(std::uint32_t stream, JournalKind kind, const Trade& trade) {
+        JournalRecord record{};
+        record.timestamp = static_cast<std::int64_t>(trade.timestamp);
+        record.stream = stream;
+        record.kind = kind;
+        record.side = trade.type;
+        record.reason = trade.reason;
+        record.values[0] = trade.price;
+        record.values[1] = trade.amount;
+        return append(record);
+    }
+
+    // Stamps `record` with the current time unless it carries one already.
+    bool append(JournalRecord record) {
+        if (record.recordedAt == 0) {
+            record.recordedAt = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+        if (queue.push(record)) {
+            appended.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Blocks until every record appended before the call is on disk.
+    // Throws if the writer has failed.
+    void flush() {
+        std::uint64_t target = queue.claimed();
+        std::unique_lock<std::mutex> lock(mutex);
+        flushTarget = std::max(flushTarget, target);
+        wake.notify_all();
+        done.wait(lock, [&] { return !error.empty() || syncedPosition >= target; });
+        if (!error.empty()) throw std::runtime_error(error);
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return Stats{appended.load(std::memory_order_relaxed), dropped.load(std::memory_order_relaxed),
+                     writtenPosition, syncedPosition};
+    }
+
+private:
+    // Opens or creates the file. An existing journal is validated and any
+    // partial or never-written records at its end are cut off, so new
+    // records follow its last whole one.
+    void open() {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) throw std::runtime_error("Journal: cannot open " + path + ": " + std::strerror(errno));
+        try {
+            struct stat info;
+            if (::fstat(fd, &info) != 0) throw std::runtime_error("Journal: cannot stat " + path);
+            size_t length = static_cast<size_t>(info.st_size);
+            if (length == 0) {
+                JournalFormat::Header header = JournalFormat::header();
+                if (!writeAll(&header, sizeof(header)) || ::fsync(fd) != 0) {
+                    throw std::runtime_error("Journal: cannot write " + path);
+                }
+                return;
+            }
+
+            JournalFormat::Header header;
+            if (length < sizeof(header) || ::pread(fd, &header, sizeof(header), 0) != sizeof(header)) {
+                throw std::runtime_error("Journal: " + path + " is not a journal");
+            }
+            JournalFormat::validate(header, path);
+
+            size_t records = (length - sizeof(header)) / sizeof(JournalRecord);
+            JournalRecord last;
+            while (records > 0 &&
+                   ::pread(fd, &last, sizeof(last), sizeof(header) + (records - 1) * sizeof(last)) == sizeof(last) &&
+                   last.kind == JournalKind::Invalid) {
+                --records;
+            }
+            size_t keep = sizeof(header) + records * sizeof(JournalRecord);
+            if (keep != length && ::ftruncate(fd, static_cast<off_t>(keep)) != 0) {
+                throw std::runtime_error("Journal: cannot repair " + path);
+            }
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+    }
+
+    bool writeAll(const void* data, size_t bytes) {
+        const char* p = static_cast<const char*>(data);
+        while (bytes > 0) {
+            ssize_t n = ::write(fd, p, bytes);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            p += n;
+            bytes -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // Writer thread. Sleeps in short naps when there is nothing to write,
+    // so producers never have to wake it.
+    void drain() {
+        using Clock = std::chrono::steady_clock;
+        std::vector<JournalRecord> batch(options.batch);
+        Clock::time_point lastSync = Clock::now();
+        bool failed = false;
+
+        for (;;) {
+            size_t count = queue.pop(batch.data(), batch.size());
+            if (count > 0 && !failed && !writeAll(batch.data(), count * sizeof(JournalRecord))) {
+                fail("Journal: write to " + path + " failed: " + std::strerror(errno));
+                failed = true;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            writtenPosition = queue.consumed();
+            bool idle = count == 0;
+            bool due = options.syncInterval.count() == 0 || Clock::now() - lastSync >= options.syncInterval ||
+                       flushTarget > syncedPosition || stopping;
+            if (!failed && writtenPosition > syncedPosition && due) {
+                std::uint64_t position = writtenPosition;
+                lock.unlock();
+                bool ok = ::fdatasync(fd) == 0;
+                lastSync = Clock::now();
+                lock.lock();
+                if (ok) {
+                    syncedPosition = position;
+                } else {
+                    error = "Journal: sync of " + path + " failed: " + std::strerror(errno);
+                    failed = true;
+                }
+                done.notify_all();
+            }
+            if (failed) done.notify_all();
+            if (idle) {
+                if (stopping && queue.consumed() == queue.claimed()) return;
+                wake.wait_for(lock, std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    void fail(const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = message;
+    }
+
+    JournalOptions options;
+    MpscQueue<JournalRecord> queue;
+    std::string path;
+    int fd = -1;
+
+    alignas(64) std::atomic<std::uint64_t> appended{0};
+    alignas(64) std::atomic<std::uint64_t> dropped{0};
+
+    mutable std::mutex mutex;  // guards the writer's progress below
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::uint64_t writtenPosition = 0;
+    std::uint64_t syncedPosition = 0;
+    std::uint64_t flushTarget = 0;
+    std::string error;
+    bool stopping = false;
+    std::thread writer;
+};
+
+// Read-only view of a journal, memory-mapped like a CandleStore. It covers
+// the records on disk when it was opened; records appended later need a
+// new reader.
+class JournalReader {
+public:
+    explicit JournalReader(const std::string& path) {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::runtime_error("Journal: cannot open " + path + ": " + std::strerror(errno));
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(JournalFormat::Header)) {
+            ::close(fd);
+            throw std::runtime_error("Journal: " + path + " is not a journal");
+        }
+        length = static_cast<size_t>(info.st_size);
+
+        void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Journal: cannot map " + path + ": " + std::strerror(errno));
+        }
+        base = static_cast<const char*>(mapped);
+
+        try {
+            JournalFormat::validate(*reinterpret_cast<const JournalFormat::Header*>(base), path);
+        } catch (...) {
+            release();
+            throw;
+        }
+
+        records = reinterpret_cast<const JournalRecord*>(base + sizeof(JournalFormat::Header));
+        count = (length - sizeof(JournalFormat::Header)) / sizeof(JournalRecord);
+        while (count > 0 && records[count - 1].kind == JournalKind::Invalid) --count;
+    }
+
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+
+    ~JournalReader() { release(); }
+
+    size_t size() const { return count; }
+    const JournalRecord& operator[](size_t i) const { return records[i]; }
+    const JournalRecord* begin() const { return records; }
+    const JournalRecord* end() const { return records + count; }
+
+    // Candles of one stream, in journal order.
+    std::vector<Candle> candles(std::uint32_t stream) const {
+        std::vector<Candle> out;
+        for (const JournalRecord& record : *this) {
+            if (record.kind == JournalKind::Candle && record.stream == stream) out.push_back(record.candle());
+        }
+        return out;
+    }
+
+    // Signals or fills of one stream, in journal order.
+    std::vector<Trade> trades(std::uint32_t stream, JournalKind kind) const {
+        std::vector<Trade> out;
+        for (const JournalRecord& record : *this) {
+            if (record.kind == kind && record.stream == stream) out.push_back(record.trade());
+        }
+        return out;
+    }
+
+private:
+    void release() {
+        if (base) ::munmap(const_cast<char*>(base), length);
+        if (fd >= 0) ::close(fd);
+        base = nullptr;
+        fd = -1;
+    }
+
+    int fd = -1;
+    const char* base = nullptr;
+    size_t length = 0;
+    const JournalRecord* records = nullptr;
+    size_t count = 0;
+};
\ No newline at end of file
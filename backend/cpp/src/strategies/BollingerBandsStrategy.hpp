@@ -2,6 +2,9 @@
 #include "Strategy.hpp"
 #include "../indicators/BollingerBands.hpp"
 #include <memory>
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
 
 class BollingerBandsStrategy : public Strategy {
 private:
@@ -9,63 +12,122 @@ private:
     double multiplier = 2.0;
     double percentageB = 0.5; // Threshold for %B indicator
 
+    BollingerBandsStream bands{period, multiplier};
+    IndicatorCache::BandsSeries cachedBands;
+    std::vector<double> cachedPercentB;  // starts at bar percentBOffset
+    size_t percentBOffset = 0;
+    size_t bar = 0;
+
 public:
     std::string getName() const override {
         return "Bollinger Bands Strategy";
     }
 
-    std::vector<Trade> analyze(const std::vector<Candle>& candles) override {
-        std::vector<Trade> trades;
-        std::vector<double> prices;
-        
-        // Extract closing prices
-        for (const auto& candle : candles) {
-            prices.push_back(candle.close);
+    std::optional<Trade> onCandle(const Candle& candle) override {
+        TRADING_TIMED("strategy_on_candle_ns", getName());
+        size_t i = bar++;
+        BollingerBands::Point band = cachedBands
+            ? BollingerBands::Point{cachedBands->upper[i], cachedBands->middle[i], cachedBands->lower[i]}
+            : bands.update(candle);
+        if (i < static_cast<size_t>(period)) return std::nullopt;
+
+        double price = candle.close;
+        double upperBand = band.upper;
+        double lowerBand = band.lower;
+
+        // Calculate %B indicator (precomputed for the whole batch when cached)
+        double percentB = cachedBands
+            ? cachedPercentB[i - percentBOffset]
+            : (price - lowerBand) / (upperBand - lowerBand);
+
+        // Oversold condition (price near lower band)
+        if (percentB < percentageB && price > lowerBand) {
+            return Trade{
+                TradeType::Buy,
+                candle.timestamp,
+                candle.close,
+                1.0,  // Standard position size
+                TradeReason::BBOversold
+            };
         }
-        
-        // Calculate Bollinger Bands
-        auto bands = BollingerBands::calculate(prices, period, multiplier);
-        
-        // Generate trading signals
-        for (size_t i = period; i < candles.size(); ++i) {
-            double price = prices[i];
-            double upperBand = bands.upper[i];
-            double lowerBand = bands.lower[i];
-            double middleBand = bands.middle[i];
-            
-            // Calculate %B indicator
-            double percentB = (price - lowerBand) / (upperBand - lowerBand);
-            
-            // Oversold condition (price near lower band)
-            if (percentB < percentageB && price > lowerBand) {
-                trades.push_back({
-                    "BUY",
-                    candles[i].timestamp,
-                    candles[i].close,
-                    1.0,  // Standard position size
-                    "BB Oversold"
-                });
-            }
-            // Overbought condition (price near upper band)
-            else if (percentB > (1 - percentageB) && price < upperBand) {
-                trades.push_back({
-                    "SELL",
-                    candles[i].timestamp,
-                    candles[i].close,
-                    1.0,  // Standard position size
-                    "BB Overbought"
-                });
-            }
+        // Overbought condition (price near upper band)
+        if (percentB > (1 - percentageB) && price < upperBand) {
+            return Trade{
+                TradeType::Sell,
+                candle.timestamp,
+                candle.close,
+                1.0,  // Standard position size
+                TradeReason::BBOverbought
+            };
         }
-        
-        return trades;
+
+        return std::nullopt;
+    }
+
+    void reset() override {
+        bands.reset();
+        cachedBands.reset();
+        bar = 0;
     }
 
     void updateParameters(const std::vector<double>& params) override {
         if (params.size() >= 3) {
+            if (params[0] < 1.0) throw std::invalid_argument("Bollinger Bands period must be positive");
             period = static_cast<int>(params[0]);
             multiplier = params[1];
             percentageB = params[2];
+            bands.configure(period, multiplier);
+            reset();
+        }
+    }
+
+    size_t parameterCount() const override { return 3; }
+
+    std::unique_ptr<Strategy> clone() const override {
+        return std::make_unique<BollingerBandsStrategy>(*this);
+    }
+
+    void prefetch(const CandleColumns& series, size_t count, const ParamsAt& paramsAt) override {
+        if (!cache) return;
+        std::vector<std::pair<int, double>> pairs;
+        std::vector<double> params;
+        for (size_t i = 0; i < count; ++i) {
+            paramsAt(i, params);
+            if (params.size() >= 3) pairs.emplace_back(static_cast<int>(params[0]), params[1]);
+        }
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+        std::vector<int> periods(pairs.size());
+        std::vector<double> multipliers(pairs.size());
+        for (size_t k = 0; k < pairs.size(); ++k) {
+            periods[k] = pairs[k].first;
+            multipliers[k] = pairs[k].second;
+        }
+        cache->bollinger(cacheSeriesId, series, periods, multipliers);
+    }
+
+protected:
+    // %B is only derived for the bars about to be replayed.
+    void prepare(const CandleColumns& series, size_t from, size_t to) override {
+        if (!cache) return;
+        cachedBands = cache->bollinger(cacheSeriesId, series, period, multiplier);
+
+        IndicatorCache::Series closes;
+        const double* prices = series.close;
+        if (!series.contiguous()) {
+            closes = cache->closes(cacheSeriesId, series);
+            prices = closes->data();
         }
+        to = std::min(to, series.size);
+        percentBOffset = std::min(from, to);
+        cachedPercentB.resize(to - percentBOffset);
+        VectorKernels::percentB(prices + percentBOffset, cachedBands->upper.data() + percentBOffset,
+                                cachedBands->lower.data() + percentBOffset,
+                                cachedPercentB.data(), cachedPercentB.size());
+    }
+
+    void seek(const CandleColumns& series, size_t from) override {
+        if (!cachedBands) return Strategy::seek(series, from);
+        bar = from;
     }
 };
\ No newline at end of file
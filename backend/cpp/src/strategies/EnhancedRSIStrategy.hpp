@@ -6,6 +6,8 @@
 
 class EnhancedRSIStrategy : public Strategy {
 private:
+    enum class Position : std::uint8_t { None, Long, Short };
+
     double oversoldThreshold = 30.0;
     double overboughtThreshold = 70.0;
     int rsiPeriod = 14;
@@ -13,92 +15,98 @@ private:
     double stopLoss = 0.02;  // 2% stop loss
     double takeProfit = 0.04; // 4% take profit
 
+    RSIStream rsi{rsiPeriod};
+    EMAStream ema{emaPeriod};
+    IndicatorCache::Series cachedRsi;
+    IndicatorCache::Series cachedEma;
+    size_t bar = 0;
+    double lastEntryPrice = 0.0;
+    Position currentPosition = Position::None;
+
 public:
     std::string getName() const override {
         return "Enhanced RSI Strategy";
     }
 
-    std::vector<Trade> analyze(const std::vector<Candle>& candles) override {
-        std::vector<Trade> trades;
-        std::vector<double> prices;
-        
-        // Extract closing prices
-        for (const auto& candle : candles) {
-            prices.push_back(candle.close);
-        }
-        
-        // Calculate indicators
-        auto rsi = RSI::calculate(prices, rsiPeriod);
-        auto ema = MovingAverage::calculateEMA(prices, emaPeriod);
-        
-        double lastEntryPrice = 0.0;
-        std::string currentPosition = "NONE";
-
-        // Generate trading signals
-        for (size_t i = emaPeriod; i < candles.size(); ++i) {
-            // Check for exit conditions first
-            if (currentPosition != "NONE") {
-                double pnl = (candles[i].close - lastEntryPrice) / lastEntryPrice;
-                
-                if ((currentPosition == "LONG" && pnl <= -stopLoss) ||
-                    (currentPosition == "SHORT" && pnl >= stopLoss)) {
-                    trades.push_back({
-                        currentPosition == "LONG" ? "SELL" : "BUY",
-                        candles[i].timestamp,
-                        candles[i].close,
-                        1.0,
-                        "Stop Loss"
-                    });
-                    currentPosition = "NONE";
-                    continue;
-                }
-
-                if ((currentPosition == "LONG" && pnl >= takeProfit) ||
-                    (currentPosition == "SHORT" && pnl <= -takeProfit)) {
-                    trades.push_back({
-                        currentPosition == "LONG" ? "SELL" : "BUY",
-                        candles[i].timestamp,
-                        candles[i].close,
-                        1.0,
-                        "Take Profit"
-                    });
-                    currentPosition = "NONE";
-                    continue;
-                }
+    std::optional<Trade> onCandle(const Candle& candle) override {
+        TRADING_TIMED("strategy_on_candle_ns", getName());
+        size_t i = bar++;
+        double currentRsi = cachedRsi ? (*cachedRsi)[i] : rsi.update(candle);
+        double currentEma = cachedEma ? (*cachedEma)[i] : ema.update(candle);
+        if (i < static_cast<size_t>(emaPeriod)) return std::nullopt;
+
+        // Check for exit conditions first
+        if (currentPosition != Position::None) {
+            double pnl = (candle.close - lastEntryPrice) / lastEntryPrice;
+
+            if ((currentPosition == Position::Long && pnl <= -stopLoss) ||
+                (currentPosition == Position::Short && pnl >= stopLoss)) {
+                Trade trade{
+                    currentPosition == Position::Long ? TradeType::Sell : TradeType::Buy,
+                    candle.timestamp,
+                    candle.close,
+                    1.0,
+                    TradeReason::StopLoss
+                };
+                currentPosition = Position::None;
+                return trade;
             }
 
-            // Entry conditions
-            if (currentPosition == "NONE") {
-                bool priceAboveEMA = candles[i].close > ema[i];
-                bool rsiOversold = rsi[i] <= oversoldThreshold;
-                bool rsiOverbought = rsi[i] >= overboughtThreshold;
-
-                if (priceAboveEMA && rsiOversold) {
-                    trades.push_back({
-                        "BUY",
-                        candles[i].timestamp,
-                        candles[i].close,
-                        1.0,
-                        "RSI Oversold + EMA Support"
-                    });
-                    currentPosition = "LONG";
-                    lastEntryPrice = candles[i].close;
-                }
-                else if (!priceAboveEMA && rsiOverbought) {
-                    trades.push_back({
-                        "SELL",
-                        candles[i].timestamp,
-                        candles[i].close,
-                        1.0,
-                        "RSI Overbought + EMA Resistance"
-                    });
-                    currentPosition = "SHORT";
-                    lastEntryPrice = candles[i].close;
-                }
+            if ((currentPosition == Position::Long && pnl >= takeProfit) ||
+                (currentPosition == Position::Short && pnl <= -takeProfit)) {
+                Trade trade{
+                    currentPosition == Position::Long ? TradeType::Sell : TradeType::Buy,
+                    candle.timestamp,
+                    candle.close,
+                    1.0,
+                    TradeReason::TakeProfit
+                };
+                currentPosition = Position::None;
+                return trade;
             }
+
+            return std::nullopt;
         }
-        
-        return trades;
+
+        // Entry conditions
+        bool priceAboveEMA = candle.close > currentEma;
+        bool rsiOversold = currentRsi <= oversoldThreshold;
+        bool rsiOverbought = currentRsi >= overboughtThreshold;
+
+        if (priceAboveEMA && rsiOversold) {
+            currentPosition = Position::Long;
+            lastEntryPrice = candle.close;
+            return Trade{
+                TradeType::Buy,
+                candle.timestamp,
+                candle.close,
+                1.0,
+                TradeReason::RSIOversoldEMASupport
+            };
+        }
+        if (!priceAboveEMA && rsiOverbought) {
+            currentPosition = Position::Short;
+            lastEntryPrice = candle.close;
+            return Trade{
+                TradeType::Sell,
+                candle.timestamp,
+                candle.close,
+                1.0,
+                TradeReason::RSIOverboughtEMAResistance
+            };
+        }
+
+        return std::nullopt;
+    }
+
+    void reset() override {
+        rsi.reset();
+        ema.reset();
+        cachedRsi.reset();
+        cachedEma.reset();
+        bar = 0;
+        lastEntryPrice = 0.0;
+        currentPosition = Position::None;
     }
 
     void updateParameters(const std::vector<double>& params) override {
@@ -109,6 +117,36 @@ public:
             overboughtThreshold = params[3];
             stopLoss = params[4];
             takeProfit = params[5];
+            rsi = RSIStream(rsiPeriod);
+            ema = EMAStream(emaPeriod);
+            reset();
+        }
+    }
+
+    size_t parameterCount() const override { return 6; }
+
+    std::unique_ptr<Strategy> clone() const override {
+        return std::make_unique<EnhancedRSIStrategy>(*this);
+    }
+
+protected:
+    void prepare(const CandleColumns& series, size_t, size_t) override {
+        if (cache) {
+            cachedRsi = cache->rsi(cacheSeriesId, series, rsiPeriod);
+            cachedEma = cache->ema(cacheSeriesId, series, emaPeriod);
+        }
+    }
+
+    // Only the indicators are advanced; the position opened by replaying
+    // earlier bars would not exist in the caller's book.
+    void seek(const CandleColumns& series, size_t from) override {
+        if (!cachedRsi) {
+            for (size_t i = 0; i < from; ++i) {
+                Candle candle = series[i];
+                rsi.update(candle);
+                ema.update(candle);
+            }
         }
+        bar = from;
     }
 };
\ No newline at end of file
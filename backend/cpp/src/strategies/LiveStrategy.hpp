@@ -0,0 +1,254 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Strategy.hpp"
+#include "../utils/TripleBuffer.hpp"
+
+// A strategy whose parameters can be replaced while it trades.
+//
+// One thread at a time (the live thread) drives it like any strategy,
+// through onCandle, analyze or reset. Any other thread may publish() new
+// parameters meanwhile. A background builder applies each publication to
+// a fresh clone of the prototype, warms its indicators by replaying the
+// last `historyBars` bars the live thread has seen, and hands the clone
+// over through a TripleBuffer. The live thread switches to it at the start
+// of its next bar and replays only the bars that arrived during the build,
+// usually none; an analyze() call only switches at its start. The live
+// thread never locks, never waits for the builder and never frees an
+// instance; the builder reclaims replaced ones.
+//
+// A rebuilt strategy is in the state of a fresh run over the replayed
+// bars, so smoothed indicators (EMA, Wilder RSI) agree with a full-history
+// run once the window spans many periods. Publications made while a build
+// runs are coalesced into the next build; parameters the strategy rejects
+// (updateParameters throws) are dropped.
+class LiveStrategy : public Strategy {
+public:
+    explicit LiveStrategy(std::unique_ptr<Strategy> strategy, size_t historyBars = 1024)
+        : prototype(std::move(strategy)), window(historyBars) {
+        if (!prototype) throw std::invalid_argument("LiveStrategy needs a strategy");
+        if (historyBars == 0) throw std::invalid_argument("LiveStrategy needs some history");
+        name = prototype->getName();
+        size_t capacity = 1;
+        while (capacity < 2 * historyBars + 64) capacity <<= 1;
+        history.reset(new Slot[capacity]);
+        mask = capacity - 1;
+        buffer.front().strategy = prototype->clone();
+        builder = std::thread([this] { build(); });
+    }
+
+    ~LiveStrategy() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        builder.join();
+    }
+
+    std::string getName() const override {
+        return name;
+    }
+
+    using Strategy::analyze;
+
+    // Runs wholly on the parameters in force when it starts: a switch
+    // that becomes ready meanwhile waits for the next call.
+    std::vector<Trade> analyze(const CandleColumns& bars) override {
+        pinned = true;
+        std::vector<Trade> trades = Strategy::analyze(bars);
+        pinned = false;
+        return trades;
+    }
+
+    std::optional<Trade> onCandle(const Candle& candle) override {
+        if (!pinned && buffer.update()) adopt();
+        record(candle);
+        return buffer.front().strategy->onCandle(candle);
+    }
+
+    void reset() override {
+        if (buffer.update()) adopt();
+        buffer.front().strategy->reset();
+        start = count;
+        seriesStart.store(start, std::memory_order_release);
+    }
+
+    // Publishes asynchronously; see publish().
+    void updateParameters(const std::vector<double>& params) override {
+        publish(params);
+    }
+
+    // Queues `params` for the builder and returns their version, counting
+    // from 1. Never waits for the build; safe from any thread.
+    std::uint64_t publish(const std::vector<double>& params) {
+        std::uint64_t version;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            requested = params;
+            version = ++requestedVersion;
+        }
+        wake.notify_one();
+        return version;
+    }
+
+    // Version of the parameters the live thread trades with; 0 until the
+    // first publication is switched to. Safe from any thread.
+    std::uint64_t appliedVersion() const {
+        return applied.load(std::memory_order_acquire);
+    }
+
+    size_t parameterCount() const override {
+        return prototype->parameterCount();
+    }
+
+    // A plain strategy with the latest published parameters.
+    std::unique_ptr<Strategy> clone() const override {
+        std::unique_ptr<Strategy> copy = prototype->clone();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (requestedVersion > 0) copy->updateParameters(requested);
+        return copy;
+    }
+
+private:
+    struct Staged {
+        std::unique_ptr<Strategy> strategy;
+        std::uint64_t version = 0;
+        std::uint64_t seen = 0;         // bars replayed into it
+        std::uint64_t seriesStart = 0;  // series those bars belong to
+    };
+
+    // History slots are written by the live thread while the builder may
+    // read them, so they are held as relaxed atomic words; the builder
+    // checks afterwards that none of the slots it read was being reused.
+    struct Slot {
+        std::atomic<std::uint64_t> words[sizeof(Candle) / sizeof(std::uint64_t)];
+    };
+    static_assert(sizeof(Candle) % sizeof(std::uint64_t) == 0, "Candle must pack into whole words");
+
+    void record(const Candle& candle) {
+        std::uint64_t words[sizeof(Candle) / sizeof(std::uint64_t)];
+        std::memcpy(words, &candle, sizeof(Candle));
+        Slot& slot = history[count & mask];
+        for (size_t w = 0; w < sizeof(words) / sizeof(words[0]); ++w) {
+            slot.words[w].store(words[w], std::memory_order_relaxed);
+        }
+        written.store(++count, std::memory_order_release);
+    }
+
+    Candle load(std::uint64_t bar) const {
+        std::uint64_t words[sizeof(Candle) / sizeof(std::uint64_t)];
+        const Slot& slot = history[bar & mask];
+        for (size_t w = 0; w < sizeof(words) / sizeof(words[0]); ++w) {
+            words[w] = slot.words[w].load(std::memory_order_relaxed);
+        }
+        Candle candle;
+        std::memcpy(&candle, words, sizeof(Candle));
+        return candle;
+    }
+
+    // Live thread: brings the instance just taken from the buffer up to the
+    // current bar. If the series was reset since its build began, it
+    // restarts from the reset instead.
+    void adopt() {
+        Staged& next = buffer.front();
+        std::uint64_t from = next.seen;
+        if (next.seriesStart != start) {
+            next.strategy->reset();
+            from = start;
+        }
+        if (count - from > mask) from = count - mask;
+        for (std::uint64_t bar = from; bar < count; ++bar) next.strategy->onCandle(load(bar));
+        applied.store(next.version, std::memory_order_release);
+    }
+
+    // Builder: copies bars [from, to) out of the history and returns false
+    // if the live thread may have overwritten any of them meanwhile.
+    bool copy(std::uint64_t from, std::uint64_t to, std::vector<Candle>& out) const {
+        out.clear();
+        for (std::uint64_t bar = from; bar < to; ++bar) out.push_back(load(bar));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return from + mask >= written.load(std::memory_order_relaxed);
+    }
+
+    void build() {
+        std::vector<double> params;
+        std::vector<Candle> bars;
+        std::uint64_t built = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [&] { return stopping || requestedVersion != built; });
+            if (stopping) return;
+            params = requested;
+            built = requestedVersion;
+            lock.unlock();
+
+            Staged& staged = buffer.back();
+            try {
+                staged.strategy = prototype->clone();
+                staged.strategy->updateParameters(params);
+                replay(staged, bars);
+                staged.version = built;
+                buffer.publish();
+            } catch (...) {
+                staged.strategy.reset();
+            }
+            lock.lock();
+        }
+    }
+
+    // Builder: warms `staged` on the latest window of the current series,
+    // then keeps feeding it the bars that arrive meanwhile until it has
+    // caught up with the live thread.
+    void replay(Staged& staged, std::vector<Candle>& bars) {
+        std::uint64_t series = seriesStart.load(std::memory_order_acquire);
+        std::uint64_t to = written.load(std::memory_order_acquire);
+        std::uint64_t from = std::max(series, to > window ? to - window : 0);
+        for (int pass = 0; pass < 8 && from < to; ++pass) {
+            if (!copy(from, to, bars)) {
+                // Outrun by the live thread: restart on its latest window.
+                staged.strategy->reset();
+                series = seriesStart.load(std::memory_order_acquire);
+                to = written.load(std::memory_order_acquire);
+                from = std::max(series, to > window ? to - window : 0);
+                continue;
+            }
+            for (const Candle& candle : bars) staged.strategy->onCandle(candle);
+            from = to;
+            to = written.load(std::memory_order_acquire);
+        }
+        staged.seen = from;
+        staged.seriesStart = series;
+    }
+
+    std::unique_ptr<Strategy> prototype;  // never touched after construction but to clone it
+    std::string name;
+    size_t window;
+
+    std::unique_ptr<Slot[]> history;
+    std::uint64_t mask = 0;
+    TripleBuffer<Staged> buffer;
+
+    // Live thread only.
+    std::uint64_t count = 0;  // bars recorded
+    std::uint64_t start = 0;  // first bar of the current series
+    bool pinned = false;      // inside analyze(): no switching
+
+    alignas(64) std::atomic<std::uint64_t> written{0};
+    std::atomic<std::uint64_t> seriesStart{0};
+    std::atomic<std::uint64_t> applied{0};
+
+    mutable std::mutex mutex;  // guards the publication state below
+    std::condition_variable wake;
+    std::vector<double> requested;
+    std::uint64_t requestedVersion = 0;
+    bool stopping = false;
+    std::thread builder;
+};
\ No newline at end of file
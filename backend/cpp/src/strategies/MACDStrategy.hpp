@@ -2,6 +2,7 @@
 #include "Strategy.hpp"
 #include "../indicators/MACD.hpp"
 #include <memory>
+#include <algorithm>
 
 class MACDStrategy : public Strategy {
 private:
@@ -10,50 +11,56 @@ private:
     int signalPeriod = 9;
     double signalThreshold = 0.0;
 
+    MACDStream macd{fastPeriod, slowPeriod, signalPeriod};
+    IndicatorCache::MACDSeries cachedMacd;
+    size_t bar = 0;
+    double previousHistogram = 0.0;
+
 public:
     std::string getName() const override {
         return "MACD Strategy";
     }
 
-    std::vector<Trade> analyze(const std::vector<Candle>& candles) override {
-        std::vector<Trade> trades;
-        std::vector<double> prices;
-        
-        // Extract closing prices
-        for (const auto& candle : candles) {
-            prices.push_back(candle.close);
-        }
-        
-        // Calculate MACD
-        auto macdData = MACD::calculate(prices, fastPeriod, slowPeriod, signalPeriod);
-        
-        // Generate trading signals
-        for (size_t i = signalPeriod + 1; i < candles.size(); ++i) {
+    std::optional<Trade> onCandle(const Candle& candle) override {
+        TRADING_TIMED("strategy_on_candle_ns", getName());
+        size_t i = bar++;
+        double histogram = cachedMacd ? cachedMacd->histogram[i] : macd.update(candle).histogram;
+        std::optional<Trade> trade;
+
+        if (i >= static_cast<size_t>(signalPeriod) + 1) {
             // MACD line crosses above signal line
-            if (macdData.histogram[i-1] <= signalThreshold && 
-                macdData.histogram[i] > signalThreshold) {
-                trades.push_back({
-                    "BUY",
-                    candles[i].timestamp,
-                    candles[i].close,
+            if (previousHistogram <= signalThreshold && 
+                histogram > signalThreshold) {
+                trade = Trade{
+                    TradeType::Buy,
+                    candle.timestamp,
+                    candle.close,
                     1.0,  // Standard position size
-                    "MACD Bullish Crossover"
-                });
+                    TradeReason::MACDBullishCrossover
+                };
             }
             // MACD line crosses below signal line
-            else if (macdData.histogram[i-1] >= -signalThreshold && 
-                     macdData.histogram[i] < -signalThreshold) {
-                trades.push_back({
-                    "SELL",
-                    candles[i].timestamp,
-                    candles[i].close,
+            else if (previousHistogram >= -signalThreshold && 
+                     histogram < -signalThreshold) {
+                trade = Trade{
+                    TradeType::Sell,
+                    candle.timestamp,
+                    candle.close,
                     1.0,  // Standard position size
-                    "MACD Bearish Crossover"
-                });
+                    TradeReason::MACDBearishCrossover
+                };
             }
         }
-        
-        return trades;
+
+        previousHistogram = histogram;
+        return trade;
+    }
+
+    void reset() override {
+        macd.reset();
+        cachedMacd.reset();
+        bar = 0;
+        previousHistogram = 0.0;
     }
 
     void updateParameters(const std::vector<double>& params) override {
@@ -62,6 +69,45 @@ public:
             slowPeriod = static_cast<int>(params[1]);
             signalPeriod = static_cast<int>(params[2]);
             signalThreshold = params[3];
+            macd = MACDStream(fastPeriod, slowPeriod, signalPeriod);
+            reset();
         }
     }
+
+    size_t parameterCount() const override { return 4; }
+
+    std::unique_ptr<Strategy> clone() const override {
+        return std::make_unique<MACDStrategy>(*this);
+    }
+
+    // Only the fast and slow EMAs are batched; each MACD's signal line
+    // depends on both and is still computed when first used.
+    void prefetch(const CandleColumns& series, size_t count, const ParamsAt& paramsAt) override {
+        if (!cache) return;
+        std::vector<int> periods;
+        std::vector<double> params;
+        for (size_t i = 0; i < count; ++i) {
+            paramsAt(i, params);
+            if (params.size() < 4) continue;
+            periods.push_back(static_cast<int>(params[0]));
+            periods.push_back(static_cast<int>(params[1]));
+        }
+        std::sort(periods.begin(), periods.end());
+        periods.erase(std::unique(periods.begin(), periods.end()), periods.end());
+        cache->ema(cacheSeriesId, series, periods);
+    }
+
+protected:
+    void prepare(const CandleColumns& series, size_t, size_t) override {
+        if (cache) {
+            cachedMacd = cache->macd(cacheSeriesId, series,
+                                     fastPeriod, slowPeriod, signalPeriod);
+        }
+    }
+
+    void seek(const CandleColumns& series, size_t from) override {
+        if (!cachedMacd) return Strategy::seek(series, from);
+        bar = from;
+        previousHistogram = cachedMacd->histogram[from - 1];
+    }
 };
\ No newline at end of file
@@ -0,0 +1,201 @@
+#pragma once
+#include <algorithm>
+#include <optional>
+#include <tuple>
+#include <vector>
+#include "StrategyPipeline.hpp"
+#include "../indicators/RSI.hpp"
+#include "../indicators/MACD.hpp"
+#include "../indicators/BollingerBands.hpp"
+#include "../indicators/MovingAverage.hpp"
+
+// Signal rules for StrategyPipeline. The RSI, MACD and Bollinger rules
+// reproduce RSIStrategy, MACDStrategy and BollingerBandsStrategy signal for
+// signal; parse() accepts the same parameter vectors as their
+// updateParameters.
+
+struct RSIRule {
+    struct Params {
+        int period = 14;
+        double oversold = 30.0;
+        double overbought = 70.0;
+    };
+
+    static constexpr const char* name = "RSI Pipeline";
+    static constexpr size_t ParameterCount = 3;
+
+    static std::tuple<RSIStream> indicators(const Params& params) {
+        return std::tuple<RSIStream>(RSIStream(params.period));
+    }
+
+    static bool parse(const std::vector<double>& values, Params& params) {
+        if (values.size() < ParameterCount) return false;
+        params = {static_cast<int>(values[0]), values[1], values[2]};
+        return true;
+    }
+
+    explicit RSIRule(const Params& params) : params(params) {}
+
+    std::optional<Trade> operator()(const Candle& candle, size_t i, double rsi) {
+        std::optional<Trade> trade;
+        if (i >= static_cast<size_t>(params.period) + 1) {
+            if (previous > params.overbought && rsi <= params.overbought) {
+                trade = Trade{TradeType::Sell, candle.timestamp, candle.close, 1.0, TradeReason::RSIOverbought};
+            } else if (previous < params.oversold && rsi >= params.oversold) {
+                trade = Trade{TradeType::Buy, candle.timestamp, candle.close, 1.0, TradeReason::RSIOversold};
+            }
+        }
+        previous = rsi;
+        return trade;
+    }
+
+    void reset() { previous = 0.0; }
+
+private:
+    Params params;
+    double previous = 0.0;
+};
+
+struct MACDRule {
+    struct Params {
+        int fastPeriod = 12;
+        int slowPeriod = 26;
+        int signalPeriod = 9;
+        double threshold = 0.0;
+    };
+
+    static constexpr const char* name = "MACD Pipeline";
+    static constexpr size_t ParameterCount = 4;
+
+    static std::tuple<MACDStream> indicators(const Params& params) {
+        return std::tuple<MACDStream>(MACDStream(params.fastPeriod, params.slowPeriod, params.signalPeriod));
+    }
+
+    static bool parse(const std::vector<double>& values, Params& params) {
+        if (values.size() < ParameterCount) return false;
+        params = {static_cast<int>(values[0]), static_cast<int>(values[1]),
+                  static_cast<int>(values[2]), values[3]};
+        return true;
+    }
+
+    explicit MACDRule(const Params& params) : params(params) {}
+
+    std::optional<Trade> operator()(const Candle& candle, size_t i, const MACD::Point& macd) {
+        std::optional<Trade> trade;
+        double histogram = macd.histogram;
+        if (i >= static_cast<size_t>(params.signalPeriod) + 1) {
+            if (previous <= params.threshold && histogram > params.threshold) {
+                trade = Trade{TradeType::Buy, candle.timestamp, candle.close, 1.0,
+                              TradeReason::MACDBullishCrossover};
+            } else if (previous >= -params.threshold && histogram < -params.threshold) {
+                trade = Trade{TradeType::Sell, candle.timestamp, candle.close, 1.0,
+                              TradeReason::MACDBearishCrossover};
+            }
+        }
+        previous = histogram;
+        return trade;
+    }
+
+    void reset() { previous = 0.0; }
+
+private:
+    Params params;
+    double previous = 0.0;
+};
+
+struct BollingerRule {
+    struct Params {
+        int period = 20;
+        double multiplier = 2.0;
+        double percentageB = 0.5;
+    };
+
+    static constexpr const char* name = "Bollinger Bands Pipeline";
+    static constexpr size_t ParameterCount = 3;
+
+    static std::tuple<BollingerBandsStream> indicators(const Params& params) {
+        return std::tuple<BollingerBandsStream>(BollingerBandsStream(params.period, params.multiplier));
+    }
+
+    static bool parse(const std::vector<double>& values, Params& params) {
+        if (values.size() < ParameterCount) return false;
+        params = {static_cast<int>(values[0]), values[1], values[2]};
+        return true;
+    }
+
+    explicit BollingerRule(const Params& params) : params(params) {}
+
+    std::optional<Trade> operator()(const Candle& candle, size_t i, const BollingerBands::Point& band) {
+        if (i < static_cast<size_t>(params.period)) return std::nullopt;
+
+        double price = candle.close;
+        double percentB = (price - band.lower) / (band.upper - band.lower);
+        if (percentB < params.percentageB && price > band.lower) {
+            return Trade{TradeType::Buy, candle.timestamp, candle.close, 1.0, TradeReason::BBOversold};
+        }
+        if (percentB > (1 - params.percentageB) && price < band.upper) {
+            return Trade{TradeType::Sell, candle.timestamp, candle.close, 1.0, TradeReason::BBOverbought};
+        }
+        return std::nullopt;
+    }
+
+    void reset() {}
+
+private:
+    Params params;
+};
+
+// RSI reversals filtered by an EMA trend: buys only above the EMA, sells
+// only below it.
+struct RSITrendRule {
+    struct Params {
+        int rsiPeriod = 14;
+        double oversold = 30.0;
+        double overbought = 70.0;
+        int trendPeriod = 50;
+    };
+
+    static constexpr const char* name = "RSI Trend Pipeline";
+    static constexpr size_t ParameterCount = 4;
+
+    static std::tuple<RSIStream, EMAStream> indicators(const Params& params) {
+        return std::tuple<RSIStream, EMAStream>(RSIStream(params.rsiPeriod), EMAStream(params.trendPeriod));
+    }
+
+    static bool parse(const std::vector<double>& values, Params& params) {
+        if (values.size() < ParameterCount) return false;
+        params = {static_cast<int>(values[0]), values[1], values[2], static_cast<int>(values[3])};
+        return true;
+    }
+
+    explicit RSITrendRule(const Params& params)
+        : params(params),
+          warmup(static_cast<size_t>(std::max(params.rsiPeriod + 1, params.trendPeriod))) {}
+
+    std::optional<Trade> operator()(const Candle& candle, size_t i, double rsi, double trend) {
+        std::optional<Trade> trade;
+        if (i >= warmup) {
+            if (previous > params.overbought && rsi <= params.overbought && candle.close < trend) {
+                trade = Trade{TradeType::Sell, candle.timestamp, candle.close, 1.0,
+                              TradeReason::RSIOverboughtEMAResistance};
+            } else if (previous < params.oversold && rsi >= params.oversold && candle.close > trend) {
+                trade = Trade{TradeType::Buy, candle.timestamp, candle.close, 1.0,
+                              TradeReason::RSIOversoldEMASupport};
+            }
+        }
+        previous = rsi;
+        return trade;
+    }
+
+    void reset() { previous = 0.0; }
+
+private:
+    Params params;
+    size_t warmup;
+    double previous = 0.0;
+};
+
+using RSIPipeline = StrategyPipeline<RSIRule, RSIStream>;
+using MACDPipeline = StrategyPipeline<MACDRule, MACDStream>;
+using BollingerPipeline = StrategyPipeline<BollingerRule, BollingerBandsStream>;
+using RSITrendPipeline = StrategyPipeline<RSITrendRule, RSIStream, EMAStream>;
\ No newline at end of file
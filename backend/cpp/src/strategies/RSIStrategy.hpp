@@ -2,6 +2,7 @@
 #include "Strategy.hpp"
 #include "../indicators/RSI.hpp"
 #include <memory>
+#include <algorithm>
 
 class RSIStrategy : public Strategy {
 private:
@@ -9,46 +10,53 @@ private:
     double overboughtThreshold = 70.0;
     int period = 14;
 
+    RSIStream rsi{period};
+    IndicatorCache::Series cachedRsi;
+    size_t bar = 0;
+    double previousRsi = 0.0;
+
 public:
     std::string getName() const override {
         return "RSI Strategy";
     }
 
-    std::vector<Trade> analyze(const std::vector<Candle>& candles) override {
-        std::vector<Trade> trades;
-        std::vector<double> prices;
-        
-        // Extract closing prices
-        for (const auto& candle : candles) {
-            prices.push_back(candle.close);
-        }
-        
-        // Calculate RSI
-        auto rsi = RSI::calculate(prices, period);
-        
-        // Generate trading signals
-        for (size_t i = period + 1; i < candles.size(); ++i) {
-            if (rsi[i-1] > overboughtThreshold && rsi[i] <= overboughtThreshold) {
-                trades.push_back({
-                    "SELL",
-                    candles[i].timestamp,
-                    candles[i].close,
+    std::optional<Trade> onCandle(const Candle& candle) override {
+        TRADING_TIMED("strategy_on_candle_ns", getName());
+        size_t i = bar++;
+        double currentRsi = cachedRsi ? (*cachedRsi)[i] : rsi.update(candle);
+        std::optional<Trade> trade;
+
+        // Signals start once RSI[i-1] is defined
+        if (i >= static_cast<size_t>(period) + 1) {
+            if (previousRsi > overboughtThreshold && currentRsi <= overboughtThreshold) {
+                trade = Trade{
+                    TradeType::Sell,
+                    candle.timestamp,
+                    candle.close,
                     1.0,  // Standard position size
-                    "RSI Overbought"
-                });
+                    TradeReason::RSIOverbought
+                };
             }
-            else if (rsi[i-1] < oversoldThreshold && rsi[i] >= oversoldThreshold) {
-                trades.push_back({
-                    "BUY",
-                    candles[i].timestamp,
-                    candles[i].close,
+            else if (previousRsi < oversoldThreshold && currentRsi >= oversoldThreshold) {
+                trade = Trade{
+                    TradeType::Buy,
+                    candle.timestamp,
+                    candle.close,
                     1.0,  // Standard position size
-                    "RSI Oversold"
-                });
+                    TradeReason::RSIOversold
+                };
             }
         }
-        
-        return trades;
+
+        previousRsi = currentRsi;
+        return trade;
+    }
+
+    void reset() override {
+        rsi.reset();
+        cachedRsi.reset();
+        bar = 0;
+        previousRsi = 0.0;
     }
 
     void updateParameters(const std::vector<double>& params) override {
@@ -56,6 +64,38 @@ public:
             period = static_cast<int>(params[0]);
             oversoldThreshold = params[1];
             overboughtThreshold = params[2];
+            rsi = RSIStream(period);
+            reset();
+        }
+    }
+
+    size_t parameterCount() const override { return 3; }
+
+    std::unique_ptr<Strategy> clone() const override {
+        return std::make_unique<RSIStrategy>(*this);
+    }
+
+    void prefetch(const CandleColumns& series, size_t count, const ParamsAt& paramsAt) override {
+        if (!cache) return;
+        std::vector<int> periods;
+        std::vector<double> params;
+        for (size_t i = 0; i < count; ++i) {
+            paramsAt(i, params);
+            if (params.size() >= 3) periods.push_back(static_cast<int>(params[0]));
         }
+        std::sort(periods.begin(), periods.end());
+        periods.erase(std::unique(periods.begin(), periods.end()), periods.end());
+        cache->rsi(cacheSeriesId, series, periods);
+    }
+
+protected:
+    void prepare(const CandleColumns& series, size_t, size_t) override {
+        if (cache) cachedRsi = cache->rsi(cacheSeriesId, series, period);
+    }
+
+    void seek(const CandleColumns& series, size_t from) override {
+        if (!cachedRsi) return Strategy::seek(series, from);
+        bar = from;
+        previousRsi = (*cachedRsi)[from - 1];
     }
 };
\ No newline at end of file
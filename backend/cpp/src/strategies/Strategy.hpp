@@ -1,13 +1,141 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <memory>
+#include <functional>
+#include <optional>
+#include <cstdint>
+#include <stdexcept>
 #include "../models/Trade.hpp"
 #include "../models/Candle.hpp"
+#include "../models/CandleColumns.hpp"
+#include "../indicators/IndicatorCache.hpp"
+#include "../utils/Metrics.hpp"
 
 class Strategy {
 public:
     virtual ~Strategy() = default;
     virtual std::string getName() const = 0;
-    virtual std::vector<Trade> analyze(const std::vector<Candle>& candles) = 0;
+
+    // Feeds the next bar and returns the signal it triggers, if any.
+    // Indicator state persists between calls, so each bar costs O(1)
+    // however much history has already been seen.
+    virtual std::optional<Trade> onCandle(const Candle& candle) = 0;
+
+    // Drops all indicator and signal state; the next onCandle starts a new series.
+    virtual void reset() = 0;
+
+    // Batch adapter over onCandle: replays `bars` from a clean state.
+    // With a cache attached the indicator series for the whole batch are
+    // fetched up front, and the strategy is reset again afterwards because
+    // those series only cover this batch.
+    virtual std::vector<Trade> analyze(const CandleColumns& bars) {
+        TRADING_TIMED_AS(analyzeMetric, "strategy_analyze_ns", getName());
+        begin(bars);
+        std::vector<Trade> trades;
+        for (size_t i = 0; i < bars.size; ++i) {
+            if (auto trade = onCandle(bars[i])) {
+                trades.push_back(*trade);
+            }
+        }
+        finish();
+        return trades;
+    }
+
+    // The two halves of analyze() for callers that drive onCandle
+    // themselves, such as the Backtester: begin() starts a clean run over
+    // `bars`, finish() drops batch-bound cached series once it is done.
+    void begin(const CandleColumns& bars) {
+        begin(bars, 0, bars.size);
+    }
+
+    // Starts a run over bars [from, to) of `series`. Indicators see the
+    // history before `from` - with a cache attached they are read from the
+    // whole-series values rather than recomputed - while trading state
+    // (open positions, pending crossovers) starts flat. onCandle must then
+    // be fed series[from], series[from + 1], ...
+    void begin(const CandleColumns& series, size_t from, size_t to) {
+        reset();
+        prepare(series, from, to);
+        if (from > 0) seek(series, from);
+    }
+
+    void finish() {
+        if (cache) reset();
+    }
+
+    std::vector<Trade> analyze(const Candle* candles, size_t size) {
+        return analyze(CandleColumns::fromCandles(candles, size));
+    }
+
+    std::vector<Trade> analyze(const std::vector<Candle>& candles) {
+        return analyze(candles.data(), candles.size());
+    }
+
     virtual void updateParameters(const std::vector<double>& params) = 0;
+
+    // Number of values updateParameters expects, or 0 if the strategy
+    // does not say.
+    virtual size_t parameterCount() const { return 0; }
+
+    // Throws std::invalid_argument unless `params` has parameterCount()
+    // values. Sweeps call it on every candidate before backtesting, since
+    // updateParameters ignores a vector that is too short.
+    void checkParameters(const std::vector<double>& params) const {
+        size_t expected = parameterCount();
+        if (expected != 0 && params.size() != expected) {
+            throw std::invalid_argument(getName() + " takes " + std::to_string(expected) +
+                                        " parameters, got " + std::to_string(params.size()));
+        }
+    }
+
+    // Independent copy with the same parameters, used to run one strategy
+    // configuration on several threads at once.
+    virtual std::unique_ptr<Strategy> clone() const = 0;
+
+    // Makes analyze() read its indicators from `indicatorCache` instead of
+    // recomputing them. `seriesId` must identify the candles later passed to
+    // analyze(); pass nullptr to detach.
+    void attachCache(std::shared_ptr<IndicatorCache> indicatorCache, std::uint64_t seriesId) {
+        cache = std::move(indicatorCache);
+        cacheSeriesId = seriesId;
+        reset();
+    }
+
+    using ParamsAt = std::function<void(size_t, std::vector<double>&)>;
+
+    // Fills the attached cache with the indicator series that the
+    // parameter sets paramsAt(0) .. paramsAt(count - 1) will read, computing
+    // the missing ones in batched passes. ParameterSweep calls it before
+    // fanning candidates out to workers. Does nothing without a cache or
+    // for strategies without batched indicators.
+    virtual void prefetch(const CandleColumns& series, size_t count, const ParamsAt& paramsAt) {
+        (void)series;
+        (void)count;
+        (void)paramsAt;
+    }
+
+protected:
+    // Called by begin() between reset() and the first onCandle with the
+    // whole series and the range about to be replayed; strategies fetch
+    // their cached indicator series here.
+    virtual void prepare(const CandleColumns& series, size_t from, size_t to) {
+        (void)series;
+        (void)from;
+        (void)to;
+    }
+
+    // Advances indicator state so the next onCandle is bar `from` of
+    // `series`. The default replays the earlier bars and drops their
+    // signals; strategies with cached series jump straight there.
+    virtual void seek(const CandleColumns& series, size_t from) {
+        for (size_t i = 0; i < from; ++i) onCandle(series[i]);
+    }
+
+    std::shared_ptr<IndicatorCache> cache;
+    std::uint64_t cacheSeriesId = 0;
+
+#if TRADING_METRICS
+    int analyzeMetric = -1;  // registered on the first analyze(), labelled with getName()
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "Strategy.hpp"
+
+// Compile-time composition of streaming indicators and a signal rule.
+//
+// StrategyPipeline<Rule, Indicators...> owns one instance of each indicator
+// (any stream with update(double), e.g. RSIStream or MACDStream) and a Rule
+// that turns their latest values into signals. Every type is known at
+// compile time, so run() is a single loop in which the indicator updates and
+// the rule are inlined into each other - no virtual call and no untyped
+// parameter vector per bar.
+//
+// A Rule provides:
+//   struct Params { ... };                          typed parameters
+//   static constexpr const char* name;              strategy name
+//   static constexpr size_t ParameterCount;         values parse() takes
+//   static std::tuple<Indicators...> indicators(const Params&);
+//   static bool parse(const std::vector<double>&, Params&);
+//   explicit Rule(const Params&);
+//   std::optional<Trade> operator()(const Candle&, size_t bar, values...);
+//   void reset();
+// where `values` are the indicators' update() results for the bar.
+template <typename SignalRule, typename... Indicators>
+class StrategyPipeline {
+public:
+    using Rule = SignalRule;
+    using Params = typename Rule::Params;
+
+    explicit StrategyPipeline(const Params& params = Params())
+        : settings(params), indicators(Rule::indicators(params)), rule(params) {}
+
+    const Params& parameters() const { return settings; }
+
+    // Feeds the next bar through every indicator and then the rule.
+    std::optional<Trade> step(const Candle& candle) {
+        size_t i = bar++;
+        return std::apply([&](Indicators&... indicator) {
+            return rule(candle, i, indicator.update(candle.close)...);
+        }, indicators);
+    }
+
+    // Fused pass over `bars`, handing every signal to sink(trade).
+    template <typename Sink>
+    void run(const CandleColumns& bars, Sink&& sink) {
+        for (size_t i = 0; i < bars.size; ++i) {
+            if (auto trade = step(bars[i])) sink(*trade);
+        }
+    }
+
+    void reset() {
+        std::apply([](Indicators&... indicator) { (indicator.reset(), ...); }, indicators);
+        rule.reset();
+        bar = 0;
+    }
+
+private:
+    Params settings;
+    std::tuple<Indicators...> indicators;
+    Rule rule;
+    size_t bar = 0;
+};
+
+// Strategy adapter over a pipeline, so pipelines plug into the Backtester,
+// sweeps and the bridge. The class is final, so its own calls into the
+// pipeline are resolved statically; analyze() and history replay run the
+// fused loop and only per-bar onCandle calls from outside stay virtual.
+// Indicators are always computed in the stream, with or without a cache.
+template <typename Pipeline>
+class PipelineStrategy final : public Strategy {
+private:
+    Pipeline pipeline;
+
+public:
+    using Params = typename Pipeline::Params;
+
+    explicit PipelineStrategy(const Params& params = Params()) : pipeline(params) {}
+
+    std::string getName() const override {
+        return Pipeline::Rule::name;
+    }
+
+    std::optional<Trade> onCandle(const Candle& candle) override {
+        TRADING_TIMED("strategy_on_candle_ns", Pipeline::Rule::name);
+        return pipeline.step(candle);
+    }
+
+    std::vector<Trade> analyze(const CandleColumns& bars) override {
+        TRADING_TIMED("strategy_analyze_ns", Pipeline::Rule::name);
+        begin(bars);
+        std::vector<Trade> trades;
+        pipeline.run(bars, [&trades](const Trade& trade) { trades.push_back(trade); });
+        finish();
+        return trades;
+    }
+
+    void reset() override {
+        pipeline.reset();
+    }
+
+    void updateParameters(const std::vector<double>& params) override {
+        Params parsed = pipeline.parameters();
+        if (Pipeline::Rule::parse(params, parsed)) pipeline = Pipeline(parsed);
+    }
+
+    size_t parameterCount() const override {
+        return Pipeline::Rule::ParameterCount;
+    }
+
+    std::unique_ptr<Strategy> clone() const override {
+        return std::make_unique<PipelineStrategy>(*this);
+    }
+
+    Pipeline& kernel() { return pipeline; }
+
+protected:
+    void seek(const CandleColumns& series, size_t from) override {
+        for (size_t i = 0; i < from; ++i) pipeline.step(series[i]);
+    }
+};
\ No newline at end of file
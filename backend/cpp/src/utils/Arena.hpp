@@ -0,0 +1,167 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Bump allocator for per-run scratch memory.
+//
+// Memory comes from a list of blocks that are kept for the arena's lifetime:
+// rewinding to a marker (or leaving a Scope) only moves the bump pointer
+// back, so once the blocks have grown to a workload's peak every later run
+// of it is served without touching the heap. Arena::local() is one arena
+// per thread, which lets indicator and backtest code borrow scratch space
+// without threading an allocator through every signature.
+//
+// The counters make "no heap allocations after warm-up" checkable: a
+// workload that is warm leaves blockAllocations unchanged.
+class Arena {
+public:
+    struct Stats {
+        size_t blockAllocations = 0;  // heap allocations made by the arena
+        size_t bytesReserved = 0;     // total size of its blocks
+        size_t allocations = 0;       // allocate() calls served
+        size_t bytesInUse = 0;        // currently handed out, padding included
+        size_t peakBytes = 0;         // high-water mark of bytesInUse
+    };
+
+    struct Marker {
+        size_t block;
+        size_t offset;
+        size_t bytesInUse;
+    };
+
+    explicit Arena(size_t blockSize = 1 << 20) : blockSize(blockSize) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        ++counters.allocations;
+        if (bytes == 0) bytes = 1;
+        for (;;) {
+            if (current < blocks.size()) {
+                Block& block = blocks[current];
+                std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data.get());
+                std::uintptr_t start = (base + offset + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+                size_t end = static_cast<size_t>(start - base) + bytes;
+                if (end <= block.size) {
+                    counters.bytesInUse += end - offset;
+                    counters.peakBytes = std::max(counters.peakBytes, counters.bytesInUse);
+                    offset = end;
+                    return reinterpret_cast<void*>(start);
+                }
+                // Whatever is left of this block stays unused until a rewind.
+                counters.bytesInUse += block.size - offset;
+                if (current + 1 < blocks.size() && blocks[current + 1].size >= bytes + alignment) {
+                    ++current;
+                    offset = 0;
+                    continue;
+                }
+            }
+            grow(bytes + alignment);
+        }
+    }
+
+    template <typename T>
+    T* allocate(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    Marker mark() const {
+        return {current, offset, counters.bytesInUse};
+    }
+
+    // Releases everything allocated since `marker` was taken.
+    void rewind(const Marker& marker) {
+        current = marker.block;
+        offset = marker.offset;
+        counters.bytesInUse = marker.bytesInUse;
+    }
+
+    void reset() {
+        rewind(Marker{0, 0, 0});
+    }
+
+    const Stats& stats() const { return counters; }
+
+    // The calling thread's scratch arena.
+    static Arena& local() {
+        thread_local Arena arena;
+        return arena;
+    }
+
+    // Rewinds the arena to where it was when the scope was opened.
+    class Scope {
+    public:
+        explicit Scope(Arena& arena = Arena::local()) : arena(arena), marker(arena.mark()) {}
+        ~Scope() { arena.rewind(marker); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        template <typename T>
+        T* allocate(size_t count) { return arena.allocate<T>(count); }
+
+        Arena& get() const { return arena; }
+
+    private:
+        Arena& arena;
+        Marker marker;
+    };
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    size_t blockSize;
+    std::vector<Block> blocks;
+    size_t current = 0;
+    size_t offset = 0;
+    Stats counters;
+
+    // Inserts a block after the current one, so blocks already past it are
+    // kept for later and markers taken earlier stay valid.
+    void grow(size_t minimum) {
+        size_t size = std::max(blockSize, minimum);
+        size_t at = blocks.empty() ? 0 : current + 1;
+        blocks.insert(blocks.begin() + at, Block{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+        ++counters.blockAllocations;
+        counters.bytesReserved += size;
+        current = at;
+        offset = 0;
+    }
+};
+
+// Standard allocator over an Arena, for containers that only live inside an
+// Arena::Scope. deallocate() is a no-op; memory returns when the scope ends.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena = Arena::local()) : arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) { return arena->allocate<T>(count); }
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+
+private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    Arena* arena;
+};
+
+template <typename T>
+using ScratchVector = std::vector<T, ArenaAllocator<T>>;
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Counter-based generator: draw k of stream s is a pure function of
+// (seed, s, k), computed with the SplitMix64 finalizer. Giving every Monte
+// Carlo path its own stream makes results independent of how paths are
+// spread across threads.
+class CounterRng {
+private:
+    std::uint64_t key;
+    std::uint64_t counter = 0;
+
+    static constexpr std::uint64_t golden = 0x9E3779B97F4A7C15ULL;
+
+    static std::uint64_t mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    CounterRng(std::uint64_t seed, std::uint64_t stream)
+        : key(mix(seed ^ mix(stream * golden + golden))) {}
+
+    std::uint64_t next() {
+        return mix(key + ++counter * golden);
+    }
+
+    // Uniform in [0, n) by multiply-shift; the bias is below 2^-64 * n.
+    std::size_t below(std::size_t n) {
+        return static_cast<std::size_t>((static_cast<unsigned __int128>(next()) * n) >> 64);
+    }
+
+    // Uniform in [0, 1) with 53 random bits.
+    double uniform() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+};
\ No newline at end of file
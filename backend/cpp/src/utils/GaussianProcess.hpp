@@ -0,0 +1,184 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "Arena.hpp"
+#include "ParallelFor.hpp"
+
+// Gaussian-process regression with a squared-exponential kernel
+//
+//   k(a, b) = signalVariance * exp(-|a - b|^2 / (2 * lengthScale^2))
+//
+// and a constant prior mean estimated by generalised least squares.
+//
+// The Cholesky factor L of K + noise * I is kept up to date as observations
+// arrive: add() appends one row to it with a forward solve, so a new
+// observation costs O(n^2) instead of the O(n^3) of refactoring. The
+// weights alpha = K^-1 (y - mean) are refreshed in the same pass, which
+// makes a prediction's mean an O(n) dot product; its variance still needs
+// one O(n^2) triangular solve against L. Predictions are const and safe to
+// run from several threads at once; scratch vectors come from the calling
+// thread's Arena.
+class GaussianProcess {
+public:
+    struct Prediction {
+        double mean;
+        double sd;
+    };
+
+    explicit GaussianProcess(size_t dimensions, double lengthScale = 1.0,
+                             double signalVariance = 1.0, double noiseVariance = 1e-6)
+        : dims(dimensions), signal(signalVariance), noise(noiseVariance) {
+        if (dimensions == 0) throw std::invalid_argument("Gaussian process needs at least one dimension");
+        if (!(lengthScale > 0.0) || !(signalVariance > 0.0) || !(noiseVariance >= 0.0)) {
+            throw std::invalid_argument("Gaussian process hyperparameters must be positive");
+        }
+        inverseTwoLengthSquared = 1.0 / (2.0 * lengthScale * lengthScale);
+    }
+
+    size_t dimensions() const { return dims; }
+    size_t size() const { return y.size(); }
+
+    // Prior mean fitted to the observations so far.
+    double priorMean() const { return prior; }
+
+    void add(const std::vector<double>& point, double value) {
+        if (point.size() != dims) throw std::invalid_argument("Point has the wrong number of dimensions");
+        add(point.data(), value);
+    }
+
+    void add(const double* point, double value) {
+        if (!std::isfinite(value)) throw std::invalid_argument("Gaussian process observations must be finite");
+        size_t n = y.size();
+        x.insert(x.end(), point, point + dims);
+        y.push_back(value);
+
+        // New row of L: solve L l = k(X, point), then the diagonal from
+        // what is left of the point's own variance. Duplicated points
+        // leave almost nothing, so the diagonal is floored for stability.
+        factor.resize(factor.size() + n + 1);
+        double* row = factor.data() + rowOffset(n);
+        for (size_t i = 0; i < n; ++i) row[i] = kernel(x.data() + i * dims, point);
+        forwardSolve(row, n);
+        double rest = signal + noise;
+        for (size_t i = 0; i < n; ++i) rest -= row[i] * row[i];
+        double diagonal = std::sqrt(std::max(rest, 1e-10 * signal));
+        row[n] = diagonal;
+
+        // Extend L^-1 y and L^-1 1 by their last element.
+        double dotY = 0.0;
+        double dotOne = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            dotY += row[i] * solvedY[i];
+            dotOne += row[i] * solvedOne[i];
+        }
+        solvedY.push_back((value - dotY) / diagonal);
+        solvedOne.push_back((1.0 - dotOne) / diagonal);
+
+        refreshWeights();
+    }
+
+    Prediction predict(const std::vector<double>& point) const {
+        if (point.size() != dims) throw std::invalid_argument("Point has the wrong number of dimensions");
+        return predict(point.data());
+    }
+
+    Prediction predict(const double* point) const {
+        size_t n = y.size();
+        if (n == 0) return {prior, std::sqrt(signal)};
+
+        Arena::Scope scratch;
+        double* k = scratch.allocate<double>(n);
+        double mean = prior;
+        for (size_t i = 0; i < n; ++i) {
+            k[i] = kernel(x.data() + i * dims, point);
+            mean += k[i] * alpha[i];
+        }
+        forwardSolve(k, n);
+        double variance = signal;
+        for (size_t i = 0; i < n; ++i) variance -= k[i] * k[i];
+        return {mean, std::sqrt(std::max(variance, 0.0))};
+    }
+
+    // Predicts `count` points stored row-major in `points`, spread over
+    // ParallelFor workers.
+    void predict(const double* points, size_t count, Prediction* out, unsigned threads = 0) const {
+        unsigned workers = ParallelFor::resolveThreads(threads, count);
+        ParallelFor::run(count, workers, [&](size_t i, unsigned) {
+            out[i] = predict(points + i * dims);
+        });
+    }
+
+    void clear() {
+        x.clear();
+        y.clear();
+        factor.clear();
+        solvedY.clear();
+        solvedOne.clear();
+        alpha.clear();
+        prior = 0.0;
+    }
+
+private:
+    static size_t rowOffset(size_t row) { return row * (row + 1) / 2; }
+
+    double kernel(const double* a, const double* b) const {
+        double distance = 0.0;
+        for (size_t d = 0; d < dims; ++d) {
+            double delta = a[d] - b[d];
+            distance += delta * delta;
+        }
+        return signal * std::exp(-distance * inverseTwoLengthSquared);
+    }
+
+    // Overwrites v (length n) with L^-1 v, using the first n rows of L.
+    // Each row's dot product keeps four partial sums so it is not bound by
+    // the latency of one long addition chain.
+    void forwardSolve(double* v, size_t n) const {
+        for (size_t i = 0; i < n; ++i) {
+            const double* row = factor.data() + rowOffset(i);
+            double sums[4] = {0.0, 0.0, 0.0, 0.0};
+            size_t j = 0;
+            for (; j + 4 <= i; j += 4) {
+                for (size_t k = 0; k < 4; ++k) sums[k] += row[j + k] * v[j + k];
+            }
+            for (; j < i; ++j) sums[0] += row[j] * v[j];
+            v[i] = (v[i] - ((sums[0] + sums[1]) + (sums[2] + sums[3]))) / row[i];
+        }
+    }
+
+    // prior = (1' K^-1 y) / (1' K^-1 1) and alpha = L^-T L^-1 (y - prior),
+    // the back substitution sweeping L by rows so it reads memory in order.
+    void refreshWeights() {
+        size_t n = y.size();
+        double oneY = 0.0;
+        double oneOne = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            oneY += solvedOne[i] * solvedY[i];
+            oneOne += solvedOne[i] * solvedOne[i];
+        }
+        prior = oneOne > 0.0 ? oneY / oneOne : 0.0;
+
+        alpha.resize(n);
+        for (size_t i = 0; i < n; ++i) alpha[i] = solvedY[i] - prior * solvedOne[i];
+        for (size_t i = n; i-- > 0;) {
+            const double* row = factor.data() + rowOffset(i);
+            alpha[i] /= row[i];
+            for (size_t j = 0; j < i; ++j) alpha[j] -= row[j] * alpha[i];
+        }
+    }
+
+    size_t dims;
+    double signal;
+    double noise;
+    double inverseTwoLengthSquared;
+
+    std::vector<double> x;          // observed points, row-major
+    std::vector<double> y;
+    std::vector<double> factor;     // L, lower triangle packed by rows
+    std::vector<double> solvedY;    // L^-1 y
+    std::vector<double> solvedOne;  // L^-1 1
+    std::vector<double> alpha;
+    double prior = 0.0;
+};
\ No newline at end of file
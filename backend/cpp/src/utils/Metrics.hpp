@@ -0,0 +1,337 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define TRADING_METRICS_TSC 1
+#endif
+
+// Build with -DTRADING_METRICS=1 to record hot-path metrics. Left at 0 the
+// macros below expand to nothing, so instrumented code compiles exactly as
+// if they were not there.
+#ifndef TRADING_METRICS
+#define TRADING_METRICS 0
+#endif
+
+// Process-wide latency histograms and counters for the hot paths
+// (strategy onCandle/analyze, bridge calls, indicator cache).
+//
+// Metrics are registered once per call site, under a name and a label (for
+// example "strategy_on_candle_ns" / "RSI Strategy"), and recorded into
+// per-thread slots: each thread only ever writes its own slot, with relaxed
+// loads and stores and no read-modify-write instructions, so recording
+// never contends. snapshot() walks the lock-free list of slots and merges
+// them. A slot outlives its thread and is handed to the next thread that
+// starts recording, so totals only ever grow.
+//
+// Histograms are log-linear in the style of HDR histograms: 16 linear
+// sub-buckets per power of two, which bounds the quantile error to about
+// 6%, from 1 up to 2^40 timer ticks. Timers read the TSC where available
+// and are converted to nanoseconds when a snapshot is taken.
+class Metrics {
+public:
+    enum class Kind : std::uint8_t { Counter, Timer };
+
+    static constexpr int maxMetrics = 128;
+
+    struct Sample {
+        Kind kind;
+        const char* name;   // owned by the registry, valid for the process lifetime
+        const char* label;
+        std::uint64_t count;  // events (timers) or total (counters)
+        double sum;           // nanoseconds for timers, the total for counters
+        double min;
+        double max;
+        double p50;
+        double p90;
+        double p99;
+        double p999;
+    };
+
+    // Registers (or finds) a metric and returns its id, or -1 once
+    // maxMetrics are registered; recording into -1 is a no-op.
+    static int timer(const char* name, const std::string& label) {
+        return enroll(Kind::Timer, name, label);
+    }
+
+    static int counter(const char* name, const std::string& label) {
+        return enroll(Kind::Counter, name, label);
+    }
+
+    static void add(int id, std::uint64_t amount) {
+        if (id < 0) return;
+        bump(slot().counters[id], amount);
+    }
+
+    static void record(int id, std::uint64_t ticks) {
+        if (id < 0) return;
+        Slot& own = slot();
+        Histogram* histogram = own.histograms[id].load(std::memory_order_relaxed);
+        if (!histogram) histogram = own.allocate(id);
+        histogram->record(ticks);
+    }
+
+    // Times its own lifetime into a timer.
+    class Scope {
+    public:
+        explicit Scope(int id) : id(id), start(now()) {}
+        ~Scope() { record(id, now() - start); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        int id;
+        std::uint64_t start;
+    };
+
+    static std::uint64_t now() {
+#ifdef TRADING_METRICS_TSC
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Every registered metric, merged across threads.
+    static std::vector<Sample> snapshot() {
+        Registry& metrics = registry();
+        int count = metrics.count.load(std::memory_order_acquire);
+        double scale = nanosPerTick();
+
+        std::vector<Sample> samples;
+        samples.reserve(static_cast<size_t>(count));
+        std::vector<std::uint64_t> buckets(Histogram::buckets);
+        for (int id = 0; id < count; ++id) {
+            const Registry::Entry& entry = metrics.entries[id];
+            Sample sample{entry.kind, entry.name.c_str(), entry.label.c_str(), 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+            if (entry.kind == Kind::Counter) {
+                for (Slot* s = slots().load(std::memory_order_acquire); s; s = s->next) {
+                    sample.count += s->counters[id].load(std::memory_order_relaxed);
+                }
+                sample.sum = static_cast<double>(sample.count);
+                samples.push_back(sample);
+                continue;
+            }
+
+            std::fill(buckets.begin(), buckets.end(), 0);
+            std::uint64_t sum = 0;
+            std::uint64_t low = UINT64_MAX;
+            std::uint64_t high = 0;
+            for (Slot* s = slots().load(std::memory_order_acquire); s; s = s->next) {
+                const Histogram* h = s->histograms[id].load(std::memory_order_acquire);
+                if (!h) continue;
+                for (int b = 0; b < Histogram::buckets; ++b) {
+                    std::uint64_t n = h->counts[b].load(std::memory_order_relaxed);
+                    buckets[b] += n;
+                    sample.count += n;
+                }
+                sum += h->sum.load(std::memory_order_relaxed);
+                low = std::min(low, h->min.load(std::memory_order_relaxed));
+                high = std::max(high, h->max.load(std::memory_order_relaxed));
+            }
+            if (sample.count > 0) {
+                sample.sum = sum * scale;
+                sample.min = low * scale;
+                sample.max = high * scale;
+                sample.p50 = quantile(buckets, sample.count, 0.5, low, high) * scale;
+                sample.p90 = quantile(buckets, sample.count, 0.9, low, high) * scale;
+                sample.p99 = quantile(buckets, sample.count, 0.99, low, high) * scale;
+                sample.p999 = quantile(buckets, sample.count, 0.999, low, high) * scale;
+            }
+            samples.push_back(sample);
+        }
+        return samples;
+    }
+
+    // Nanoseconds per now() tick, calibrated once against steady_clock.
+    static double nanosPerTick() {
+#ifdef TRADING_METRICS_TSC
+        static const double scale = [] {
+            auto wallStart = std::chrono::steady_clock::now();
+            std::uint64_t tickStart = __rdtsc();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            std::uint64_t ticks = __rdtsc() - tickStart;
+            double nanos = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - wallStart).count());
+            return ticks > 0 ? nanos / ticks : 1.0;
+        }();
+        return scale;
+#else
+        return 1.0;
+#endif
+    }
+
+private:
+    // Stores without a locked instruction; only the owning thread writes.
+    static void bump(std::atomic<std::uint64_t>& value, std::uint64_t amount) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    struct Histogram {
+        static constexpr int subBits = 4;
+        static constexpr int topBit = 40;
+        static constexpr int buckets = (topBit - subBits + 1) << subBits;
+
+        std::atomic<std::uint64_t> counts[buckets];
+        std::atomic<std::uint64_t> sum{0};
+        std::atomic<std::uint64_t> min{UINT64_MAX};
+        std::atomic<std::uint64_t> max{0};
+
+        Histogram() {
+            for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+        }
+
+        static int index(std::uint64_t value) {
+            value = std::min(value, (std::uint64_t(1) << topBit) - 1);
+            if (value < (1u << subBits)) return static_cast<int>(value);
+            int exponent = 63 - __builtin_clzll(value);
+            int sub = static_cast<int>(value >> (exponent - subBits)) & ((1 << subBits) - 1);
+            return ((exponent - subBits + 1) << subBits) + sub;
+        }
+
+        // Smallest value that lands in bucket `b`.
+        static std::uint64_t lowerBound(int b) {
+            if (b < (1 << subBits)) return static_cast<std::uint64_t>(b);
+            int exponent = (b >> subBits) + subBits - 1;
+            std::uint64_t sub = static_cast<std::uint64_t>(b & ((1 << subBits) - 1));
+            return ((std::uint64_t(1) << subBits) + sub) << (exponent - subBits);
+        }
+
+        void record(std::uint64_t value) {
+            bump(counts[index(value)], 1);
+            bump(sum, value);
+            if (value < min.load(std::memory_order_relaxed)) min.store(value, std::memory_order_relaxed);
+            if (value > max.load(std::memory_order_relaxed)) max.store(value, std::memory_order_relaxed);
+        }
+    };
+
+    // Midpoint of the bucket holding the q-quantile, clamped to the
+    // observed range.
+    static double quantile(const std::vector<std::uint64_t>& buckets, std::uint64_t count,
+                           double q, std::uint64_t low, std::uint64_t high) {
+        auto rank = static_cast<std::uint64_t>(q * static_cast<double>(count - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (int b = 0; b < Histogram::buckets; ++b) {
+            seen += buckets[b];
+            if (seen < rank) continue;
+            double lo = static_cast<double>(Histogram::lowerBound(b));
+            double hi = b + 1 < Histogram::buckets ? static_cast<double>(Histogram::lowerBound(b + 1)) : lo;
+            double mid = (lo + hi) / 2.0;
+            return std::min(std::max(mid, static_cast<double>(low)), static_cast<double>(high));
+        }
+        return static_cast<double>(high);
+    }
+
+    struct Slot {
+        std::atomic<std::uint64_t> counters[maxMetrics];
+        std::atomic<Histogram*> histograms[maxMetrics];
+        std::atomic<bool> claimed{true};
+        Slot* next = nullptr;  // fixed once the slot is published
+
+        Slot() {
+            for (auto& c : counters) c.store(0, std::memory_order_relaxed);
+            for (auto& h : histograms) h.store(nullptr, std::memory_order_relaxed);
+        }
+
+        Histogram* allocate(int id) {
+            auto histogram = new Histogram();
+            histograms[id].store(histogram, std::memory_order_release);
+            return histogram;
+        }
+    };
+
+    // Slots are never freed: snapshots may be walking them at any time.
+    static std::atomic<Slot*>& slots() {
+        static std::atomic<Slot*> head{nullptr};
+        return head;
+    }
+
+    static Slot* claim() {
+        for (Slot* s = slots().load(std::memory_order_acquire); s; s = s->next) {
+            bool expected = false;
+            if (s->claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) return s;
+        }
+        Slot* fresh = new Slot();
+        fresh->next = slots().load(std::memory_order_relaxed);
+        while (!slots().compare_exchange_weak(fresh->next, fresh,
+                                              std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return fresh;
+    }
+
+    struct Owner {
+        Slot* slot = claim();
+        ~Owner() { slot->claimed.store(false, std::memory_order_release); }
+    };
+
+    static Slot& slot() {
+        thread_local Owner owner;
+        return *owner.slot;
+    }
+
+    struct Registry {
+        struct Entry {
+            Kind kind;
+            std::string name;
+            std::string label;
+        };
+
+        std::mutex mutex;
+        Entry entries[maxMetrics];
+        std::atomic<int> count{0};
+    };
+
+    static Registry& registry() {
+        static Registry metrics;
+        return metrics;
+    }
+
+    static int enroll(Kind kind, const char* name, const std::string& label) {
+        Registry& metrics = registry();
+        std::lock_guard<std::mutex> lock(metrics.mutex);
+        int count = metrics.count.load(std::memory_order_relaxed);
+        for (int id = 0; id < count; ++id) {
+            const Registry::Entry& entry = metrics.entries[id];
+            if (entry.kind == kind && entry.name == name && entry.label == label) return id;
+        }
+        if (count == maxMetrics) return -1;
+        metrics.entries[count] = Registry::Entry{kind, name, label};
+        metrics.count.store(count + 1, std::memory_order_release);
+        return count;
+    }
+};
+
+// TRADING_TIMED(name, label) times the rest of the enclosing block;
+// TRADING_COUNT(name, label, amount) adds to a counter. Both register their
+// metric on first execution, so `label` must be the same on every pass
+// through the call site. TRADING_TIMED_AS(id, name, label) keeps the id in
+// an int lvalue instead, for labels that differ per object (such as a
+// strategy's name); `label` is only evaluated while `id` is negative.
+#if TRADING_METRICS
+#define TRADING_METRICS_CAT2(a, b) a##b
+#define TRADING_METRICS_CAT(a, b) TRADING_METRICS_CAT2(a, b)
+#define TRADING_TIMED(name, label)                                                            \
+    static const int TRADING_METRICS_CAT(tradingMetric, __LINE__) = Metrics::timer(name, label); \
+    Metrics::Scope TRADING_METRICS_CAT(tradingScope, __LINE__)(TRADING_METRICS_CAT(tradingMetric, __LINE__))
+#define TRADING_TIMED_AS(id, name, label) \
+    Metrics::Scope TRADING_METRICS_CAT(tradingScope, __LINE__)((id) >= 0 ? (id) : ((id) = Metrics::timer(name, label)))
+#define TRADING_COUNT(name, label, amount)                           \
+    do {                                                             \
+        static const int tradingMetric = Metrics::counter(name, label); \
+        Metrics::add(tradingMetric, static_cast<std::uint64_t>(amount)); \
+    } while (0)
+#else
+#define TRADING_TIMED(name, label) ((void)0)
+#define TRADING_TIMED_AS(id, name, label) ((void)0)
+#define TRADING_COUNT(name, label, amount) ((void)0)
+#endif
\ No newline at end of file
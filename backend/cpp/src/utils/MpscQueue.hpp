@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+// Bounded multi-producer / single-consumer queue.
+//
+// Each slot carries a sequence number saying whose turn it is: producers
+// claim a position with one compare-and-swap on the tail, fill the slot and
+// hand it to the consumer by advancing its sequence; the consumer hands it
+// back the same way once read. Nothing locks or allocates after
+// construction. A full queue refuses the push rather than wait, leaving
+// the policy to the caller.
+template <typename T>
+class MpscQueue {
+private:
+    struct Cell {
+        std::atomic<std::uint64_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::uint64_t mask;
+
+    alignas(64) std::atomic<std::uint64_t> tail{0};  // next position to claim
+    alignas(64) std::uint64_t head = 0;              // consumer-only: next position to read
+
+public:
+    // `capacity` is rounded up to a power of two.
+    explicit MpscQueue(size_t capacity) {
+        if (capacity == 0) throw std::invalid_argument("MpscQueue needs a capacity");
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+        mask = size - 1;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Producer side; any number of threads.
+    bool push(const T& value) {
+        std::uint64_t position = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & mask];
+            std::uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::int64_t lag = static_cast<std::int64_t>(sequence - position);
+            if (lag == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;  // the consumer has not freed this slot yet
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Positions claimed by producers so far; every push that returned
+    // before this call is below it.
+    std::uint64_t claimed() const { return tail.load(std::memory_order_acquire); }
+
+    // Consumer side; one thread. Copies up to `max` values, in push order,
+    // to `out` and returns how many. Stops early at a slot whose producer
+    // has claimed it but not finished writing.
+    size_t pop(T* out, size_t max) {
+        size_t count = 0;
+        while (count < max) {
+            Cell& cell = cells[head & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != head + 1) break;
+            out[count++] = cell.value;
+            cell.sequence.store(head + mask + 1, std::memory_order_release);
+            ++head;
+        }
+        return count;
+    }
+
+    // Positions read so far.
+    std::uint64_t consumed() const { return head; }
+};
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Runs body(index, worker) for every index in [0, count) across `threads`
+// workers (0 = one per hardware thread) and blocks until all are done.
+//
+// Scheduling is work-stealing: every worker starts with an equal contiguous
+// slice of the index space and pops from its front; a worker whose slice is
+// exhausted steals the back half of the fullest remaining slice. Each slice is
+// a single 64-bit atomic (next, end) updated by CAS, so owners and thieves
+// never take a lock. The first exception thrown by a body is rethrown here.
+class ParallelFor {
+private:
+    struct alignas(64) Slice {
+        std::atomic<std::uint64_t> range{0};
+    };
+
+    static std::uint64_t pack(std::uint32_t next, std::uint32_t end) {
+        return (static_cast<std::uint64_t>(next) << 32) | end;
+    }
+    static std::uint32_t next(std::uint64_t range) { return static_cast<std::uint32_t>(range >> 32); }
+    static std::uint32_t end(std::uint64_t range) { return static_cast<std::uint32_t>(range); }
+
+    static bool pop(Slice& slice, std::uint32_t& index) {
+        std::uint64_t current = slice.range.load(std::memory_order_acquire);
+        while (next(current) < end(current)) {
+            if (slice.range.compare_exchange_weak(current, pack(next(current) + 1, end(current)),
+                                                  std::memory_order_acq_rel)) {
+                index = next(current);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool steal(Slice* slices, unsigned workers, unsigned self) {
+        for (;;) {
+            unsigned victim = workers;
+            std::uint32_t best = 1;
+            for (unsigned w = 0; w < workers; ++w) {
+                if (w == self) continue;
+                std::uint64_t r = slices[w].range.load(std::memory_order_relaxed);
+                std::uint32_t remaining = end(r) > next(r) ? end(r) - next(r) : 0;
+                if (remaining > best) {
+                    best = remaining;
+                    victim = w;
+                }
+            }
+            if (victim == workers) return false;
+
+            std::uint64_t current = slices[victim].range.load(std::memory_order_acquire);
+            std::uint32_t remaining = end(current) > next(current) ? end(current) - next(current) : 0;
+            if (remaining < 2) continue;
+
+            std::uint32_t split = end(current) - remaining / 2;
+            if (slices[victim].range.compare_exchange_strong(current, pack(next(current), split),
+                                                             std::memory_order_acq_rel)) {
+                slices[self].range.store(pack(split, end(current)), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+public:
+    static unsigned resolveThreads(unsigned threads, size_t count) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, count)));
+    }
+
+    template <typename Body>
+    static void run(size_t count, unsigned threads, Body&& body) {
+        if (count == 0) return;
+        if (count > UINT32_MAX) throw std::length_error("ParallelFor: too many tasks");
+
+        unsigned workers = resolveThreads(threads, count);
+        if (workers == 1) {
+            for (size_t i = 0; i < count; ++i) body(i, 0u);
+            return;
+        }
+
+        std::unique_ptr<Slice[]> slices(new Slice[workers]);
+        for (unsigned w = 0; w < workers; ++w) {
+            auto first = static_cast<std::uint32_t>(count * w / workers);
+            auto last = static_cast<std::uint32_t>(count * (w + 1) / workers);
+            slices[w].range.store(pack(first, last), std::memory_order_relaxed);
+        }
+
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        auto worker = [&](unsigned self) {
+            try {
+                std::uint32_t index;
+                do {
+                    while (!failed.load(std::memory_order_relaxed) && pop(slices[self], index)) {
+                        body(static_cast<size_t>(index), self);
+                    }
+                } while (!failed.load(std::memory_order_relaxed) && steal(slices.get(), workers, self));
+            } catch (...) {
+                if (!failed.exchange(true)) error = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for (unsigned w = 1; w < workers; ++w) pool.emplace_back(worker, w);
+        worker(0);
+        for (auto& t : pool) t.join();
+
+        if (error) std::rethrow_exception(error);
+    }
+};
\ No newline at end of file
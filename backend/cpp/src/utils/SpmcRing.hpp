@@ -0,0 +1,160 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+// Bounded single-producer / multi-consumer broadcast ring: every subscribed
+// consumer sees every record published after it subscribed, in order, each
+// reading through its own cursor.
+//
+// Slots are preallocated, so publishing and consuming never allocate or
+// lock. The producer owns the head; each consumer owns one cursor on its own
+// cache line, and the producer only reads the cursors when the ring looks
+// full against a cached minimum. A full ring rejects the publish rather than
+// overwriting records that a consumer has not read yet, leaving the policy
+// (retry, drop, widen) to the caller.
+template <typename T>
+class SpmcRing {
+private:
+    static constexpr std::uint64_t idle = std::numeric_limits<std::uint64_t>::max();
+
+    struct alignas(64) Cursor {
+        std::atomic<std::uint64_t> position{idle};  // next record to read; idle when unused
+        std::atomic<bool> claimed{false};
+    };
+
+    std::unique_ptr<T[]> slots;
+    std::unique_ptr<Cursor[]> cursors;
+    std::uint64_t mask;
+    size_t consumerCount;
+
+    alignas(64) std::atomic<std::uint64_t> head{0};  // records published so far
+    alignas(64) std::uint64_t gate = 0;              // producer-only: cached slowest cursor
+
+public:
+    // `capacity` is rounded up to a power of two; at most `maxConsumers`
+    // cursors can be subscribed at once.
+    SpmcRing(size_t capacity, size_t maxConsumers)
+        : consumerCount(maxConsumers) {
+        if (capacity == 0 || maxConsumers == 0) {
+            throw std::invalid_argument("SpmcRing needs a capacity and at least one consumer");
+        }
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots.reset(new T[size]);
+        cursors.reset(new Cursor[maxConsumers]);
+        mask = size - 1;
+    }
+
+    SpmcRing(const SpmcRing&) = delete;
+    SpmcRing& operator=(const SpmcRing&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+    std::uint64_t published() const { return head.load(std::memory_order_acquire); }
+
+    // Producer side. Appends up to `count` records and returns how many fit;
+    // the rest would overwrite records a consumer has not read yet.
+    size_t publish(const T* records, size_t count) {
+        std::uint64_t position = head.load(std::memory_order_relaxed);
+        if (position + count - gate > capacity()) gate = slowest(position);
+        std::uint64_t used = position - gate;
+        size_t room = used < capacity() ? static_cast<size_t>(capacity() - used) : 0;
+        count = std::min(count, room);
+
+        for (size_t i = 0; i < count; ++i) slots[(position + i) & mask] = records[i];
+        head.store(position + count, std::memory_order_release);
+        return count;
+    }
+
+    bool publish(const T& record) {
+        return publish(&record, 1) == 1;
+    }
+
+    // Consumer side. subscribe() claims a cursor starting at the next record
+    // to be published and returns its id, or -1 when every cursor is taken.
+    int subscribe() {
+        for (size_t id = 0; id < consumerCount; ++id) {
+            bool expected = false;
+            Cursor& cursor = cursors[id];
+            if (!cursor.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) continue;
+
+            // Joining while the producer runs: the cursor is first parked at
+            // a head it may already have passed, so a producer that sees it
+            // stops short, and the fence guarantees that a producer that did
+            // not see it cannot have published past the head re-read here.
+            cursor.position.store(head.load(std::memory_order_acquire), std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            cursor.position.store(head.load(std::memory_order_acquire), std::memory_order_release);
+            return static_cast<int>(id);
+        }
+        return -1;
+    }
+
+    void unsubscribe(int id) {
+        Cursor& cursor = cursors[checked(id)];
+        cursor.position.store(idle, std::memory_order_release);
+        cursor.claimed.store(false, std::memory_order_release);
+    }
+
+    // Records published but not yet read by consumer `id`.
+    size_t pending(int id) const {
+        std::uint64_t position = cursors[checked(id)].position.load(std::memory_order_relaxed);
+        return static_cast<size_t>(head.load(std::memory_order_acquire) - position);
+    }
+
+    // Copies up to `max` unread records to `out` and advances the cursor.
+    size_t poll(int id, T* out, size_t max) {
+        return consume(id, max, [out](const T* first, size_t count, size_t done) {
+            std::copy(first, first + count, out + done);
+        });
+    }
+
+    // Calls visit(record) in place for up to `max` unread records, then
+    // advances the cursor past them. The producer cannot reuse a slot until
+    // the cursor moves, so the references stay valid inside `visit`.
+    template <typename Visit>
+    size_t drain(int id, size_t max, Visit&& visit) {
+        return consume(id, max, [&visit](const T* first, size_t count, size_t) {
+            for (size_t i = 0; i < count; ++i) visit(first[i]);
+        });
+    }
+
+private:
+    size_t checked(int id) const {
+        if (id < 0 || static_cast<size_t>(id) >= consumerCount) {
+            throw std::out_of_range("SpmcRing: unknown consumer");
+        }
+        return static_cast<size_t>(id);
+    }
+
+    // Slowest subscribed cursor, or `position` when nobody is subscribed.
+    std::uint64_t slowest(std::uint64_t position) const {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t lowest = position;
+        for (size_t id = 0; id < consumerCount; ++id) {
+            lowest = std::min(lowest, cursors[id].position.load(std::memory_order_acquire));
+        }
+        return lowest;
+    }
+
+    // Hands the unread records to `take` as at most two contiguous runs
+    // (before and after the wrap) and then releases their slots.
+    template <typename Take>
+    size_t consume(int id, size_t max, Take&& take) {
+        Cursor& cursor = cursors[checked(id)];
+        std::uint64_t position = cursor.position.load(std::memory_order_relaxed);
+        size_t count = std::min(max, static_cast<size_t>(head.load(std::memory_order_acquire) - position));
+        if (count == 0) return 0;
+
+        size_t first = static_cast<size_t>(position & mask);
+        size_t run = std::min(count, capacity() - first);
+        take(slots.get() + first, run, 0);
+        if (run < count) take(slots.get(), count - run, run);
+        cursor.position.store(position + count, std::memory_order_release);
+        return count;
+    }
+};
\ No newline at end of file
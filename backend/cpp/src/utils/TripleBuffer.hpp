@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Wait-free hand-over of the latest value from one producer thread to one
+// consumer thread.
+//
+// Three slots rotate between the roles: the producer fills its back slot
+// and publish() swaps it with the middle one, flagging it fresh; the
+// consumer's update() swaps its front slot with a fresh middle. Each side
+// only ever does one atomic exchange, so neither waits for the other, and
+// values published faster than the consumer looks are skipped. A slot the
+// consumer gives up returns to the producer, which overwrites it in place:
+// whatever that slot owned is released on the producer's thread.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer side: the slot to fill before the next publish().
+    T& back() { return slots[writing]; }
+
+    void publish() {
+        writing = middle.exchange(static_cast<std::uint8_t>(writing | fresh), std::memory_order_acq_rel) & slotMask;
+    }
+
+    // Consumer side: moves to the latest published value, if there is one
+    // newer than front(); returns whether it did.
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & fresh)) return false;
+        reading = middle.exchange(reading, std::memory_order_acq_rel) & slotMask;
+        return true;
+    }
+
+    T& front() { return slots[reading]; }
+    const T& front() const { return slots[reading]; }
+
+private:
+    static constexpr std::uint8_t slotMask = 3;
+    static constexpr std::uint8_t fresh = 4;
+
+    T slots[3];
+    alignas(64) std::atomic<std::uint8_t> middle{1};
+    alignas(64) std::uint8_t writing = 0;  // producer-only
+    alignas(64) std::uint8_t reading = 2;  // consumer-only
+};
\ No newline at end of file
@@ -0,0 +1,33 @@
+// Converts a timestamp,open,high,low,close,volume CSV into a CandleStore.
+//
+//     csv2store <input.csv> <output.candles>
+#include "../src/storage/CandleStore.hpp"
+#include <chrono>
+#include <cstdio>
+#include <exception>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <input.csv> <output.candles>\n", argv[0]);
+        return 2;
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        size_t count = CandleStore::convertCsv(argv[1], argv[2]);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        CandleStore store(argv[2]);
+        const auto& bars = store.columns();
+        std::printf("wrote %zu candles to %s in %.2fs", count, argv[2], elapsed.count());
+        if (bars.size > 0) {
+            std::printf(" (%lld .. %lld)", static_cast<long long>(bars.timestampAt(0)),
+                        static_cast<long long>(bars.timestampAt(bars.size - 1)));
+        }
+        std::printf("\n");
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "csv2store: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
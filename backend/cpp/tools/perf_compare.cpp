@@ -0,0 +1,94 @@
+// Compares two perf_suite outputs case by case and flags regressions.
+//
+//     perf_compare <base.jsonl> <head.jsonl> [threshold]
+//
+// A case regresses when its median ns/bar grew by more than `threshold`
+// (default 0.10 = 10%) or it makes at least one more heap allocation per
+// run than before. Exits 1 if any case regressed, so the comparison can
+// gate a rollout.
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace {
+
+struct Case {
+    double nsPerBar = 0.0;
+    double allocations = 0.0;
+};
+
+using Key = std::pair<std::string, unsigned long long>;
+
+// perf_suite writes flat one-line objects, so a field is found by name.
+bool field(const std::string& line, const char* name, std::string& value) {
+    std::string needle = std::string("\"") + name + "\":";
+    size_t at = line.find(needle);
+    if (at == std::string::npos) return false;
+    at += needle.size();
+    if (line[at] == '"') {
+        size_t end = line.find('"', at + 1);
+        value = line.substr(at + 1, end - at - 1);
+    } else {
+        size_t end = line.find_first_of(",}", at);
+        value = line.substr(at, end - at);
+    }
+    return true;
+}
+
+bool load(const char* path, std::map<Key, Case>& cases, std::string& commit) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::string type, bench, bars, ns, allocations;
+        if (!field(line, "type", type)) continue;
+        if (type == "meta") {
+            field(line, "commit", commit);
+            continue;
+        }
+        if (type != "case" || !field(line, "bench", bench) || !field(line, "bars", bars) ||
+            !field(line, "ns_per_bar", ns) || !field(line, "allocations_per_run", allocations)) {
+            continue;
+        }
+        cases[{bench, std::strtoull(bars.c_str(), nullptr, 10)}] =
+            Case{std::strtod(ns.c_str(), nullptr), std::strtod(allocations.c_str(), nullptr)};
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3 && argc != 4) {
+        std::fprintf(stderr, "usage: %s <base.jsonl> <head.jsonl> [threshold]\n", argv[0]);
+        return 2;
+    }
+    double threshold = argc == 4 ? std::strtod(argv[3], nullptr) : 0.10;
+
+    std::map<Key, Case> base, head;
+    std::string baseCommit = "?", headCommit = "?";
+    if (!load(argv[1], base, baseCommit) || !load(argv[2], head, headCommit)) {
+        std::fprintf(stderr, "perf_compare: cannot read input\n");
+        return 2;
+    }
+
+    std::printf("%-32s %11s %12s %12s %8s %10s\n", "bench", "bars", baseCommit.c_str(), headCommit.c_str(),
+                "change", "allocs");
+    int regressions = 0;
+    for (const auto& [key, now] : head) {
+        auto before = base.find(key);
+        if (before == base.end()) continue;
+        double change = before->second.nsPerBar > 0.0 ? now.nsPerBar / before->second.nsPerBar - 1.0 : 0.0;
+        bool slower = change > threshold;
+        bool allocates = now.allocations > before->second.allocations + 0.5;
+        if (slower || allocates) ++regressions;
+        std::printf("%-32s %11llu %12.3f %12.3f %+7.1f%% %4.0f->%-4.0f%s\n", key.first.c_str(), key.second,
+                    before->second.nsPerBar, now.nsPerBar, change * 100.0, before->second.allocations,
+                    now.allocations, slower || allocates ? "  REGRESSION" : "");
+    }
+    std::printf("%d regression(s) at threshold %.0f%%\n", regressions, threshold * 100.0);
+    return regressions > 0 ? 1 : 0;
+}
\ No newline at end of file
@@ -8,6 +8,8 @@ import (
 
 	"github.com/gorilla/mux"
 	"github.com/gorilla/websocket"
+
+	"trading-platform/services"
 )
 
 var upgrader = websocket.Upgrader{
@@ -25,6 +27,7 @@ type MarketData struct {
 
 func main() {
 	r := mux.NewRouter()
+	strategyManager := services.NewStrategyManager(services.NewMarketDataService())
 
 	// REST endpoints
 	r.HandleFunc("/api/market/price/{symbol}", getPriceHandler).Methods("GET")
@@ -33,6 +36,10 @@ func main() {
 	r.HandleFunc("/api/strategies/{id}/deactivate", deactivateStrategyHandler).Methods("POST")
 	r.HandleFunc("/api/backtest", backtestHandler).Methods("POST")
 
+	// Prometheus scrape endpoint for the strategy library's metrics and
+	// the strategy manager's gauges
+	r.Handle("/metrics", strategyManager.MetricsHandler()).Methods("GET")
+
 	// WebSocket endpoint
 	r.HandleFunc("/ws/market", marketDataWebSocket)
 
@@ -1,25 +1,58 @@
 package services
 
 import (
+    "fmt"
+    "log"
+    "net/http"
     "sync"
     "time"
-    "trading-platform/models"
     "trading-platform/trading"
 )
 
+// Bars reach the strategies through a trading.Feed: one publisher
+// goroutine polls the market data and publishes each bar once, and one
+// manager loop reads the feed and evaluates every active strategy on the
+// new bars in a single trading.Batch run.
+const feedCapacity = 1024
+
 type StrategyManager struct {
     strategies map[string]*trading.Strategy
-    activeStrategies map[string]bool
+    activeStrategies map[string]*activeStrategy
     mutex sync.RWMutex
     marketData *MarketDataService
+    journal *trading.Journal
+    feed *trading.Feed
+    cursor *trading.FeedCursor
+    published chan struct{}
+}
+
+// activeStrategy is a strategy the manager loop feeds. It is fresh until
+// its first batch, which replays from a clean state.
+type activeStrategy struct {
+    strategy *trading.Strategy
+    fresh    bool
 }
 
 func NewStrategyManager(marketData *MarketDataService) *StrategyManager {
-    return &StrategyManager{
+    feed, err := trading.NewFeed(feedCapacity, 1)
+    if err != nil {
+        log.Fatalf("Failed to create market data feed: %v", err)
+    }
+    cursor, err := feed.Subscribe()
+    if err != nil {
+        log.Fatalf("Failed to subscribe to market data feed: %v", err)
+    }
+    sm := &StrategyManager{
         strategies: make(map[string]*trading.Strategy),
-        activeStrategies: make(map[string]bool),
+        activeStrategies: make(map[string]*activeStrategy),
         marketData: marketData,
+        feed: feed,
+        cursor: cursor,
+        published: make(chan struct{}, 1),
     }
+    go sm.publish()
+    go sm.run()
+    return sm
 }
 
 func (sm *StrategyManager) RegisterStrategy(id string, strategyType string, params map[string]interface{}) error {
@@ -45,26 +78,41 @@ func (sm *StrategyManager) RegisterStrategy(id string, strategyType string, para
         )
     }
 
-    if strategy != nil {
-        sm.strategies[id] = strategy
+    if strategy == nil {
+        return fmt.Errorf("invalid %s parameters for strategy %s", strategyType, id)
     }
+    sm.strategies[id] = strategy
 
     return nil
 }
 
+// ActivateStrategy starts feeding the strategy every bar published from
+// now on, from a clean state.
 func (sm *StrategyManager) ActivateStrategy(id string) error {
     sm.mutex.Lock()
     defer sm.mutex.Unlock()
 
-    if _, exists := sm.strategies[id]; !exists {
+    strategy, exists := sm.strategies[id]
+    if !exists {
         return fmt.Errorf("strategy not found: %s", id)
     }
-
-    sm.activeStrategies[id] = true
-    go sm.runStrategy(id)
+    if _, active := sm.activeStrategies[id]; !active {
+        sm.activeStrategies[id] = &activeStrategy{strategy: strategy, fresh: true}
+    }
     return nil
 }
 
+// SetJournal records the market data every active strategy sees and the
+// signals it generates to journal, each strategy under the stream
+// trading.JournalStream(id), so sessions can be replayed offline with
+// trading.ReplayJournal. Pass nil to stop journaling.
+func (sm *StrategyManager) SetJournal(journal *trading.Journal) {
+    sm.mutex.Lock()
+    defer sm.mutex.Unlock()
+
+    sm.journal = journal
+}
+
 func (sm *StrategyManager) DeactivateStrategy(id string) error {
     sm.mutex.Lock()
     defer sm.mutex.Unlock()
@@ -73,28 +121,97 @@ func (sm *StrategyManager) DeactivateStrategy(id string) error {
     return nil
 }
 
-func (sm *StrategyManager) runStrategy(id string) {
-    strategy := sm.strategies[id]
+// MetricsHandler serves the strategy library's hot-path metrics (see
+// trading.WriteMetrics) together with the manager's own strategy counts.
+func (sm *StrategyManager) MetricsHandler() http.Handler {
+    library := trading.MetricsHandler()
+    return http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+        sm.mutex.RLock()
+        registered, active := len(sm.strategies), len(sm.activeStrategies)
+        sm.mutex.RUnlock()
+
+        library.ServeHTTP(w, r)
+        fmt.Fprintf(w, "# TYPE trading_strategies_registered gauge\ntrading_strategies_registered %d\n", registered)
+        fmt.Fprintf(w, "# TYPE trading_strategies_active gauge\ntrading_strategies_active %d\n", active)
+    })
+}
+
+// publish polls the market data once a second and publishes each bar to
+// the feed.
+func (sm *StrategyManager) publish() {
     ticker := time.NewTicker(time.Second)
     defer ticker.Stop()
 
-    for {
+    bar := make([]trading.Candle, 1)
+    for range ticker.C {
+        data := sm.marketData.GetLatestPrice("BTC/USD")
+        bar[0] = trading.Candle{
+            Timestamp: data.Timestamp.Unix(),
+            Open:      data.Price,
+            High:      data.Price,
+            Low:       data.Price,
+            Close:     data.Price,
+            Volume:    data.Volume,
+        }
+        if sm.feed.Publish(bar) == 0 {
+            log.Printf("Market data feed is full, dropped bar at %d", bar[0].Timestamp)
+            continue
+        }
         select {
-        case <-ticker.C:
-            sm.mutex.RLock()
-            isActive := sm.activeStrategies[id]
-            sm.mutex.RUnlock()
+        case sm.published <- struct{}{}:
+        default:
+        }
+    }
+}
 
-            if !isActive {
-                return
-            }
+// run drains the feed whenever a bar is published and feeds the new bars
+// to every active strategy, on top of its state, in one batch: a tick
+// costs one bridge call however many strategies are active. Each
+// strategy's bars and signals are journaled under
+// trading.JournalStream(id) exactly as it saw them, so
+// trading.ReplayJournal reproduces the session as long as its parameters
+// were not changed while it ran.
+func (sm *StrategyManager) run() {
+    var batch trading.Batch
+    defer batch.Close()
+    bars := make([]trading.Candle, feedCapacity)
+    var jobs []trading.BatchJob
+    var ids []string
+
+    for range sm.published {
+        n := sm.cursor.Poll(bars)
+        if n == 0 {
+            continue
+        }
 
-            // Get latest market data
-            data := sm.marketData.GetLatestPrice("BTC/USD")
-            prices := []float64{data.Price}
+        sm.mutex.Lock()
+        jobs, ids = jobs[:0], ids[:0]
+        for id, active := range sm.activeStrategies {
+            jobs = append(jobs, trading.BatchJob{Strategy: active.strategy, Candles: bars[:n], Reset: active.fresh})
+            ids = append(ids, id)
+            active.fresh = false
+        }
+        journal := sm.journal
+        sm.mutex.Unlock()
 
-            // Analyze market data
-            if signal := strategy.AnalyzeMarketData(prices); signal != nil {
+        if journal != nil {
+            for _, id := range ids {
+                journal.AppendCandles(trading.JournalStream(id), bars[:n])
+            }
+        }
+        if len(jobs) == 0 {
+            continue
+        }
+        signals, err := batch.Run(jobs, 0)
+        if err != nil {
+            log.Printf("Failed to analyze market data: %v", err)
+            continue
+        }
+        for i, id := range ids {
+            if journal != nil && len(signals[i]) > 0 {
+                journal.AppendSignals(trading.JournalStream(id), signals[i])
+            }
+            for _, signal := range signals[i] {
                 // Execute trade based on signal
                 // This is where you would integrate with your trading execution service
                 log.Printf("Strategy %s generated signal: %+v", id, signal)
@@ -1,6 +1,7 @@
 package services
 
 import (
+    "log"
     "sync"
     "time"
     "trading-platform/trading"
@@ -8,46 +9,72 @@ import (
 
 type StrategyService struct {
     strategies map[string]*trading.Strategy
+    kinds      map[string]string
     mutex      sync.RWMutex
+
+    // AnalyzeMarkets reuses its batch and buffers under batchMutex.
+    batchMutex sync.Mutex
+    batch      trading.Batch
+    candles    []trading.Candle
+    ids        []string
+    jobs       []trading.BatchJob
 }
 
 func NewStrategyService() *StrategyService {
     return &StrategyService{
         strategies: make(map[string]*trading.Strategy),
+        kinds:      make(map[string]string),
     }
 }
 
 func (s *StrategyService) CreateRSIStrategy(id string, period int, oversold, overbought float64) {
-    s.mutex.Lock()
-    defer s.mutex.Unlock()
-
-    if strategy, exists := s.strategies[id]; exists {
-        strategy.Close()
-    }
-
-    s.strategies[id] = trading.NewRSIStrategy(period, oversold, overbought)
+    s.install(id, "rsi", []float64{float64(period), oversold, overbought}, func() *trading.Strategy {
+        return trading.NewRSIStrategy(period, oversold, overbought)
+    })
 }
 
 func (s *StrategyService) CreateMACDStrategy(id string, fastPeriod, slowPeriod, signalPeriod int, threshold float64) {
-    s.mutex.Lock()
-    defer s.mutex.Unlock()
-
-    if strategy, exists := s.strategies[id]; exists {
-        strategy.Close()
-    }
-
-    s.strategies[id] = trading.NewMACDStrategy(fastPeriod, slowPeriod, signalPeriod, threshold)
+    params := []float64{float64(fastPeriod), float64(slowPeriod), float64(signalPeriod), threshold}
+    s.install(id, "macd", params, func() *trading.Strategy {
+        return trading.NewMACDStrategy(fastPeriod, slowPeriod, signalPeriod, threshold)
+    })
 }
 
 func (s *StrategyService) CreateBollingerBandsStrategy(id string, period int, multiplier, percentageB float64) {
+    s.install(id, "bbands", []float64{float64(period), multiplier, percentageB}, func() *trading.Strategy {
+        return trading.NewBollingerBandsStrategy(period, multiplier, percentageB)
+    })
+}
+
+// install registers a live strategy under id. If one of the same kind is
+// already there it is retuned in place instead: analyses running on it
+// carry on, and switch to the new parameters once they have been rebuilt
+// in the background.
+func (s *StrategyService) install(id, kind string, params []float64, create func() *trading.Strategy) {
     s.mutex.Lock()
     defer s.mutex.Unlock()
 
     if strategy, exists := s.strategies[id]; exists {
+        if s.kinds[id] == kind {
+            if _, err := strategy.UpdateParameters(params); err == nil {
+                return
+            }
+        }
         strategy.Close()
     }
 
-    s.strategies[id] = trading.NewBollingerBandsStrategy(period, multiplier, percentageB)
+    strategy := create()
+    if strategy == nil {
+        delete(s.strategies, id)
+        delete(s.kinds, id)
+        log.Printf("strategy %s: invalid %s parameters %v", id, kind, params)
+        return
+    }
+    if live, err := trading.NewLiveStrategy(strategy, 0); err == nil {
+        strategy = live
+    }
+    s.strategies[id] = strategy
+    s.kinds[id] = kind
 }
 
 func (s *StrategyService) RemoveStrategy(id string) {
@@ -57,27 +84,83 @@ func (s *StrategyService) RemoveStrategy(id string) {
     if strategy, exists := s.strategies[id]; exists {
         strategy.Close()
         delete(s.strategies, id)
+        delete(s.kinds, id)
     }
 }
 
+// AnalyzeMarket replays prices through strategy id from a clean state and
+// returns the last signal they trigger, or nil.
 func (s *StrategyService) AnalyzeMarket(id string, prices []float64) *trading.TradeSignal {
+    return s.AnalyzeMarkets(map[string][]float64{id: prices})[id]
+}
+
+// AnalyzeMarkets is AnalyzeMarket for many strategies at once, evaluated
+// in a single bridge call. Unknown ids and ids without a signal are left
+// out of the result.
+func (s *StrategyService) AnalyzeMarkets(prices map[string][]float64) map[string]*trading.TradeSignal {
+    s.batchMutex.Lock()
+    defer s.batchMutex.Unlock()
+
+    // Prices become flat bars stamped a minute apart up to now, as the
+    // native analyze_market_data did. The bars of every id go into one
+    // buffer first, since appending may move it, and are sliced after.
+    now := time.Now().Unix()
+    s.candles = s.candles[:0]
+    s.ids = s.ids[:0]
+    s.jobs = s.jobs[:0]
     s.mutex.RLock()
-    strategy, exists := s.strategies[id]
-    s.mutex.RUnlock()
+    defer s.mutex.RUnlock()
+    for id, series := range prices {
+        strategy, exists := s.strategies[id]
+        if !exists || len(series) == 0 {
+            continue
+        }
+        for i, price := range series {
+            s.candles = append(s.candles, trading.Candle{
+                Timestamp: now - int64(len(series)-i)*60,
+                Open:      price,
+                High:      price,
+                Low:       price,
+                Close:     price,
+                Volume:    1000,
+            })
+        }
+        s.ids = append(s.ids, id)
+        s.jobs = append(s.jobs, trading.BatchJob{Strategy: strategy, Reset: true})
+    }
 
-    if !exists {
+    offset := 0
+    for i, id := range s.ids {
+        size := len(prices[id])
+        s.jobs[i].Candles = s.candles[offset : offset+size]
+        offset += size
+    }
+    results, err := s.batch.Run(s.jobs, 0)
+    if err != nil {
+        log.Printf("Failed to analyze market data: %v", err)
         return nil
     }
 
-    return strategy.AnalyzeMarketData(prices)
+    signals := make(map[string]*trading.TradeSignal, len(s.ids))
+    for i, id := range s.ids {
+        if n := len(results[i]); n > 0 {
+            signal := results[i][n-1]
+            signals[id] = &signal
+        }
+    }
+    return signals
 }
 
 func (s *StrategyService) Close() {
+    s.batchMutex.Lock()
+    defer s.batchMutex.Unlock()
     s.mutex.Lock()
     defer s.mutex.Unlock()
 
+    s.batch.Close()
     for _, strategy := range s.strategies {
         strategy.Close()
     }
     s.strategies = make(map[string]*trading.Strategy)
+    s.kinds = make(map[string]string)
 }
\ No newline at end of file
@@ -1,36 +1,122 @@
 #include "bridge.h"
-#include "../cpp/src/strategies/RSIStrategy.hpp"
-#include "../cpp/src/strategies/MACDStrategy.hpp"
-#include "../cpp/src/strategies/BollingerBandsStrategy.hpp"
+#include "../../cpp/src/strategies/RSIStrategy.hpp"
+#include "../../cpp/src/strategies/MACDStrategy.hpp"
+#include "../../cpp/src/strategies/BollingerBandsStrategy.hpp"
+#include "../../cpp/src/strategies/LiveStrategy.hpp"
+#include "../../cpp/src/backtesting/ParameterSweep.hpp"
+#include "../../cpp/src/backtesting/MonteCarlo.hpp"
+#include "../../cpp/src/backtesting/WalkForward.hpp"
+#include "../../cpp/src/backtesting/BayesianOptimizer.hpp"
+#include "../../cpp/src/backtesting/JournalReplay.hpp"
+#include "../../cpp/src/utils/SpmcRing.hpp"
+#include "../../cpp/src/aggregation/BarAggregator.hpp"
+#include "../../cpp/src/utils/Metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <memory>
 #include <vector>
 
+static_assert(sizeof(CandleData) == sizeof(Candle) &&
+              sizeof(long long) == sizeof(std::time_t) &&
+              offsetof(CandleData, timestamp) == offsetof(Candle, timestamp) &&
+              offsetof(CandleData, open) == offsetof(Candle, open) &&
+              offsetof(CandleData, high) == offsetof(Candle, high) &&
+              offsetof(CandleData, low) == offsetof(Candle, low) &&
+              offsetof(CandleData, close) == offsetof(Candle, close) &&
+              offsetof(CandleData, volume) == offsetof(Candle, volume),
+              "CandleData must mirror Candle for zero-copy analysis");
+
+static_assert(sizeof(TickData) == sizeof(Tick) &&
+              offsetof(TickData, timestamp) == offsetof(Tick, timestamp) &&
+              offsetof(TickData, price) == offsetof(Tick, price) &&
+              offsetof(TickData, volume) == offsetof(Tick, volume),
+              "TickData must mirror Tick for zero-copy aggregation");
+
+// Process-wide indicator cache shared by every sweep over a caller-chosen
+// series id.
+static std::shared_ptr<IndicatorCache> sharedIndicatorCache() {
+    static auto cache = std::make_shared<IndicatorCache>();
+    return cache;
+}
+
+// Cache for one call over `seriesId`. Without an id no later call could
+// hit its series, so they go to a private cache freed with the call
+// rather than evict other callers' entries from the shared one.
+static std::shared_ptr<IndicatorCache> callCache(std::uint64_t seriesId) {
+    return seriesId != 0 ? sharedIndicatorCache() : std::make_shared<IndicatorCache>();
+}
+
+static TradeSignal toSignal(const Trade& trade) {
+    return TradeSignal{
+        trade.price,
+        trade.amount,
+        toString(trade.type),
+        static_cast<long long>(trade.timestamp),
+        toString(trade.reason)
+    };
+}
+
+// Inverse of toSignal, for signals coming back from Go. Unknown labels map
+// to TradeReason::None.
+static Trade fromSignal(const TradeSignal& signal) {
+    TradeType type = signal.type && std::strcmp(signal.type, toString(TradeType::Sell)) == 0
+        ? TradeType::Sell : TradeType::Buy;
+    TradeReason reason = TradeReason::None;
+    for (auto r = static_cast<std::uint8_t>(TradeReason::None);
+         r <= static_cast<std::uint8_t>(TradeReason::RSIOverboughtEMAResistance); ++r) {
+        if (signal.reason && std::strcmp(signal.reason, toString(static_cast<TradeReason>(r))) == 0) {
+            reason = static_cast<TradeReason>(r);
+            break;
+        }
+    }
+    return Trade{type, static_cast<std::time_t>(signal.timestamp), signal.price, signal.amount, reason};
+}
+
 extern "C" {
 
 void* create_rsi_strategy(int period, double oversold, double overbought) {
     auto strategy = new RSIStrategy();
-    strategy->updateParameters({static_cast<double>(period), oversold, overbought});
+    try {
+        strategy->updateParameters({static_cast<double>(period), oversold, overbought});
+    } catch (...) {
+        delete strategy;
+        return nullptr;
+    }
     return static_cast<void*>(strategy);
 }
 
 void* create_macd_strategy(int fastPeriod, int slowPeriod, int signalPeriod, double threshold) {
     auto strategy = new MACDStrategy();
-    strategy->updateParameters({
-        static_cast<double>(fastPeriod),
-        static_cast<double>(slowPeriod),
-        static_cast<double>(signalPeriod),
-        threshold
-    });
+    try {
+        strategy->updateParameters({
+            static_cast<double>(fastPeriod),
+            static_cast<double>(slowPeriod),
+            static_cast<double>(signalPeriod),
+            threshold
+        });
+    } catch (...) {
+        delete strategy;
+        return nullptr;
+    }
     return static_cast<void*>(strategy);
 }
 
 void* create_bbands_strategy(int period, double multiplier, double percentageB) {
     auto strategy = new BollingerBandsStrategy();
-    strategy->updateParameters({
-        static_cast<double>(period),
-        multiplier,
-        percentageB
-    });
+    try {
+        strategy->updateParameters({
+            static_cast<double>(period),
+            multiplier,
+            percentageB
+        });
+    } catch (...) {
+        delete strategy;
+        return nullptr;
+    }
     return static_cast<void*>(strategy);
 }
 
@@ -38,7 +124,40 @@ void destroy_strategy(void* strategy) {
     delete static_cast<Strategy*>(strategy);
 }
 
+void* create_live_strategy(void* strategy, int historyBars) {
+    if (!strategy) return nullptr;
+    try {
+        auto live = new LiveStrategy(static_cast<Strategy*>(strategy)->clone(),
+                                     historyBars > 0 ? static_cast<size_t>(historyBars) : 1024);
+        delete static_cast<Strategy*>(strategy);
+        return static_cast<void*>(static_cast<Strategy*>(live));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+long long update_strategy_parameters(void* strategy, const double* params, int count) {
+    auto tradingStrategy = static_cast<Strategy*>(strategy);
+    if (!tradingStrategy || !params || count <= 0) return -1;
+    try {
+        std::vector<double> values(params, params + count);
+        if (auto live = dynamic_cast<LiveStrategy*>(tradingStrategy)) {
+            return static_cast<long long>(live->publish(values));
+        }
+        tradingStrategy->updateParameters(values);
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+unsigned long long strategy_parameters_version(void* strategy) {
+    auto live = dynamic_cast<LiveStrategy*>(static_cast<Strategy*>(strategy));
+    return live ? live->appliedVersion() : 0;
+}
+
 TradeSignal* analyze_market_data(void* strategy, double* prices, int size) {
+    TRADING_TIMED("bridge_call_ns", "analyze_market_data");
     auto tradingStrategy = static_cast<Strategy*>(strategy);
     
     std::vector<Candle> candles;
@@ -50,24 +169,652 @@ TradeSignal* analyze_market_data(void* strategy, double* prices, int size) {
         });
     }
     
+    TRADING_COUNT("bridge_bytes_copied", "analyze_market_data", candles.size() * sizeof(Candle));
     auto trades = tradingStrategy->analyze(candles);
     if (trades.empty()) {
         return nullptr;
     }
     
-    auto lastTrade = trades.back();
-    auto signal = new TradeSignal{
-        lastTrade.price,
-        lastTrade.amount,
-        lastTrade.type.c_str(),
-        lastTrade.timestamp
-    };
-    
-    return signal;
+    TRADING_COUNT("bridge_bytes_copied", "analyze_market_data", sizeof(TradeSignal));
+    return new TradeSignal(toSignal(trades.back()));
 }
 
 void free_trade_signal(TradeSignal* signal) {
     delete signal;
 }
 
+int analyze_candles(void* strategy, const CandleData* candles, int size,
+                    TradeSignal* signals, int capacity) {
+    TRADING_TIMED("bridge_call_ns", "analyze_candles");
+    auto tradingStrategy = static_cast<Strategy*>(strategy);
+    if (!tradingStrategy || !candles || size < 0 || capacity < 0 || (!signals && capacity > 0)) return -1;
+    if (size == 0) return 0;
+
+    try {
+        auto bars = reinterpret_cast<const Candle*>(candles);
+        tradingStrategy->reset();
+
+        int count = 0;
+        for (int i = 0; i < size; i++) {
+            auto trade = tradingStrategy->onCandle(bars[i]);
+            if (!trade) continue;
+
+            if (count < capacity) {
+                signals[count] = toSignal(*trade);
+            }
+            count++;
+        }
+
+        TRADING_COUNT("bridge_bytes_copied", "analyze_candles", std::min(count, capacity) * sizeof(TradeSignal));
+        return count;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int analyze_batch(BatchJob* jobs, int jobCount, TradeSignal* signals, int capacity, int threads) {
+    TRADING_TIMED("bridge_call_ns", "analyze_batch");
+    if (!jobs || jobCount <= 0 || !signals) return -1;
+
+    // Job i may write up to size_i signals, so each gets a disjoint slot
+    // range up front and the ranges are packed once all jobs are done.
+    std::vector<int> slots(jobCount);
+    long long total = 0;
+    for (int i = 0; i < jobCount; i++) {
+        const BatchJob& job = jobs[i];
+        if (!job.strategy || job.size < 0 || (job.size > 0 && !job.candles)) {
+            return -1;
+        }
+        slots[i] = static_cast<int>(total);
+        total += jobs[i].size;
+    }
+    if (total > capacity) return -1;
+
+    // Jobs sharing a strategy handle form one task, kept in job order:
+    // sorting by (handle, index) makes every task a contiguous run. A single
+    // worker runs everything in job order anyway, so it skips the grouping.
+    unsigned workers = ParallelFor::resolveThreads(threads > 0 ? static_cast<unsigned>(threads) : 0,
+                                                   static_cast<size_t>(jobCount));
+    std::vector<int> order(jobCount);
+    for (int i = 0; i < jobCount; i++) order[i] = i;
+    std::vector<int> taskStart{0};
+    if (workers > 1) {
+        std::sort(order.begin(), order.end(), [jobs](int a, int b) {
+            return jobs[a].strategy != jobs[b].strategy
+                ? std::less<void*>()(jobs[a].strategy, jobs[b].strategy) : a < b;
+        });
+        for (int k = 1; k < jobCount; k++) {
+            if (jobs[order[k]].strategy != jobs[order[k - 1]].strategy) taskStart.push_back(k);
+        }
+    }
+    taskStart.push_back(jobCount);
+
+    try {
+        ParallelFor::run(taskStart.size() - 1, workers, [&](size_t t, unsigned) {
+            for (int k = taskStart[t]; k < taskStart[t + 1]; k++) {
+                int i = order[k];
+                BatchJob& job = jobs[i];
+                auto strategy = static_cast<Strategy*>(job.strategy);
+                auto bars = reinterpret_cast<const Candle*>(job.candles);
+                if (job.reset) strategy->reset();
+
+                int count = 0;
+                for (int b = 0; b < job.size; b++) {
+                    if (auto trade = strategy->onCandle(bars[b])) {
+                        signals[slots[i] + count++] = toSignal(*trade);
+                    }
+                }
+                job.signalCount = count;
+            }
+        });
+    } catch (...) {
+        return -1;
+    }
+
+    int written = 0;
+    for (int i = 0; i < jobCount; i++) {
+        if (written != slots[i]) {
+            std::copy(signals + slots[i], signals + slots[i] + jobs[i].signalCount, signals + written);
+        }
+        jobs[i].firstSignal = written;
+        written += jobs[i].signalCount;
+    }
+    TRADING_COUNT("bridge_bytes_copied", "analyze_batch", written * sizeof(TradeSignal));
+    return written;
+}
+
+int sweep_strategy(void* prototype, const CandleData* candles, int size,
+                   const double* candidates, int candidateCount, int paramCount,
+                   double initialBalance, double commission, int threads,
+                   unsigned long long seriesId,
+                   SweepResult* results, int capacity) {
+    TRADING_TIMED("bridge_call_ns", "sweep_strategy");
+    auto strategy = static_cast<Strategy*>(prototype);
+    if (!strategy || !candles || size <= 0 || !candidates ||
+        candidateCount <= 0 || paramCount <= 0 || !results) {
+        return -1;
+    }
+
+    try {
+        std::vector<std::vector<double>> params(candidateCount);
+        for (int i = 0; i < candidateCount; i++) {
+            params[i].assign(candidates + i * paramCount, candidates + (i + 1) * paramCount);
+        }
+
+        ParameterSweep::Options options;
+        options.threads = threads > 0 ? static_cast<unsigned>(threads) : 0;
+        options.initialBalance = initialBalance;
+        options.commission = commission;
+        options.cache = callCache(seriesId);
+        options.seriesId = seriesId != 0 ? seriesId : 1;
+
+        auto ranked = ParameterSweep::run(*strategy, reinterpret_cast<const Candle*>(candles),
+                                          static_cast<size_t>(size), params, options);
+
+        int count = std::min(capacity, static_cast<int>(ranked.size()));
+        for (int i = 0; i < count; i++) {
+            const auto& r = ranked[i];
+            results[i] = SweepResult{
+                static_cast<int>(r.candidate),
+                r.score,
+                r.backtest.finalBalance,
+                r.backtest.maxDrawdown,
+                r.backtest.sharpeRatio,
+                r.backtest.winRate,
+                static_cast<int>(r.tradeCount)
+            };
+        }
+        return count;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int walk_forward(void* prototype, const CandleData* candles, int size,
+                 const double* candidates, int candidateCount, int paramCount,
+                 long long windowSeconds, double trainRatio, long long stepSeconds,
+                 double initialBalance, double commission, int threads,
+                 unsigned long long seriesId,
+                 WalkForwardWindow* windows, int capacity, WalkForwardSummary* summary) {
+    TRADING_TIMED("bridge_call_ns", "walk_forward");
+    auto strategy = static_cast<Strategy*>(prototype);
+    if (!strategy || !candles || size <= 0 || !candidates ||
+        candidateCount <= 0 || paramCount <= 0 || !windows || !summary) {
+        return -1;
+    }
+
+    try {
+        std::vector<std::vector<double>> params(candidateCount);
+        for (int i = 0; i < candidateCount; i++) {
+            params[i].assign(candidates + i * paramCount, candidates + (i + 1) * paramCount);
+        }
+
+        WalkForward::Options options;
+        options.window = static_cast<std::time_t>(windowSeconds);
+        options.trainRatio = trainRatio;
+        options.step = static_cast<std::time_t>(stepSeconds);
+        options.threads = threads > 0 ? static_cast<unsigned>(threads) : 0;
+        options.initialBalance = initialBalance;
+        options.commission = commission;
+        options.cache = callCache(seriesId);
+        options.seriesId = seriesId != 0 ? seriesId : 1;
+
+        auto result = WalkForward::run(*strategy, reinterpret_cast<const Candle*>(candles),
+                                       static_cast<size_t>(size), params, options);
+
+        int count = std::min(capacity, static_cast<int>(result.windows.size()));
+        for (int i = 0; i < count; i++) {
+            const auto& w = result.windows[i];
+            windows[i] = WalkForwardWindow{
+                static_cast<int>(w.begin),
+                static_cast<int>(w.split),
+                static_cast<int>(w.end),
+                static_cast<int>(w.candidate),
+                w.inSampleScore,
+                w.outOfSampleScore,
+                w.outOfSample.finalBalance,
+                w.outOfSample.maxDrawdown,
+                w.outOfSample.sharpeRatio,
+                w.outOfSample.winRate,
+                static_cast<int>(w.outOfSample.trades.size())
+            };
+        }
+        *summary = WalkForwardSummary{
+            static_cast<int>(result.windows.size()),
+            result.finalBalance,
+            result.totalReturn,
+            result.maxDrawdown,
+            result.sharpeRatio,
+            result.winRate,
+            result.efficiency,
+            static_cast<int>(result.trades),
+            static_cast<int>(result.roundTrips)
+        };
+        return count;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int bayesian_optimize(void* prototype, const CandleData* candles, int size,
+                      const ParameterBounds* bounds, int paramCount,
+                      int initialPoints, int iterations, int candidates, double exploration,
+                      unsigned long long seed, double initialBalance, double commission, int threads,
+                      unsigned long long seriesId,
+                      double* params, double* scores, int capacity, SweepResult* best) {
+    TRADING_TIMED("bridge_call_ns", "bayesian_optimize");
+    auto strategy = static_cast<Strategy*>(prototype);
+    if (!strategy || !candles || size <= 0 || !bounds || paramCount <= 0 || initialPoints <= 0 ||
+        iterations < 0 || candidates < 0 || capacity < 0 || (capacity > 0 && (!params || !scores))) {
+        return -1;
+    }
+
+    try {
+        std::vector<ParameterRange> ranges(paramCount);
+        for (int d = 0; d < paramCount; d++) {
+            ranges[d] = ParameterRange{bounds[d].min, bounds[d].max, bounds[d].integer != 0};
+        }
+
+        BayesianOptimizer::Options options;
+        options.initialPoints = static_cast<size_t>(initialPoints);
+        options.iterations = static_cast<size_t>(iterations);
+        options.candidates = static_cast<size_t>(candidates);
+        options.exploration = exploration;
+        options.seed = seed;
+        options.threads = threads > 0 ? static_cast<unsigned>(threads) : 0;
+        options.initialBalance = initialBalance;
+        options.commission = commission;
+        options.cache = callCache(seriesId);
+        options.seriesId = seriesId != 0 ? seriesId : 1;
+
+        auto result = BayesianOptimizer::run(*strategy, reinterpret_cast<const Candle*>(candles),
+                                             static_cast<size_t>(size), ranges, options);
+
+        int count = std::min(capacity, static_cast<int>(result.evaluations.size()));
+        for (int i = 0; i < count; i++) {
+            const auto& evaluation = result.evaluations[i];
+            std::copy(evaluation.params.begin(), evaluation.params.end(), params + i * paramCount);
+            scores[i] = evaluation.score;
+        }
+        if (best) {
+            const auto& backtest = result.backtest;
+            *best = SweepResult{
+                static_cast<int>(result.best),
+                result.evaluations[result.best].score,
+                backtest.finalBalance,
+                backtest.maxDrawdown,
+                backtest.sharpeRatio,
+                backtest.winRate,
+                static_cast<int>(result.tradeCount)
+            };
+        }
+        return count;
+    } catch (...) {
+        return -1;
+    }
+}
+
+void* create_gaussian_process(int dimensions, double lengthScale,
+                              double signalVariance, double noiseVariance) {
+    if (dimensions <= 0) return nullptr;
+    try {
+        return new GaussianProcess(static_cast<size_t>(dimensions), lengthScale, signalVariance, noiseVariance);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void destroy_gaussian_process(void* process) {
+    delete static_cast<GaussianProcess*>(process);
+}
+
+int gaussian_process_add(void* process, const double* point, double value) {
+    if (!process || !point) return -1;
+    try {
+        static_cast<GaussianProcess*>(process)->add(point, value);
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int gaussian_process_predict(void* process, const double* points, int count,
+                             double* means, double* sds, int threads) {
+    TRADING_TIMED("bridge_call_ns", "gaussian_process_predict");
+    if (!process || count < 0 || (count > 0 && (!points || !means || !sds))) return -1;
+    try {
+        auto model = static_cast<GaussianProcess*>(process);
+        std::vector<GaussianProcess::Prediction> predictions(static_cast<size_t>(count));
+        model->predict(points, predictions.size(), predictions.data(),
+                       threads > 0 ? static_cast<unsigned>(threads) : 0);
+        for (int i = 0; i < count; i++) {
+            means[i] = predictions[i].mean;
+            sds[i] = predictions[i].sd;
+        }
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+static MonteCarloInterval toInterval(const MonteCarloResult::Interval& interval) {
+    return MonteCarloInterval{interval.lower, interval.median, interval.upper, interval.mean};
+}
+
+int monte_carlo(const double* pnl, int count, int paths, int mode, int pathLength,
+                double initialBalance, double confidence, unsigned long long seed,
+                int threads, MonteCarloSummary* summary,
+                unsigned long long* maxWinStreaks, unsigned long long* maxLossStreaks,
+                int histogramCapacity) {
+    TRADING_TIMED("bridge_call_ns", "monte_carlo");
+    if (!pnl || count <= 0 || paths <= 0 || !summary || (mode != 0 && mode != 1)) {
+        return -1;
+    }
+
+    try {
+        MonteCarlo::Options options;
+        options.paths = static_cast<size_t>(paths);
+        options.threads = threads > 0 ? static_cast<unsigned>(threads) : 0;
+        options.seed = seed;
+        options.mode = mode == 0 ? Resampling::Shuffle : Resampling::Bootstrap;
+        options.initialBalance = initialBalance;
+        options.pathLength = pathLength > 0 ? static_cast<size_t>(pathLength) : 0;
+        options.confidence = confidence;
+
+        auto result = MonteCarlo::run(pnl, static_cast<size_t>(count), options);
+        *summary = MonteCarloSummary{
+            toInterval(result.finalBalance),
+            toInterval(result.maxDrawdown),
+            toInterval(result.sharpeRatio),
+            toInterval(result.winRate),
+            result.var95,
+            result.var99,
+            result.cvar95,
+            result.cvar99,
+            result.lossProbability,
+            result.ruinProbability,
+            result.averageWinStreak,
+            result.averageLossStreak,
+            result.averageRecoveryTime,
+            static_cast<int>(result.maxRecoveryTime),
+            result.recoveryProbability
+        };
+
+        for (int k = 0; k < histogramCapacity; k++) {
+            bool inRange = static_cast<size_t>(k) < result.maxWinStreaks.size();
+            if (maxWinStreaks) maxWinStreaks[k] = inRange ? result.maxWinStreaks[k] : 0;
+            if (maxLossStreaks) maxLossStreaks[k] = inRange ? result.maxLossStreaks[k] : 0;
+        }
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+void* create_feed(int capacity, int maxConsumers) {
+    if (capacity <= 0 || maxConsumers <= 0) return nullptr;
+    try {
+        return new SpmcRing<Candle>(static_cast<size_t>(capacity), static_cast<size_t>(maxConsumers));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void destroy_feed(void* feed) {
+    delete static_cast<SpmcRing<Candle>*>(feed);
+}
+
+int feed_publish(void* feed, const CandleData* records, int count) {
+    TRADING_TIMED("bridge_call_ns", "feed_publish");
+    if (!feed || !records || count <= 0) return 0;
+    auto ring = static_cast<SpmcRing<Candle>*>(feed);
+    size_t published = ring->publish(reinterpret_cast<const Candle*>(records), static_cast<size_t>(count));
+    TRADING_COUNT("bridge_bytes_copied", "feed_publish", published * sizeof(Candle));
+    return static_cast<int>(published);
+}
+
+int feed_subscribe(void* feed) {
+    if (!feed) return -1;
+    return static_cast<SpmcRing<Candle>*>(feed)->subscribe();
+}
+
+void feed_unsubscribe(void* feed, int consumer) {
+    if (!feed) return;
+    try {
+        static_cast<SpmcRing<Candle>*>(feed)->unsubscribe(consumer);
+    } catch (...) {
+    }
+}
+
+int feed_poll(void* feed, int consumer, CandleData* records, int capacity) {
+    TRADING_TIMED("bridge_call_ns", "feed_poll");
+    if (!feed || !records || capacity <= 0) return 0;
+    try {
+        auto ring = static_cast<SpmcRing<Candle>*>(feed);
+        size_t read = ring->poll(consumer, reinterpret_cast<Candle*>(records), static_cast<size_t>(capacity));
+        TRADING_COUNT("bridge_bytes_copied", "feed_poll", read * sizeof(Candle));
+        return static_cast<int>(read);
+    } catch (...) {
+        return 0;
+    }
+}
+
+int feed_run_strategy(void* feed, int consumer, void* strategy,
+                      TradeSignal* signals, int capacity, int* consumed) {
+    TRADING_TIMED("bridge_call_ns", "feed_run_strategy");
+    if (consumed) *consumed = 0;
+    if (!feed || !strategy || !signals || capacity <= 0) return -1;
+    try {
+        auto ring = static_cast<SpmcRing<Candle>*>(feed);
+        auto impl = static_cast<Strategy*>(strategy);
+        int count = 0;
+        // At most one signal per record, so capacity bounds the records read.
+        size_t read = ring->drain(consumer, static_cast<size_t>(capacity), [&](const Candle& candle) {
+            if (auto trade = impl->onCandle(candle)) signals[count++] = toSignal(*trade);
+        });
+        if (consumed) *consumed = static_cast<int>(read);
+        TRADING_COUNT("bridge_bytes_copied", "feed_run_strategy", count * sizeof(TradeSignal));
+        return count;
+    } catch (...) {
+        return -1;
+    }
+}
+
+void* create_bar_aggregator(const long long* timeframes, int count) {
+    if (!timeframes || count <= 0) return nullptr;
+    try {
+        return new BarAggregator(std::vector<std::time_t>(timeframes, timeframes + count));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void destroy_bar_aggregator(void* aggregator) {
+    delete static_cast<BarAggregator*>(aggregator);
+}
+
+static AggregatedBar toAggregatedBar(size_t timeframe, const Candle& bar) {
+    AggregatedBar out;
+    out.timeframe = static_cast<int>(timeframe);
+    std::memcpy(&out.candle, &bar, sizeof(Candle));
+    return out;
+}
+
+int aggregator_add_ticks(void* aggregator, const TickData* ticks, int count,
+                         AggregatedBar* bars, int capacity, int* consumed) {
+    TRADING_TIMED("bridge_call_ns", "aggregator_add_ticks");
+    if (consumed) *consumed = 0;
+    auto impl = static_cast<BarAggregator*>(aggregator);
+    if (!impl || (count > 0 && !ticks) || count < 0 || !bars || capacity < 0) return -1;
+
+    auto input = reinterpret_cast<const Tick*>(ticks);
+    int timeframes = static_cast<int>(impl->timeframes());
+    int written = 0;
+    int i = 0;
+    for (; i < count && capacity - written >= timeframes; i++) {
+        impl->add(input[i], [&](size_t timeframe, const Candle& bar) {
+            bars[written++] = toAggregatedBar(timeframe, bar);
+        });
+    }
+    if (consumed) *consumed = i;
+    TRADING_COUNT("bridge_bytes_copied", "aggregator_add_ticks", written * sizeof(AggregatedBar));
+    return written;
+}
+
+int aggregator_flush(void* aggregator, AggregatedBar* bars, int capacity) {
+    TRADING_TIMED("bridge_call_ns", "aggregator_flush");
+    auto impl = static_cast<BarAggregator*>(aggregator);
+    if (!impl || !bars || capacity < static_cast<int>(impl->timeframes())) return -1;
+
+    int written = 0;
+    impl->flush([&](size_t timeframe, const Candle& bar) {
+        bars[written++] = toAggregatedBar(timeframe, bar);
+    });
+    TRADING_COUNT("bridge_bytes_copied", "aggregator_flush", written * sizeof(AggregatedBar));
+    return written;
+}
+
+int resample_candles(const CandleData* candles, int size, long long timeframe,
+                     CandleData* out, int capacity) {
+    TRADING_TIMED("bridge_call_ns", "resample_candles");
+    if (!candles || size < 0 || timeframe <= 0 || !out || capacity < 0) return -1;
+    try {
+        auto bars = reinterpret_cast<const Candle*>(candles);
+        BarAggregator aggregator({static_cast<std::time_t>(timeframe)});
+        int produced = 0;
+        auto collect = [&](size_t, const Candle& bar) {
+            if (produced < capacity) std::memcpy(&out[produced], &bar, sizeof(Candle));
+            produced++;
+        };
+        for (int i = 0; i < size; i++) aggregator.add(bars[i], collect);
+        aggregator.flush(collect);
+        TRADING_COUNT("bridge_bytes_copied", "resample_candles", std::min(produced, capacity) * sizeof(CandleData));
+        return produced;
+    } catch (...) {
+        return -1;
+    }
+}
+
+void* open_journal(const char* path, int capacity, int syncMillis) {
+    if (!path || syncMillis < 0) return nullptr;
+    try {
+        JournalOptions options;
+        if (capacity > 0) options.capacity = static_cast<size_t>(capacity);
+        options.batch = std::min(options.batch, options.capacity);
+        options.syncInterval = std::chrono::milliseconds(syncMillis);
+        return new Journal(path, options);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void close_journal(void* journal) {
+    delete static_cast<Journal*>(journal);
+}
+
+int journal_append_candles(void* journal, unsigned int stream, const CandleData* candles, int count) {
+    TRADING_TIMED("bridge_call_ns", "journal_append_candles");
+    if (!journal || !candles || count <= 0) return 0;
+    auto impl = static_cast<Journal*>(journal);
+    auto bars = reinterpret_cast<const Candle*>(candles);
+    int accepted = 0;
+    for (int i = 0; i < count; i++) accepted += impl->append(stream, bars[i]) ? 1 : 0;
+    return accepted;
+}
+
+int journal_append_signals(void* journal, unsigned int stream, const TradeSignal* signals, int count) {
+    TRADING_TIMED("bridge_call_ns", "journal_append_signals");
+    if (!journal || !signals || count <= 0) return 0;
+    auto impl = static_cast<Journal*>(journal);
+    int accepted = 0;
+    for (int i = 0; i < count; i++) {
+        accepted += impl->append(stream, JournalKind::Signal, fromSignal(signals[i])) ? 1 : 0;
+    }
+    return accepted;
+}
+
+int journal_flush(void* journal) {
+    if (!journal) return -1;
+    try {
+        static_cast<Journal*>(journal)->flush();
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int journal_stats(void* journal, JournalStats* stats) {
+    if (!journal || !stats) return -1;
+    auto current = static_cast<Journal*>(journal)->stats();
+    *stats = JournalStats{current.appended, current.dropped, current.written, current.synced};
+    return 0;
+}
+
+int journal_replay(const char* path, void* strategy, unsigned int stream, double speed,
+                   TradeSignal* signals, int capacity, int* reproduced) {
+    TRADING_TIMED("bridge_call_ns", "journal_replay");
+    if (reproduced) *reproduced = 0;
+    if (!path || !strategy || (!signals && capacity > 0) || capacity < 0) return -1;
+    try {
+        JournalReader reader(path);
+        ReplayOptions options;
+        options.speed = speed;
+        auto result = JournalReplay::replay(reader, stream, *static_cast<Strategy*>(strategy), options);
+        int count = static_cast<int>(std::min(result.signals.size(), static_cast<size_t>(capacity)));
+        for (int i = 0; i < count; i++) signals[i] = toSignal(result.signals[i]);
+        if (reproduced) *reproduced = result.reproduced ? 1 : 0;
+        TRADING_COUNT("bridge_bytes_copied", "journal_replay", count * sizeof(TradeSignal));
+        return static_cast<int>(result.signals.size());
+    } catch (...) {
+        return -1;
+    }
+}
+
+void get_indicator_cache_stats(IndicatorCacheStats* stats) {
+    if (!stats) return;
+    auto current = sharedIndicatorCache()->stats();
+    *stats = IndicatorCacheStats{
+        current.hits,
+        current.misses,
+        current.evictions,
+        current.bytes,
+        current.entries
+    };
+}
+
+void clear_indicator_cache(void) {
+    sharedIndicatorCache()->clear();
+}
+
+
+int metrics_enabled(void) {
+    return TRADING_METRICS;
+}
+
+int metrics_snapshot(MetricSample* samples, int capacity) {
+    if (!samples || capacity < 0) return -1;
+    try {
+        auto current = Metrics::snapshot();
+        for (size_t i = 0; i < current.size() && i < static_cast<size_t>(capacity); i++) {
+            const auto& sample = current[i];
+            samples[i] = MetricSample{
+                sample.name,
+                sample.label,
+                sample.kind == Metrics::Kind::Timer ? 1 : 0,
+                sample.count,
+                sample.sum,
+                sample.min,
+                sample.max,
+                sample.p50,
+                sample.p90,
+                sample.p99,
+                sample.p999
+            };
+        }
+        return static_cast<int>(current.size());
+    } catch (...) {
+        return -1;
+    }
+}
+
 }
\ No newline at end of file
@@ -5,20 +5,382 @@
 extern "C" {
 #endif
 
+// `type` and `reason` point to static strings owned by the library; they
+// stay valid for the lifetime of the process and must not be freed.
 typedef struct {
     double price;
     double amount;
     const char* type;
     long long timestamp;
+    const char* reason;
 } TradeSignal;
 
+// Layout-compatible with the C++ Candle model, so caller-owned arrays can be
+// analyzed in place.
+typedef struct {
+    long long timestamp;
+    double open;
+    double high;
+    double low;
+    double close;
+    double volume;
+} CandleData;
+
+// Layout-compatible with the C++ Tick model.
+typedef struct {
+    long long timestamp;
+    double price;
+    double volume;
+} TickData;
+
+// A bar closed by a bar aggregator; `timeframe` indexes the aggregator's
+// timeframe list.
+typedef struct {
+    int timeframe;
+    CandleData candle;
+} AggregatedBar;
+
+typedef struct {
+    int candidate;
+    double score;
+    double finalBalance;
+    double maxDrawdown;
+    double sharpeRatio;
+    double winRate;
+    int trades;
+} SweepResult;
+
+// One hot-path metric from metrics_snapshot. `name` and `label` point to
+// strings owned by the library that stay valid for the lifetime of the
+// process. Timers (`kind` 1) report nanoseconds: `count` events summing to
+// `sum`, with their range and approximate quantiles; counters (`kind` 0)
+// report their total in `count` and `sum`.
+typedef struct {
+    const char* name;
+    const char* label;
+    int kind;
+    unsigned long long count;
+    double sum;
+    double min;
+    double max;
+    double p50;
+    double p90;
+    double p99;
+    double p999;
+} MetricSample;
+
+typedef struct {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+    unsigned long long bytes;
+    unsigned long long entries;
+} IndicatorCacheStats;
+
+// Records accepted by journal appends, refused because the queue was
+// full, handed to the file, and known to be synced to disk.
+typedef struct {
+    unsigned long long appended;
+    unsigned long long dropped;
+    unsigned long long written;
+    unsigned long long synced;
+} JournalStats;
+
+typedef struct {
+    double lower;
+    double median;
+    double upper;
+    double mean;
+} MonteCarloInterval;
+
+typedef struct {
+    MonteCarloInterval finalBalance;
+    MonteCarloInterval maxDrawdown;
+    MonteCarloInterval sharpeRatio;
+    MonteCarloInterval winRate;
+    double var95;
+    double var99;
+    double cvar95;
+    double cvar99;
+    double lossProbability;
+    double ruinProbability;
+    double averageWinStreak;
+    double averageLossStreak;
+    double averageRecoveryTime;
+    int maxRecoveryTime;
+    double recoveryProbability;
+} MonteCarloSummary;
+
+// Bar indices into the candles passed to walk_forward: in-sample bars are
+// [begin, split), out-of-sample bars [split, end).
+typedef struct {
+    int begin;
+    int split;
+    int end;
+    int candidate;
+    double inSampleScore;
+    double outOfSampleScore;
+    double finalBalance;
+    double maxDrawdown;
+    double sharpeRatio;
+    double winRate;
+    int trades;
+} WalkForwardWindow;
+
+typedef struct {
+    int windows;
+    double finalBalance;
+    double totalReturn;
+    double maxDrawdown;
+    double sharpeRatio;
+    double winRate;
+    double efficiency;
+    int trades;
+    int roundTrips;
+} WalkForwardSummary;
+
+// Search range of one parameter of bayesian_optimize; with `integer`
+// non-zero only whole values are tried.
+typedef struct {
+    double min;
+    double max;
+    int integer;
+} ParameterBounds;
+
+// One (strategy, candles) pair of an analyze_batch call: the job's bars
+// are candles[0, size), read in place. With `reset` non-zero they are
+// replayed from a clean state, as analyze_candles does; otherwise they are
+// fed as new bars on top of the strategy's current state. `firstSignal` and
+// `signalCount` are written by the call.
+typedef struct {
+    void* strategy;
+    const CandleData* candles;
+    int size;
+    int reset;
+    int firstSignal;
+    int signalCount;
+} BatchJob;
+
+// The create_*_strategy functions return NULL when the parameters are
+// rejected, e.g. a non-positive period.
 void* create_rsi_strategy(int period, double oversold, double overbought);
 void* create_macd_strategy(int fastPeriod, int slowPeriod, int signalPeriod, double threshold);
 void* create_bbands_strategy(int period, double multiplier, double percentageB);
 void destroy_strategy(void* strategy);
+
+// Wraps `strategy` in a live strategy: a handle usable everywhere a strategy
+// is, whose parameters update_strategy_parameters can replace while it is
+// being analyzed. Each update is applied to a fresh copy in a background
+// thread, warmed on the last `historyBars` bars the handle has seen (<= 0
+// for 1024), and swapped in at the next bar without blocking the analysis.
+// On success the wrapper owns `strategy`, which must no longer be used or
+// destroyed; returns NULL on failure, leaving `strategy` as it was.
+void* create_live_strategy(void* strategy, int historyBars);
+
+// Publishes `count` parameters, in the order the strategy's constructor
+// takes them. For a live strategy this never waits and may overlap its
+// analysis; it returns the update's version, which
+// strategy_parameters_version reaches once analysis has switched to it.
+// Any other strategy is updated in place (so the call must not overlap its
+// analysis) and 0 is returned. Returns -1 on failure.
+long long update_strategy_parameters(void* strategy, const double* params, int count);
+
+// Version of the parameters a live strategy is analyzing with (0 until its
+// first update is switched to, and always 0 for other strategies).
+unsigned long long strategy_parameters_version(void* strategy);
 TradeSignal* analyze_market_data(void* strategy, double* prices, int size);
 void free_trade_signal(TradeSignal* signal);
 
+// Replays `size` candles through the strategy from a clean state and writes
+// every generated signal to `signals` (at most `capacity` of them). Returns
+// the total number of signals generated; a strategy emits at most one signal
+// per candle, so capacity >= size never truncates. Returns -1 on failure.
+// Nothing is copied or allocated: `candles` and `signals` are owned by the
+// caller.
+int analyze_candles(void* strategy, const CandleData* candles, int size,
+                    TradeSignal* signals, int capacity);
+
+// Evaluates `jobCount` jobs in one call, spread across `threads` workers
+// (0 = all cores, 1 = the calling thread only). Jobs naming the same
+// strategy run in order on one worker. Signals are written to `signals`
+// packed in job order, job i's at [firstSignal, firstSignal + signalCount);
+// `capacity` must be at least the sum of the job sizes. Returns the number
+// of signals written, or -1 on failure.
+int analyze_batch(BatchJob* jobs, int jobCount, TradeSignal* signals, int capacity, int threads);
+
+// Backtests a clone of `prototype` for every candidate parameter set
+// (`candidateCount` rows of `paramCount` values, row-major; `paramCount`
+// must be the number of parameters the strategy takes) over the same
+// candles, spread across `threads` workers (0 = all cores). Indicator series
+// go through the library's shared indicator cache under `seriesId`; pass the
+// same non-zero id for the same candle buffer to reuse series across calls,
+// or 0 to use a private cache for this call only. Writes up to `capacity` results ranked by Sharpe
+// ratio, best first, and returns how many were written, or -1 on failure.
+int sweep_strategy(void* prototype, const CandleData* candles, int size,
+                   const double* candidates, int candidateCount, int paramCount,
+                   double initialBalance, double commission, int threads,
+                   unsigned long long seriesId,
+                   SweepResult* results, int capacity);
+
+// Rolling walk-forward optimization of `prototype`: windows of
+// `windowSeconds` (a `trainRatio` share in-sample) advance by `stepSeconds`
+// (0 = the out-of-sample length). Every window backtests all candidates
+// (laid out as for sweep_strategy) in-sample across `threads` workers and
+// trades the best by Sharpe ratio out-of-sample. Indicators are computed
+// once over the whole series in the shared indicator cache under `seriesId`
+// (0 = a private cache for this call) and carry across window boundaries. Writes up to
+// `capacity` windows and the compounded out-of-sample summary; returns the
+// number of windows written, or -1 on failure.
+int walk_forward(void* prototype, const CandleData* candles, int size,
+                 const double* candidates, int candidateCount, int paramCount,
+                 long long windowSeconds, double trainRatio, long long stepSeconds,
+                 double initialBalance, double commission, int threads,
+                 unsigned long long seriesId,
+                 WalkForwardWindow* windows, int capacity, WalkForwardSummary* summary);
+
+// Bayesian optimization of `prototype` over the `paramCount` ranges in
+// `bounds`, one per strategy parameter: `initialPoints` random parameter sets, then `iterations` more
+// each chosen by the expected improvement (margin `exploration`, in units of
+// the initial score spread) of `candidates` points under a Gaussian-process
+// model of the Sharpe ratio. Candidate scoring and the initial backtests run
+// on `threads` workers (0 = all cores); the result depends on `seed` but not
+// on the thread count. Indicators go through the shared indicator cache as
+// for sweep_strategy. Writes the first `capacity` evaluations in order (rows
+// of `paramCount` values to `params`, scores to `scores`) and the best
+// evaluation's backtest to `best` (its `candidate` is the evaluation index);
+// returns the number of evaluations written, or -1 on failure.
+int bayesian_optimize(void* prototype, const CandleData* candles, int size,
+                      const ParameterBounds* bounds, int paramCount,
+                      int initialPoints, int iterations, int candidates, double exploration,
+                      unsigned long long seed, double initialBalance, double commission, int threads,
+                      unsigned long long seriesId,
+                      double* params, double* scores, int capacity, SweepResult* best);
+
+// Gaussian-process regression over `dimensions`-dimensional points with a
+// squared-exponential kernel. Each observation updates the model's Cholesky
+// factor in O(n^2); a prediction costs O(n) for the mean and O(n^2) for
+// the deviation. Returns NULL on failure.
+void* create_gaussian_process(int dimensions, double lengthScale,
+                              double signalVariance, double noiseVariance);
+void destroy_gaussian_process(void* process);
+
+// Adds one observation; returns 0, or -1 on failure.
+int gaussian_process_add(void* process, const double* point, double value);
+
+// Predicts `count` points (row-major) across `threads` workers (0 = all
+// cores), writing their means and standard deviations. Must not run
+// concurrently with gaussian_process_add on the same process. Returns 0,
+// or -1 on failure.
+int gaussian_process_predict(void* process, const double* points, int count,
+                             double* means, double* sds, int threads);
+
+// Resamples `count` per-trade PnLs into `paths` synthetic equity paths
+// across `threads` workers (0 = all cores). `mode` 0 shuffles the trades,
+// 1 bootstraps `pathLength` draws with replacement (0 = count). The same
+// seed always gives the same summary. If `maxWinStreaks`/`maxLossStreaks`
+// are non-null, entry k receives the number of paths whose longest run was
+// k trades, for k < histogramCapacity. Returns 0, or -1 on failure.
+int monte_carlo(const double* pnl, int count, int paths, int mode, int pathLength,
+                double initialBalance, double confidence, unsigned long long seed,
+                int threads, MonteCarloSummary* summary,
+                unsigned long long* maxWinStreaks, unsigned long long* maxLossStreaks,
+                int histogramCapacity);
+
+// Market-data feed: a lock-free single-producer ring of `capacity` candle
+// or tick records (rounded up to a power of two) that up to `maxConsumers`
+// consumers read through their own cursors. Publishing and consuming never
+// lock or allocate. Returns NULL on failure.
+void* create_feed(int capacity, int maxConsumers);
+void destroy_feed(void* feed);
+
+// Appends up to `count` records and returns how many were accepted; a full
+// ring rejects the rest rather than overwrite records a consumer has not
+// read. Only one thread may publish to a feed.
+int feed_publish(void* feed, const CandleData* records, int count);
+
+// Claims a cursor positioned at the next record to be published. Returns
+// its id, or -1 when every cursor is taken. Each cursor must be read by one
+// thread at a time.
+int feed_subscribe(void* feed);
+void feed_unsubscribe(void* feed, int consumer);
+
+// Copies up to `capacity` unread records to `records`; returns the count.
+int feed_poll(void* feed, int consumer, CandleData* records, int capacity);
+
+// Feeds up to `capacity` unread records straight from the ring into the
+// strategy, on top of its current state, and writes the signals they
+// trigger to `signals`. Returns the number of signals, or -1 on failure;
+// `consumed` receives the number of records read.
+int feed_run_strategy(void* feed, int consumer, void* strategy,
+                      TradeSignal* signals, int capacity, int* consumed);
+
+// Tick-to-bar aggregator building bars for `count` timeframes (in seconds)
+// at once, aligned to multiples of the timeframe since the epoch. Returns
+// NULL on failure.
+void* create_bar_aggregator(const long long* timeframes, int count);
+void destroy_bar_aggregator(void* aggregator);
+
+// Folds ticks, in timestamp order, into every timeframe and writes the bars
+// they close to `bars`. Stops early rather than overflow `capacity`: each
+// tick can close one bar per timeframe, so capacity >= count * timeframes
+// always consumes every tick. Returns the number of bars written, or -1 on
+// failure; `consumed` receives the number of ticks folded in.
+int aggregator_add_ticks(void* aggregator, const TickData* ticks, int count,
+                         AggregatedBar* bars, int capacity, int* consumed);
+
+// Writes every bar still open (at most one per timeframe) and starts afresh.
+// Returns the number of bars written, or -1 on failure.
+int aggregator_flush(void* aggregator, AggregatedBar* bars, int capacity);
+
+// Rolls `size` finer candles up into `timeframe`-second bars in one pass.
+// Writes up to `capacity` bars (size always suffices) and returns the
+// number of bars produced, or -1 on failure.
+int resample_candles(const CandleData* candles, int size, long long timeframe,
+                     CandleData* out, int capacity);
+
+// Append-only binary journal of candles and signals. Appends only push
+// onto a lock-free queue of `capacity` records (<= 0 for 65536); a
+// background thread writes them to `path` in batches and syncs them to
+// disk at most every `syncMillis` milliseconds (0 = after every write).
+// An existing journal is appended to. Returns NULL on failure.
+void* open_journal(const char* path, int capacity, int syncMillis);
+
+// Writes and syncs everything appended, then frees the journal.
+void close_journal(void* journal);
+
+// Appends `count` candles or signals under `stream`, a caller-chosen id
+// such as one per strategy, and returns how many were accepted: when the
+// writer falls `capacity` records behind, the rest are dropped (and
+// counted in journal_stats) rather than block the caller.
+int journal_append_candles(void* journal, unsigned int stream, const CandleData* candles, int count);
+int journal_append_signals(void* journal, unsigned int stream, const TradeSignal* signals, int count);
+
+// Blocks until every record appended before the call is on disk. Returns
+// 0, or -1 if writing the journal failed.
+int journal_flush(void* journal);
+int journal_stats(void* journal, JournalStats* stats);
+
+// Replays the candles recorded under `stream` in the journal at `path`
+// into `strategy` from a clean state, as fast as possible (`speed` 0) or
+// on their recorded schedule `speed` times faster. Writes up to `capacity`
+// of the signals they trigger and returns how many were triggered, or -1
+// on failure; `reproduced` receives 1 if they equal the signals recorded
+// under `stream`, else 0.
+int journal_replay(const char* path, void* strategy, unsigned int stream, double speed,
+                   TradeSignal* signals, int capacity, int* reproduced);
+
+void get_indicator_cache_stats(IndicatorCacheStats* stats);
+void clear_indicator_cache(void);
+
+// Non-zero when the library was built with TRADING_METRICS=1; otherwise
+// metrics_snapshot always reports no metrics.
+int metrics_enabled(void);
+
+// Writes up to `capacity` hot-path metrics, merged across threads, and
+// returns how many are registered (call again with more room if that
+// exceeds capacity), or -1 on failure.
+int metrics_snapshot(MetricSample* samples, int capacity);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,19 +2,119 @@ package trading
 
 // #cgo CXXFLAGS: -std=c++17
 // #cgo LDFLAGS: -L${SRCDIR} -lstrategy
+// #include <stdlib.h>
 // #include "bridge.h"
 import "C"
 import (
+    "cmp"
+    "errors"
+    "fmt"
+    "hash/fnv"
+    "io"
+    "net/http"
+    "os"
+    "runtime"
+    "slices"
+    "strings"
+    "sync"
     "time"
     "unsafe"
 )
 
 type Strategy struct {
     handle unsafe.Pointer
+
+    // mu serializes calls into the C++ strategy, whose indicator state is
+    // mutated by every analysis. signalBuf is reused across AnalyzeCandles
+    // calls so steady-state analysis does not allocate on the Go side.
+    mu        sync.Mutex
+    signalBuf []C.TradeSignal
+
+    // live strategies take parameter updates without mu, concurrently with
+    // their analysis.
+    live bool
+}
+
+// growC returns a C-allocated buffer of n elements, reusing buf when it is
+// large enough. Arrays of pointer-carrying structs such as TradeSignal live
+// in C memory because cgo's pointer check scans the whole backing array of
+// any such Go slice passed to C on every call, which costs far more than the
+// call itself once the array is large.
+func growC[T any](buf []T, n int) []T {
+    if cap(buf) >= n {
+        return buf[:n]
+    }
+    freeC(buf)
+    var zero T
+    p := C.malloc(C.size_t(n) * C.size_t(unsafe.Sizeof(zero)))
+    return unsafe.Slice((*T)(p), n)
+}
+
+func freeC[T any](buf []T) {
+    if cap(buf) > 0 {
+        C.free(unsafe.Pointer(unsafe.SliceData(buf)))
+    }
+}
+
+// Candle mirrors the C CandleData layout field for field, so a []Candle can
+// be handed to the bridge without copying.
+type Candle struct {
+    Timestamp int64
+    Open      float64
+    High      float64
+    Low       float64
+    Close     float64
+    Volume    float64
+}
+
+var _ [unsafe.Sizeof(C.CandleData{}) - unsafe.Sizeof(Candle{})]struct{}
+var _ [unsafe.Sizeof(Candle{}) - unsafe.Sizeof(C.CandleData{})]struct{}
+
+// Tick mirrors the C TickData layout: one trade print with a Unix timestamp
+// in seconds.
+type Tick struct {
+    Timestamp int64
+    Price     float64
+    Volume    float64
+}
+
+var _ [unsafe.Sizeof(C.TickData{}) - unsafe.Sizeof(Tick{})]struct{}
+var _ [unsafe.Sizeof(Tick{}) - unsafe.Sizeof(C.TickData{})]struct{}
+
+// staticStrings caches Go copies of the library's static signal labels,
+// keyed by address, so converting a TradeSignal does not allocate.
+var staticStrings sync.Map
+
+func staticString(p *C.char) string {
+    if p == nil {
+        return ""
+    }
+    key := uintptr(unsafe.Pointer(p))
+    if str, ok := staticStrings.Load(key); ok {
+        return str.(string)
+    }
+    str := C.GoString(p)
+    staticStrings.Store(key, str)
+    return str
 }
 
+func toTradeSignal(signal *C.TradeSignal) TradeSignal {
+    return TradeSignal{
+        Price:     float64(signal.price),
+        Amount:    float64(signal.amount),
+        Type:      staticString(signal._type),
+        Reason:    staticString(signal.reason),
+        Timestamp: time.Unix(int64(signal.timestamp), 0),
+    }
+}
+
+// The New*Strategy constructors return nil when the native side rejects
+// the parameters, e.g. a period below 1.
 func NewRSIStrategy(period int, oversold, overbought float64) *Strategy {
     handle := C.create_rsi_strategy(C.int(period), C.double(oversold), C.double(overbought))
+    if handle == nil {
+        return nil
+    }
     return &Strategy{handle: handle}
 }
 
@@ -25,6 +125,9 @@ func NewMACDStrategy(fastPeriod, slowPeriod, signalPeriod int, threshold float64
         C.int(signalPeriod),
         C.double(threshold),
     )
+    if handle == nil {
+        return nil
+    }
     return &Strategy{handle: handle}
 }
 
@@ -34,11 +137,68 @@ func NewBollingerBandsStrategy(period int, multiplier, percentageB float64) *Str
         C.double(multiplier),
         C.double(percentageB),
     )
+    if handle == nil {
+        return nil
+    }
     return &Strategy{handle: handle}
 }
 
+// NewLiveStrategy turns s into a live strategy, whose UpdateParameters
+// never waits for or interrupts a running analysis: every update is
+// applied to a fresh copy in the background, warmed on the last
+// historyBars bars the strategy has seen (<= 0 for 1024), and switched to
+// at the next bar. s is consumed and must not be used afterwards; on error
+// it is left unchanged.
+func NewLiveStrategy(s *Strategy, historyBars int) (*Strategy, error) {
+    s.mu.Lock()
+    defer s.mu.Unlock()
+
+    handle := C.create_live_strategy(s.handle, C.int(historyBars))
+    if handle == nil {
+        return nil, errors.New("failed to create live strategy")
+    }
+    s.handle = nil
+    freeC(s.signalBuf)
+    s.signalBuf = nil
+    return &Strategy{handle: handle, live: true}, nil
+}
+
+// UpdateParameters replaces the strategy's parameters, given in the order
+// its constructor takes them. A live strategy returns at once with the
+// update's version, which ParametersVersion reaches once analysis uses the
+// new parameters; any other strategy is updated in place, after any
+// running analysis, and returns version 0.
+func (s *Strategy) UpdateParameters(params []float64) (uint64, error) {
+    if len(params) == 0 {
+        return 0, errors.New("no parameters")
+    }
+    if !s.live {
+        s.mu.Lock()
+        defer s.mu.Unlock()
+    }
+
+    version := C.update_strategy_parameters(
+        s.handle,
+        (*C.double)(unsafe.Pointer(&params[0])),
+        C.int(len(params)),
+    )
+    if version < 0 {
+        return 0, errors.New("failed to update strategy parameters")
+    }
+    return uint64(version), nil
+}
+
+// ParametersVersion is the version of the parameters a live strategy is
+// analyzing with: 0 until its first update takes effect, and always 0 for
+// other strategies.
+func (s *Strategy) ParametersVersion() uint64 {
+    return uint64(C.strategy_parameters_version(s.handle))
+}
+
 func (s *Strategy) Close() {
     C.destroy_strategy(s.handle)
+    freeC(s.signalBuf)
+    s.signalBuf = nil
 }
 
 func (s *Strategy) AnalyzeMarketData(prices []float64) *TradeSignal {
@@ -46,6 +206,9 @@ func (s *Strategy) AnalyzeMarketData(prices []float64) *TradeSignal {
         return nil
     }
 
+    s.mu.Lock()
+    defer s.mu.Unlock()
+
     cPrices := make([]C.double, len(prices))
     for i, price := range prices {
         cPrices[i] = C.double(price)
@@ -57,17 +220,1198 @@ func (s *Strategy) AnalyzeMarketData(prices []float64) *TradeSignal {
     }
     defer C.free_trade_signal(signal)
 
-    return &TradeSignal{
-        Price:     float64(signal.price),
-        Amount:    float64(signal.amount),
-        Type:      C.GoString(signal.type),
-        Timestamp: time.Unix(int64(signal.timestamp), 0),
+    result := toTradeSignal(signal)
+    return &result
+}
+
+// AnalyzeCandles runs the strategy over candles in place (no copy is made)
+// and appends every generated signal to dst, returning the extended slice.
+// If the native analysis fails dst is returned unchanged.
+func (s *Strategy) AnalyzeCandles(candles []Candle, dst []TradeSignal) []TradeSignal {
+    if len(candles) == 0 {
+        return dst
+    }
+
+    s.mu.Lock()
+    defer s.mu.Unlock()
+
+    s.signalBuf = growC(s.signalBuf, len(candles))
+    out := s.signalBuf
+
+    count := C.analyze_candles(
+        s.handle,
+        (*C.CandleData)(unsafe.Pointer(&candles[0])),
+        C.int(len(candles)),
+        &out[0],
+        C.int(len(out)),
+    )
+    if count < 0 {
+        return dst
+    }
+
+    for i := range out[:int(count)] {
+        dst = append(dst, toTradeSignal(&out[i]))
     }
+    return dst
+}
+
+// BatchJob is one (strategy, candles) pair of a Batch run. With Reset the
+// candles are replayed from a clean state like AnalyzeCandles; otherwise
+// they are fed as new bars on top of the strategy's current state.
+type BatchJob struct {
+    Strategy *Strategy
+    Candles  []Candle
+    Reset    bool
+}
+
+// Batch evaluates many strategies over their candles in a single bridge
+// call. Its buffers are reused across Run calls, so a steady stream of
+// batches of similar size does not allocate on the Go side; Close releases
+// them. A Batch is not safe for concurrent use.
+type Batch struct {
+    jobs       []C.BatchJob
+    signals    []C.TradeSignal
+    results    []TradeSignal
+    out        [][]TradeSignal
+    locked     []*Strategy
+    pinner     runtime.Pinner
+}
+
+// Run evaluates jobs across threads native workers (<= 0 uses every core,
+// 1 the calling thread only) and returns each job's signals, in job order.
+// The returned slices are reused by the next Run.
+func (b *Batch) Run(jobs []BatchJob, threads int) ([][]TradeSignal, error) {
+    b.out = b.out[:0]
+    if len(jobs) == 0 {
+        return b.out, nil
+    }
+    for _, job := range jobs {
+        if job.Strategy == nil {
+            return nil, errors.New("batch job has no strategy")
+        }
+    }
+
+    // The native job table points at every job's own candles, read in
+    // place: they are pinned for the duration of the call so the table,
+    // which lives in C memory, may hold them.
+    b.jobs = growC(b.jobs, len(jobs))
+    b.locked = b.locked[:0]
+    total := 0
+    for i, job := range jobs {
+        var candles *C.CandleData
+        if len(job.Candles) > 0 {
+            b.pinner.Pin(&job.Candles[0])
+            candles = (*C.CandleData)(unsafe.Pointer(&job.Candles[0]))
+        }
+        reset := C.int(0)
+        if job.Reset {
+            reset = 1
+        }
+        b.jobs[i] = C.BatchJob{
+            strategy: job.Strategy.handle,
+            candles:  candles,
+            size:     C.int(len(job.Candles)),
+            reset:    reset,
+        }
+        b.locked = append(b.locked, job.Strategy)
+        total += len(job.Candles)
+    }
+    defer b.pinner.Unpin()
+    b.signals = growC(b.signals, total+1)
+    signals := b.signals
+
+    // Lock every distinct strategy once, in address order, so concurrent
+    // batches over overlapping strategies cannot deadlock. The set is
+    // rebuilt on every run: sorting a few pointers costs nothing next to
+    // the bridge call, and a cached set could go stale.
+    slices.SortFunc(b.locked, func(x, y *Strategy) int {
+        return cmp.Compare(uintptr(unsafe.Pointer(x)), uintptr(unsafe.Pointer(y)))
+    })
+    b.locked = slices.Compact(b.locked)
+    for _, strategy := range b.locked {
+        strategy.mu.Lock()
+    }
+    count := C.analyze_batch(&b.jobs[0], C.int(len(jobs)), &signals[0], C.int(len(signals)), C.int(threads))
+    for _, strategy := range b.locked {
+        strategy.mu.Unlock()
+    }
+
+    if count < 0 {
+        return nil, errors.New("native batch analysis failed")
+    }
+
+    b.results = b.results[:0]
+    for i := range signals[:int(count)] {
+        b.results = append(b.results, toTradeSignal(&signals[i]))
+    }
+    for i := range b.jobs[:len(jobs)] {
+        first := int(b.jobs[i].firstSignal)
+        b.out = append(b.out, b.results[first:first+int(b.jobs[i].signalCount)])
+    }
+    return b.out, nil
+}
+
+// Close frees the batch's native buffers.
+func (b *Batch) Close() {
+    freeC(b.jobs)
+    freeC(b.signals)
+    b.jobs = nil
+    b.signals = nil
+}
+
+// Feed is a lock-free market-data ring in the native library: one
+// publisher appends candles or ticks and any number of FeedCursors, up to
+// the limit given to NewFeed, read every record through their own cursor.
+// Publishing and consuming neither lock nor allocate.
+type Feed struct {
+    handle unsafe.Pointer
+}
+
+// NewFeed creates a feed holding capacity records (rounded up to a power of
+// two) for at most maxConsumers cursors.
+func NewFeed(capacity, maxConsumers int) (*Feed, error) {
+    handle := C.create_feed(C.int(capacity), C.int(maxConsumers))
+    if handle == nil {
+        return nil, errors.New("native feed creation failed")
+    }
+    return &Feed{handle: handle}, nil
+}
+
+// Publish appends records to the feed and returns how many were accepted;
+// a full feed rejects the rest rather than overwrite records that a cursor
+// has not read yet. Only one goroutine may publish to a feed at a time.
+func (f *Feed) Publish(records []Candle) int {
+    if len(records) == 0 {
+        return 0
+    }
+    return int(C.feed_publish(f.handle, (*C.CandleData)(unsafe.Pointer(&records[0])), C.int(len(records))))
+}
+
+// Close frees the feed. Every cursor must be closed or abandoned first.
+func (f *Feed) Close() {
+    C.destroy_feed(f.handle)
+    f.handle = nil
+}
+
+// FeedCursor reads a Feed from the first record published after Subscribe.
+// A cursor is not safe for concurrent use; give each worker its own.
+type FeedCursor struct {
+    feed      *Feed
+    id        C.int
+    signalBuf []C.TradeSignal
+}
+
+// Subscribe claims a cursor on the feed.
+func (f *Feed) Subscribe() (*FeedCursor, error) {
+    id := C.feed_subscribe(f.handle)
+    if id < 0 {
+        return nil, errors.New("feed has no free cursor")
+    }
+    return &FeedCursor{feed: f, id: id}, nil
+}
+
+// Poll copies unread records into dst and returns how many were copied.
+func (c *FeedCursor) Poll(dst []Candle) int {
+    if len(dst) == 0 {
+        return 0
+    }
+    return int(C.feed_poll(c.feed.handle, c.id, (*C.CandleData)(unsafe.Pointer(&dst[0])), C.int(len(dst))))
+}
+
+// Run feeds up to max unread records straight from the ring into s, on top
+// of its current state, and appends the signals they trigger to dst. It
+// returns the extended slice and the number of records consumed.
+func (c *FeedCursor) Run(s *Strategy, max int, dst []TradeSignal) ([]TradeSignal, int, error) {
+    if max <= 0 {
+        return dst, 0, nil
+    }
+    c.signalBuf = growC(c.signalBuf, max)
+    out := c.signalBuf
+
+    var consumed C.int
+    s.mu.Lock()
+    count := C.feed_run_strategy(c.feed.handle, c.id, s.handle, &out[0], C.int(max), &consumed)
+    s.mu.Unlock()
+    if count < 0 {
+        return dst, int(consumed), errors.New("native feed run failed")
+    }
+
+    for i := range out[:int(count)] {
+        dst = append(dst, toTradeSignal(&out[i]))
+    }
+    return dst, int(consumed), nil
+}
+
+// Close releases the cursor so the feed no longer waits for it.
+func (c *FeedCursor) Close() {
+    C.feed_unsubscribe(c.feed.handle, c.id)
+    freeC(c.signalBuf)
+    c.signalBuf = nil
+}
+
+// Journal is an append-only binary log of candles and signals written by
+// the native library. Appends only push onto a lock-free queue and never
+// block; a background thread writes the records out in batches and syncs
+// them to disk periodically. Append from any number of goroutines, but not
+// concurrently with Close.
+type Journal struct {
+    handle unsafe.Pointer
+
+    mu        sync.Mutex
+    signalBuf []C.TradeSignal
+}
+
+type JournalOptions struct {
+    Capacity     int           // records queued before appends are dropped (0 = 65536)
+    SyncInterval time.Duration // longest a written record waits for fsync (0 = sync every write)
+}
+
+// JournalStats counts records accepted by appends, dropped because the
+// writer fell Capacity records behind, written to the file, and synced.
+type JournalStats struct {
+    Appended uint64
+    Dropped  uint64
+    Written  uint64
+    Synced   uint64
+}
+
+// OpenJournal opens the journal at path, creating it if needed; an existing
+// journal is appended to.
+func OpenJournal(path string, opts JournalOptions) (*Journal, error) {
+    cpath := C.CString(path)
+    defer C.free(unsafe.Pointer(cpath))
+    handle := C.open_journal(cpath, C.int(opts.Capacity), C.int(opts.SyncInterval/time.Millisecond))
+    if handle == nil {
+        return nil, fmt.Errorf("cannot open journal %s", path)
+    }
+    return &Journal{handle: handle}, nil
+}
+
+// JournalStream derives a stream id from a name such as a strategy id.
+func JournalStream(name string) uint32 {
+    h := fnv.New32a()
+    h.Write([]byte(name))
+    return h.Sum32()
+}
+
+// AppendCandles records candles under stream and returns how many were
+// accepted.
+func (j *Journal) AppendCandles(stream uint32, candles []Candle) int {
+    if len(candles) == 0 {
+        return 0
+    }
+    return int(C.journal_append_candles(j.handle, C.uint(stream),
+        (*C.CandleData)(unsafe.Pointer(&candles[0])), C.int(len(candles))))
+}
+
+// AppendSignals records signals under stream and returns how many were
+// accepted.
+func (j *Journal) AppendSignals(stream uint32, signals []TradeSignal) int {
+    if len(signals) == 0 {
+        return 0
+    }
+    j.mu.Lock()
+    defer j.mu.Unlock()
+    j.signalBuf = growC(j.signalBuf, len(signals))
+    for i, signal := range signals {
+        j.signalBuf[i] = C.TradeSignal{
+            price:     C.double(signal.Price),
+            amount:    C.double(signal.Amount),
+            _type:     labelString(signal.Type),
+            timestamp: C.longlong(signal.Timestamp.Unix()),
+            reason:    labelString(signal.Reason),
+        }
+    }
+    return int(C.journal_append_signals(j.handle, C.uint(stream), &j.signalBuf[0], C.int(len(signals))))
+}
+
+// labelStrings holds C copies of signal types and reasons, a small fixed
+// set, so journaling a signal allocates nothing after its label's first use.
+var labelStrings sync.Map
+
+func labelString(label string) *C.char {
+    if p, ok := labelStrings.Load(label); ok {
+        return (*C.char)(p.(unsafe.Pointer))
+    }
+    fresh := unsafe.Pointer(C.CString(label))
+    p, loaded := labelStrings.LoadOrStore(label, fresh)
+    if loaded {
+        C.free(fresh)
+    }
+    return (*C.char)(p.(unsafe.Pointer))
+}
+
+// Flush blocks until everything appended before it is on disk.
+func (j *Journal) Flush() error {
+    if C.journal_flush(j.handle) != 0 {
+        return errors.New("journal write failed")
+    }
+    return nil
+}
+
+func (j *Journal) Stats() JournalStats {
+    var stats C.JournalStats
+    C.journal_stats(j.handle, &stats)
+    return JournalStats{
+        Appended: uint64(stats.appended),
+        Dropped:  uint64(stats.dropped),
+        Written:  uint64(stats.written),
+        Synced:   uint64(stats.synced),
+    }
+}
+
+// Close writes and syncs every appended record and frees the journal.
+func (j *Journal) Close() {
+    C.close_journal(j.handle)
+    j.handle = nil
+    j.mu.Lock()
+    freeC(j.signalBuf)
+    j.signalBuf = nil
+    j.mu.Unlock()
+}
+
+// ReplayJournal feeds the candles recorded under stream at path into s from
+// a clean state, as fast as possible (speed 0) or on their recorded
+// schedule speed times faster, and returns the signals they trigger and
+// whether those equal the signals recorded under stream.
+func ReplayJournal(path string, s *Strategy, stream uint32, speed float64) ([]TradeSignal, bool, error) {
+    info, err := os.Stat(path)
+    if err != nil {
+        return nil, false, err
+    }
+    // A strategy signals at most once per candle, and every record takes
+    // 64 bytes after a 64-byte header.
+    capacity := max(int(info.Size()/64), 1)
+    buf := growC[C.TradeSignal](nil, capacity)
+    defer freeC(buf)
+
+    cpath := C.CString(path)
+    defer C.free(unsafe.Pointer(cpath))
+    var reproduced C.int
+    s.mu.Lock()
+    count := C.journal_replay(cpath, s.handle, C.uint(stream), C.double(speed), &buf[0], C.int(capacity), &reproduced)
+    s.mu.Unlock()
+    if count < 0 {
+        return nil, false, fmt.Errorf("cannot replay journal %s", path)
+    }
+
+    n := min(int(count), capacity)
+    signals := make([]TradeSignal, n)
+    for i := range signals {
+        signals[i] = toTradeSignal(&buf[i])
+    }
+    return signals, reproduced != 0, nil
+}
+
+// Bar is a candle closed by a BarAggregator for one of its timeframes,
+// given in seconds.
+type Bar struct {
+    Timeframe int64
+    Candle    Candle
+}
+
+// BarAggregator builds candles for several timeframes at once from a tick
+// stream in the native library, aligned to multiples of each timeframe
+// since the epoch and stamped with their open time. Buckets without ticks
+// produce no bar. It is not safe for concurrent use.
+type BarAggregator struct {
+    handle     unsafe.Pointer
+    timeframes []int64
+    bars       []C.AggregatedBar
+}
+
+// NewBarAggregator creates an aggregator for the given timeframes in
+// seconds, e.g. 1, 60, 300 and 3600.
+func NewBarAggregator(timeframes ...int64) (*BarAggregator, error) {
+    if len(timeframes) == 0 {
+        return nil, errors.New("bar aggregator needs at least one timeframe")
+    }
+    handle := C.create_bar_aggregator((*C.longlong)(unsafe.Pointer(&timeframes[0])), C.int(len(timeframes)))
+    if handle == nil {
+        return nil, errors.New("native bar aggregator creation failed")
+    }
+    return &BarAggregator{handle: handle, timeframes: slices.Clone(timeframes)}, nil
+}
+
+// Add folds ticks, in timestamp order, into every timeframe and appends the
+// bars they close to dst.
+func (a *BarAggregator) Add(ticks []Tick, dst []Bar) ([]Bar, error) {
+    for len(ticks) > 0 {
+        need := len(ticks) * len(a.timeframes)
+        if cap(a.bars) < need {
+            a.bars = make([]C.AggregatedBar, need)
+        }
+        a.bars = a.bars[:cap(a.bars)]
+
+        var consumed C.int
+        count := C.aggregator_add_ticks(a.handle, (*C.TickData)(unsafe.Pointer(&ticks[0])), C.int(len(ticks)),
+            &a.bars[0], C.int(len(a.bars)), &consumed)
+        if count < 0 {
+            return dst, errors.New("native tick aggregation failed")
+        }
+        dst = a.appendBars(dst, int(count))
+        ticks = ticks[int(consumed):]
+    }
+    return dst, nil
+}
+
+// Flush appends every bar still open to dst and starts afresh.
+func (a *BarAggregator) Flush(dst []Bar) ([]Bar, error) {
+    if cap(a.bars) < len(a.timeframes) {
+        a.bars = make([]C.AggregatedBar, len(a.timeframes))
+    }
+    a.bars = a.bars[:cap(a.bars)]
+    count := C.aggregator_flush(a.handle, &a.bars[0], C.int(len(a.bars)))
+    if count < 0 {
+        return dst, errors.New("native bar flush failed")
+    }
+    return a.appendBars(dst, int(count)), nil
+}
+
+func (a *BarAggregator) appendBars(dst []Bar, count int) []Bar {
+    for _, bar := range a.bars[:count] {
+        dst = append(dst, Bar{
+            Timeframe: a.timeframes[bar.timeframe],
+            Candle:    *(*Candle)(unsafe.Pointer(&bar.candle)),
+        })
+    }
+    return dst
+}
+
+func (a *BarAggregator) Close() {
+    C.destroy_bar_aggregator(a.handle)
+    a.handle = nil
+}
+
+// Resample rolls finer candles, e.g. minute bars, up into timeframe-second
+// bars in one native pass.
+func Resample(candles []Candle, timeframe int64) ([]Candle, error) {
+    if len(candles) == 0 {
+        return nil, nil
+    }
+    out := make([]Candle, len(candles))
+    count := C.resample_candles(
+        (*C.CandleData)(unsafe.Pointer(&candles[0])),
+        C.int(len(candles)),
+        C.longlong(timeframe),
+        (*C.CandleData)(unsafe.Pointer(&out[0])),
+        C.int(len(out)),
+    )
+    if count < 0 {
+        return nil, errors.New("native resampling failed")
+    }
+    return out[:int(count)], nil
+}
+
+// SweepOptions configures a native parameter sweep. Threads <= 0 uses
+// every core. SeriesID names the candle buffer in the library's indicator
+// cache: reuse the same non-zero id for the same candles to share indicator
+// series across sweeps, or leave it 0 to cache them for this call only.
+type SweepOptions struct {
+    InitialBalance float64
+    Commission     float64
+    Threads        int
+    SeriesID       uint64
+}
+
+type SweepResult struct {
+    Candidate    int
+    Params       []float64
+    Score        float64
+    FinalBalance float64
+    MaxDrawdown  float64
+    SharpeRatio  float64
+    WinRate      float64
+    Trades       int
+}
+
+// Sweep backtests a copy of this strategy for every candidate parameter set
+// over candles, in parallel inside the library, and returns the results
+// ranked best first. Every candidate must hold exactly the values the
+// strategy's constructor takes, in that order; any other width fails the
+// whole sweep.
+func (s *Strategy) Sweep(candles []Candle, candidates [][]float64, opts SweepOptions) ([]SweepResult, error) {
+    if len(candles) == 0 || len(candidates) == 0 {
+        return nil, nil
+    }
+
+    flat, paramCount, err := flattenCandidates(candidates)
+    if err != nil {
+        return nil, err
+    }
+
+    out := make([]C.SweepResult, len(candidates))
+
+    s.mu.Lock()
+    count := C.sweep_strategy(
+        s.handle,
+        (*C.CandleData)(unsafe.Pointer(&candles[0])),
+        C.int(len(candles)),
+        (*C.double)(unsafe.Pointer(&flat[0])),
+        C.int(len(candidates)),
+        C.int(paramCount),
+        C.double(opts.InitialBalance),
+        C.double(opts.Commission),
+        C.int(opts.Threads),
+        C.ulonglong(opts.SeriesID),
+        &out[0],
+        C.int(len(out)),
+    )
+    s.mu.Unlock()
+
+    if count < 0 {
+        return nil, errors.New("native parameter sweep failed")
+    }
+
+    results := make([]SweepResult, int(count))
+    for i := range results {
+        r := &out[i]
+        results[i] = SweepResult{
+            Candidate:    int(r.candidate),
+            Params:       candidates[int(r.candidate)],
+            Score:        float64(r.score),
+            FinalBalance: float64(r.finalBalance),
+            MaxDrawdown:  float64(r.maxDrawdown),
+            SharpeRatio:  float64(r.sharpeRatio),
+            WinRate:      float64(r.winRate),
+            Trades:       int(r.trades),
+        }
+    }
+    return results, nil
+}
+
+// flattenCandidates lays parameter sets out row-major for the bridge.
+func flattenCandidates(candidates [][]float64) ([]float64, int, error) {
+    paramCount := len(candidates[0])
+    flat := make([]float64, 0, len(candidates)*paramCount)
+    for _, params := range candidates {
+        if len(params) != paramCount {
+            return nil, 0, errors.New("candidates must all have the same length")
+        }
+        flat = append(flat, params...)
+    }
+    return flat, paramCount, nil
+}
+
+// WalkForwardOptions configures a native walk-forward run. Window spans
+// in-sample plus out-of-sample data, TrainRatio is the in-sample share and
+// Step the advance between windows (0 = the out-of-sample length).
+// Threads and SeriesID behave as in SweepOptions.
+type WalkForwardOptions struct {
+    Window         time.Duration
+    TrainRatio     float64
+    Step           time.Duration
+    InitialBalance float64
+    Commission     float64
+    Threads        int
+    SeriesID       uint64
+}
+
+// WalkForwardWindow holds candle indices: in-sample bars are
+// [Begin, Split), out-of-sample bars [Split, End).
+type WalkForwardWindow struct {
+    Begin            int
+    Split            int
+    End              int
+    Params           []float64
+    InSampleScore    float64
+    OutOfSampleScore float64
+    FinalBalance     float64
+    MaxDrawdown      float64
+    SharpeRatio      float64
+    WinRate          float64
+    Trades           int
+}
+
+type WalkForwardResult struct {
+    Windows      []WalkForwardWindow
+    FinalBalance float64
+    TotalReturn  float64
+    MaxDrawdown  float64
+    SharpeRatio  float64
+    WinRate      float64
+    Efficiency   float64
+    Trades       int
+    RoundTrips   int
+}
+
+// WalkForward optimizes this strategy over rolling in-sample windows and
+// trades each window's best candidate on the out-of-sample bars after it,
+// all inside the library. The summary compounds the out-of-sample windows.
+func (s *Strategy) WalkForward(candles []Candle, candidates [][]float64, opts WalkForwardOptions) (WalkForwardResult, error) {
+    if len(candles) == 0 || len(candidates) == 0 {
+        return WalkForwardResult{}, nil
+    }
+
+    flat, paramCount, err := flattenCandidates(candidates)
+    if err != nil {
+        return WalkForwardResult{}, err
+    }
+
+    out := make([]C.WalkForwardWindow, walkForwardWindows(candles, opts))
+    var summary C.WalkForwardSummary
+
+    s.mu.Lock()
+    count := C.walk_forward(
+        s.handle,
+        (*C.CandleData)(unsafe.Pointer(&candles[0])),
+        C.int(len(candles)),
+        (*C.double)(unsafe.Pointer(&flat[0])),
+        C.int(len(candidates)),
+        C.int(paramCount),
+        C.longlong(opts.Window/time.Second),
+        C.double(opts.TrainRatio),
+        C.longlong(opts.Step/time.Second),
+        C.double(opts.InitialBalance),
+        C.double(opts.Commission),
+        C.int(opts.Threads),
+        C.ulonglong(opts.SeriesID),
+        &out[0],
+        C.int(len(out)),
+        &summary,
+    )
+    s.mu.Unlock()
+
+    if count < 0 {
+        return WalkForwardResult{}, errors.New("native walk-forward failed")
+    }
+    if int(summary.windows) > int(count) {
+        return WalkForwardResult{}, fmt.Errorf("walk-forward planned %d windows, room for %d", summary.windows, count)
+    }
+
+    windows := make([]WalkForwardWindow, int(count))
+    for i := range windows {
+        w := &out[i]
+        windows[i] = WalkForwardWindow{
+            Begin:            int(w.begin),
+            Split:            int(w.split),
+            End:              int(w.end),
+            Params:           candidates[int(w.candidate)],
+            InSampleScore:    float64(w.inSampleScore),
+            OutOfSampleScore: float64(w.outOfSampleScore),
+            FinalBalance:     float64(w.finalBalance),
+            MaxDrawdown:      float64(w.maxDrawdown),
+            SharpeRatio:      float64(w.sharpeRatio),
+            WinRate:          float64(w.winRate),
+            Trades:           int(w.trades),
+        }
+    }
+    return WalkForwardResult{
+        Windows:      windows,
+        FinalBalance: float64(summary.finalBalance),
+        TotalReturn:  float64(summary.totalReturn),
+        MaxDrawdown:  float64(summary.maxDrawdown),
+        SharpeRatio:  float64(summary.sharpeRatio),
+        WinRate:      float64(summary.winRate),
+        Efficiency:   float64(summary.efficiency),
+        Trades:       int(summary.trades),
+        RoundTrips:   int(summary.roundTrips),
+    }, nil
+}
+
+// walkForwardWindows bounds the number of windows WalkForward lays over
+// candles, the way the native planner steps them through the time span, so
+// the result buffer is sized by the windows rather than by the bars.
+func walkForwardWindows(candles []Candle, opts WalkForwardOptions) int {
+    window := int64(opts.Window / time.Second)
+    span := candles[len(candles)-1].Timestamp - candles[0].Timestamp
+    if window <= 0 || span+1 < window {
+        return 1
+    }
+    step := int64(opts.Step / time.Second)
+    if step <= 0 {
+        step = window - int64(float64(window)*opts.TrainRatio)
+    }
+    step = max(step, 1)
+    return int(min((span+1-window)/step+2, int64(len(candles))))
+}
+
+type ParameterRange struct {
+    Min     float64
+    Max     float64
+    Integer bool // only whole values are tried
+}
+
+// BayesianOptions configures a native Bayesian optimization. Zero counts
+// take the defaults: 8 initial points, 40 iterations and 2048 candidates
+// scored per iteration. Exploration is the expected-improvement margin in
+// units of the initial score spread. Threads and SeriesID behave as in
+// SweepOptions; the result depends on Seed but not on Threads.
+type BayesianOptions struct {
+    InitialPoints  int
+    Iterations     int
+    Candidates     int
+    Exploration    float64
+    Seed           uint64
+    InitialBalance float64
+    Commission     float64
+    Threads        int
+    SeriesID       uint64
+}
+
+type BayesianEvaluation struct {
+    Params []float64
+    Score  float64
+}
+
+type BayesianResult struct {
+    Evaluations []BayesianEvaluation // in evaluation order
+    Best        SweepResult          // Candidate indexes Evaluations
+}
+
+// OptimizeBayesian searches this strategy's parameters within ranges, one
+// per constructor parameter, choosing each backtest from a Gaussian-process model of the Sharpe ratio
+// of the ones before it. The whole loop runs inside the library.
+func (s *Strategy) OptimizeBayesian(candles []Candle, ranges []ParameterRange, opts BayesianOptions) (BayesianResult, error) {
+    if len(candles) == 0 || len(ranges) == 0 {
+        return BayesianResult{}, errors.New("bayesian optimization needs candles and parameter ranges")
+    }
+    if opts.InitialPoints <= 0 {
+        opts.InitialPoints = 8
+    }
+    if opts.Iterations <= 0 {
+        opts.Iterations = 40
+    }
+    if opts.Candidates <= 0 {
+        opts.Candidates = 2048
+    }
+
+    bounds := make([]C.ParameterBounds, len(ranges))
+    for i, r := range ranges {
+        bounds[i] = C.ParameterBounds{min: C.double(r.Min), max: C.double(r.Max)}
+        if r.Integer {
+            bounds[i].integer = 1
+        }
+    }
+    total := opts.InitialPoints + opts.Iterations
+    params := make([]float64, total*len(ranges))
+    scores := make([]float64, total)
+    var best C.SweepResult
+
+    s.mu.Lock()
+    count := C.bayesian_optimize(
+        s.handle,
+        (*C.CandleData)(unsafe.Pointer(&candles[0])),
+        C.int(len(candles)),
+        &bounds[0],
+        C.int(len(ranges)),
+        C.int(opts.InitialPoints),
+        C.int(opts.Iterations),
+        C.int(opts.Candidates),
+        C.double(opts.Exploration),
+        C.ulonglong(opts.Seed),
+        C.double(opts.InitialBalance),
+        C.double(opts.Commission),
+        C.int(opts.Threads),
+        C.ulonglong(opts.SeriesID),
+        (*C.double)(unsafe.Pointer(&params[0])),
+        (*C.double)(unsafe.Pointer(&scores[0])),
+        C.int(total),
+        &best,
+    )
+    s.mu.Unlock()
+
+    if count < 0 {
+        return BayesianResult{}, errors.New("native bayesian optimization failed")
+    }
+
+    n := len(ranges)
+    evaluations := make([]BayesianEvaluation, int(count))
+    for i := range evaluations {
+        evaluations[i] = BayesianEvaluation{
+            Params: params[i*n : (i+1)*n : (i+1)*n],
+            Score:  scores[i],
+        }
+    }
+    return BayesianResult{
+        Evaluations: evaluations,
+        Best: SweepResult{
+            Candidate:    int(best.candidate),
+            Params:       evaluations[int(best.candidate)].Params,
+            Score:        float64(best.score),
+            FinalBalance: float64(best.finalBalance),
+            MaxDrawdown:  float64(best.maxDrawdown),
+            SharpeRatio:  float64(best.sharpeRatio),
+            WinRate:      float64(best.winRate),
+            Trades:       int(best.trades),
+        },
+    }, nil
+}
+
+// GaussianProcess is a native Gaussian-process regression model whose
+// observations update a Cholesky factorization in place, so Add costs
+// O(n^2) rather than a refit's O(n^3). Predictions may run concurrently
+// with each other; Add and Close exclude them.
+type GaussianProcess struct {
+    handle unsafe.Pointer
+    dims   int
+    mu     sync.RWMutex
+}
+
+func NewGaussianProcess(dimensions int, lengthScale, signalVariance, noiseVariance float64) (*GaussianProcess, error) {
+    handle := C.create_gaussian_process(C.int(dimensions), C.double(lengthScale),
+        C.double(signalVariance), C.double(noiseVariance))
+    if handle == nil {
+        return nil, errors.New("invalid gaussian process configuration")
+    }
+    return &GaussianProcess{handle: handle, dims: dimensions}, nil
+}
+
+func (g *GaussianProcess) Add(point []float64, value float64) error {
+    if len(point) != g.dims {
+        return errors.New("point has the wrong number of dimensions")
+    }
+    g.mu.Lock()
+    defer g.mu.Unlock()
+    if C.gaussian_process_add(g.handle, (*C.double)(unsafe.Pointer(&point[0])), C.double(value)) != 0 {
+        return errors.New("gaussian process rejected the observation")
+    }
+    return nil
+}
+
+// Predict returns the posterior mean and standard deviation at each point,
+// computed across threads workers (<= 0 uses every core).
+func (g *GaussianProcess) Predict(points [][]float64, threads int) (means, sds []float64, err error) {
+    if len(points) == 0 {
+        return nil, nil, nil
+    }
+    flat, dims, err := flattenCandidates(points)
+    if err != nil {
+        return nil, nil, err
+    }
+    if dims != g.dims {
+        return nil, nil, errors.New("points have the wrong number of dimensions")
+    }
+    means = make([]float64, len(points))
+    sds = make([]float64, len(points))
+
+    g.mu.RLock()
+    status := C.gaussian_process_predict(
+        g.handle,
+        (*C.double)(unsafe.Pointer(&flat[0])),
+        C.int(len(points)),
+        (*C.double)(unsafe.Pointer(&means[0])),
+        (*C.double)(unsafe.Pointer(&sds[0])),
+        C.int(threads),
+    )
+    g.mu.RUnlock()
+
+    if status != 0 {
+        return nil, nil, errors.New("gaussian process prediction failed")
+    }
+    return means, sds, nil
+}
+
+func (g *GaussianProcess) Close() {
+    g.mu.Lock()
+    defer g.mu.Unlock()
+    if g.handle != nil {
+        C.destroy_gaussian_process(g.handle)
+        g.handle = nil
+    }
+}
+
+type Resampling int
+
+const (
+    // Shuffle replays every trade once per path in a random order.
+    Shuffle Resampling = iota
+    // Bootstrap draws PathLength trades per path with replacement.
+    Bootstrap
+)
+
+// MonteCarloOptions configures a native Monte Carlo run. Threads <= 0 uses
+// every core and PathLength <= 0 uses the number of trades. Runs with the
+// same Seed return the same result.
+type MonteCarloOptions struct {
+    Paths          int
+    Mode           Resampling
+    PathLength     int
+    InitialBalance float64
+    Confidence     float64
+    Seed           uint64
+    Threads        int
+}
+
+type MonteCarloInterval struct {
+    Lower  float64
+    Median float64
+    Upper  float64
+    Mean   float64
+}
+
+type MonteCarloResult struct {
+    FinalBalance        MonteCarloInterval
+    MaxDrawdown         MonteCarloInterval
+    SharpeRatio         MonteCarloInterval
+    WinRate             MonteCarloInterval
+    VaR95               float64
+    VaR99               float64
+    CVaR95              float64
+    CVaR99              float64
+    LossProbability     float64
+    RuinProbability     float64
+    AverageWinStreak    float64
+    AverageLossStreak   float64
+    AverageRecoveryTime float64
+    MaxRecoveryTime     int
+    RecoveryProbability float64
+    // MaxWinStreaks[k] is the number of paths whose longest winning run
+    // was k trades; likewise for MaxLossStreaks.
+    MaxWinStreaks  []uint64
+    MaxLossStreaks []uint64
+}
+
+func toInterval(interval C.MonteCarloInterval) MonteCarloInterval {
+    return MonteCarloInterval{
+        Lower:  float64(interval.lower),
+        Median: float64(interval.median),
+        Upper:  float64(interval.upper),
+        Mean:   float64(interval.mean),
+    }
+}
+
+// MonteCarlo resamples per-trade PnLs into synthetic equity paths inside the
+// library and summarizes their final balance, drawdown, VaR/CVaR, streak and
+// recovery distributions.
+func MonteCarlo(pnl []float64, opts MonteCarloOptions) (MonteCarloResult, error) {
+    if len(pnl) == 0 || opts.Paths <= 0 {
+        return MonteCarloResult{}, errors.New("monte carlo needs trades and at least one path")
+    }
+
+    length := len(pnl)
+    if opts.Mode == Bootstrap && opts.PathLength > 0 {
+        length = opts.PathLength
+    }
+    wins := make([]uint64, length+1)
+    losses := make([]uint64, length+1)
+
+    var summary C.MonteCarloSummary
+    status := C.monte_carlo(
+        (*C.double)(unsafe.Pointer(&pnl[0])),
+        C.int(len(pnl)),
+        C.int(opts.Paths),
+        C.int(opts.Mode),
+        C.int(opts.PathLength),
+        C.double(opts.InitialBalance),
+        C.double(opts.Confidence),
+        C.ulonglong(opts.Seed),
+        C.int(opts.Threads),
+        &summary,
+        (*C.ulonglong)(unsafe.Pointer(&wins[0])),
+        (*C.ulonglong)(unsafe.Pointer(&losses[0])),
+        C.int(len(wins)),
+    )
+    if status != 0 {
+        return MonteCarloResult{}, errors.New("native monte carlo failed")
+    }
+
+    return MonteCarloResult{
+        FinalBalance:        toInterval(summary.finalBalance),
+        MaxDrawdown:         toInterval(summary.maxDrawdown),
+        SharpeRatio:         toInterval(summary.sharpeRatio),
+        WinRate:             toInterval(summary.winRate),
+        VaR95:               float64(summary.var95),
+        VaR99:               float64(summary.var99),
+        CVaR95:              float64(summary.cvar95),
+        CVaR99:              float64(summary.cvar99),
+        LossProbability:     float64(summary.lossProbability),
+        RuinProbability:     float64(summary.ruinProbability),
+        AverageWinStreak:    float64(summary.averageWinStreak),
+        AverageLossStreak:   float64(summary.averageLossStreak),
+        AverageRecoveryTime: float64(summary.averageRecoveryTime),
+        MaxRecoveryTime:     int(summary.maxRecoveryTime),
+        RecoveryProbability: float64(summary.recoveryProbability),
+        MaxWinStreaks:       wins,
+        MaxLossStreaks:      losses,
+    }, nil
+}
+
+type IndicatorCacheStats struct {
+    Hits      uint64
+    Misses    uint64
+    Evictions uint64
+    Bytes     uint64
+    Entries   uint64
+}
+
+// GetIndicatorCacheStats reports the hit/miss counters of the library's
+// shared indicator cache.
+func GetIndicatorCacheStats() IndicatorCacheStats {
+    var stats C.IndicatorCacheStats
+    C.get_indicator_cache_stats(&stats)
+    return IndicatorCacheStats{
+        Hits:      uint64(stats.hits),
+        Misses:    uint64(stats.misses),
+        Evictions: uint64(stats.evictions),
+        Bytes:     uint64(stats.bytes),
+        Entries:   uint64(stats.entries),
+    }
+}
+
+// ClearIndicatorCache drops every cached indicator series.
+func ClearIndicatorCache() {
+    C.clear_indicator_cache()
+}
+
+type MetricKind int
+
+const (
+    MetricCounter MetricKind = iota
+    MetricTimer
+)
+
+// MetricSample is one hot-path metric of the library, merged across its
+// threads. Timers report nanoseconds: Count events summing to Sum, with
+// their range and approximate quantiles. Counters report their total in
+// Count and Sum.
+type MetricSample struct {
+    Name  string
+    Label string
+    Kind  MetricKind
+    Count uint64
+    Sum   float64
+    Min   float64
+    Max   float64
+    P50   float64
+    P90   float64
+    P99   float64
+    P999  float64
+}
+
+// MetricsEnabled reports whether the bridge was compiled with hot-path
+// instrumentation (CGO_CXXFLAGS=-DTRADING_METRICS=1 for Go builds).
+// Without it Metrics returns nothing.
+func MetricsEnabled() bool {
+    return C.metrics_enabled() != 0
+}
+
+// Metrics snapshots the library's strategy, bridge and indicator cache
+// metrics.
+func Metrics() ([]MetricSample, error) {
+    var buf []C.MetricSample
+    defer func() { freeC(buf) }()
+    for capacity := 64; ; {
+        buf = growC(buf, capacity)
+        total := int(C.metrics_snapshot(unsafe.SliceData(buf), C.int(capacity)))
+        if total < 0 {
+            return nil, errors.New("metrics snapshot failed")
+        }
+        if total > capacity {
+            capacity = total
+            continue
+        }
+        samples := make([]MetricSample, total)
+        for i, m := range buf[:total] {
+            samples[i] = MetricSample{
+                Name:  C.GoString(m.name),
+                Label: C.GoString(m.label),
+                Kind:  MetricKind(m.kind),
+                Count: uint64(m.count),
+                Sum:   float64(m.sum),
+                Min:   float64(m.min),
+                Max:   float64(m.max),
+                P50:   float64(m.p50),
+                P90:   float64(m.p90),
+                P99:   float64(m.p99),
+                P999:  float64(m.p999),
+            }
+        }
+        return samples, nil
+    }
+}
+
+var labelEscaper = strings.NewReplacer(`\`, `\\`, `"`, `\"`, "\n", `\n`)
+
+// WriteMetrics writes the library metrics and the shared indicator cache
+// counters to w in the Prometheus text format. Metric names get a
+// "trading_" prefix, counters a "_total" suffix, and each sample's label
+// becomes a "source" label; timers are written as summaries.
+func WriteMetrics(w io.Writer) error {
+    samples, err := Metrics()
+    if err != nil {
+        return err
+    }
+    slices.SortStableFunc(samples, func(a, b MetricSample) int { return cmp.Compare(a.Name, b.Name) })
+
+    var out strings.Builder
+    for i, m := range samples {
+        family := "trading_" + m.Name
+        if m.Kind == MetricCounter {
+            family += "_total"
+        }
+        if i == 0 || samples[i-1].Name != m.Name {
+            kind := "counter"
+            if m.Kind == MetricTimer {
+                kind = "summary"
+            }
+            fmt.Fprintf(&out, "# TYPE %s %s\n", family, kind)
+        }
+        source := ""
+        if m.Label != "" {
+            source = `source="` + labelEscaper.Replace(m.Label) + `"`
+        }
+        if m.Kind == MetricCounter {
+            fmt.Fprintf(&out, "%s%s %d\n", family, braces(source), m.Count)
+            continue
+        }
+        for _, q := range []struct {
+            quantile string
+            value    float64
+        }{{"0.5", m.P50}, {"0.9", m.P90}, {"0.99", m.P99}, {"0.999", m.P999}} {
+            fmt.Fprintf(&out, "%s%s %g\n", family, braces(joinLabels(source, `quantile="`+q.quantile+`"`)), q.value)
+        }
+        fmt.Fprintf(&out, "%s_sum%s %g\n", family, braces(source), m.Sum)
+        fmt.Fprintf(&out, "%s_count%s %d\n", family, braces(source), m.Count)
+    }
+
+    cache := GetIndicatorCacheStats()
+    for _, c := range []struct {
+        name  string
+        kind  string
+        value uint64
+    }{
+        {"trading_shared_indicator_cache_hits_total", "counter", cache.Hits},
+        {"trading_shared_indicator_cache_misses_total", "counter", cache.Misses},
+        {"trading_shared_indicator_cache_evictions_total", "counter", cache.Evictions},
+        {"trading_shared_indicator_cache_bytes", "gauge", cache.Bytes},
+        {"trading_shared_indicator_cache_entries", "gauge", cache.Entries},
+    } {
+        fmt.Fprintf(&out, "# TYPE %s %s\n%s %d\n", c.name, c.kind, c.name, c.value)
+    }
+
+    _, err = io.WriteString(w, out.String())
+    return err
+}
+
+func joinLabels(a, b string) string {
+    if a == "" {
+        return b
+    }
+    return a + "," + b
+}
+
+func braces(labels string) string {
+    if labels == "" {
+        return ""
+    }
+    return "{" + labels + "}"
+}
+
+// MetricsHandler serves WriteMetrics, for mounting on a /metrics endpoint.
+func MetricsHandler() http.Handler {
+    return http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+        w.Header().Set("Content-Type", "text/plain; version=0.0.4; charset=utf-8")
+        if err := WriteMetrics(w); err != nil {
+            http.Error(w, err.Error(), http.StatusInternalServerError)
+        }
+    })
 }
 
 type TradeSignal struct {
     Price     float64
     Amount    float64
     Type      string
+    Reason    string
     Timestamp time.Time
 }
\ No newline at end of file